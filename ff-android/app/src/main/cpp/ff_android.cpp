@@ -269,8 +269,8 @@ void handle_cmd(android_app* app, int32_t cmd) {
                     float const bottomInset = safeArea.getBottomLeft().y;
                     float const paddingTop = topInset / windowBounds.y;
                     float const paddingBottom = bottomInset / windowBounds.y;
-                    ff::CVars::get<float>("view_safe_area_padding_top") = paddingTop;
-                    ff::CVars::get<float>("view_safe_area_padding_bottom") = paddingBottom;
+                    ff::CVars::set<float>("view_safe_area_padding_top", paddingTop);
+                    ff::CVars::set<float>("view_safe_area_padding_bottom", paddingBottom);
                 }
             }
             break;
@@ -480,8 +480,8 @@ extern "C" void android_main(struct android_app* app) {
     FF_CONSOLE_LOG("Querying audio manager properties...");
     queryAudioManagerProperties(appData, &oboeSampleRate, &oboeFramesPerBurst);
 
-    ff::CVars::get<int>("audio_oboe_app_sample_rate") = oboeSampleRate;
-    ff::CVars::get<int>("audio_oboe_app_frames_per_burst") = oboeSampleRate;
+    ff::CVars::set<int>("audio_oboe_app_sample_rate", oboeSampleRate);
+    ff::CVars::set<int>("audio_oboe_app_frames_per_burst", oboeFramesPerBurst);
 
     // Full initialization has to happen after the window has been created.
     appData->initialized = false;
@@ -0,0 +1,129 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <ff/actors/ActorManager.hpp>
+#include <ff/actors/Family.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace ff;
+
+struct BenchPositionComponent : Component<BenchPositionComponent> {
+    BenchPositionComponent(const float& x = 0.0f, const float& y = 0.0f) : x(x), y(y) {}
+    float x;
+    float y;
+};
+struct BenchVelocityComponent : Component<BenchVelocityComponent> {
+    BenchVelocityComponent(const float& x = 1.0f, const float& y = 1.0f) : x(x), y(y) {}
+    float x;
+    float y;
+};
+
+static char const* getStorageName(ActorStorage const& storage) {
+    return storage == ActorStorage::ARCHETYPES ? "archetypes" : "component maps";
+}
+
+static void benchCreateDestroy(ActorStorage const& storage) {
+    const int actorCount = 10000;
+    ActorManager actorManager(storage);
+    std::vector<Actor_t> actors(actorCount);
+
+    BENCHMARK(std::string("Create and destroy 10k actors (") + getStorageName(storage) + ")") {
+        for(int i = 0; i < actorCount; i++) {
+            actors[i] = actorManager.createActor();
+        }
+        actorManager.destroyActors(actors);
+        return actors.back();
+    };
+    BENCHMARK(std::string("Create and destroy 10k actors with components (") + getStorageName(storage) + ")") {
+        for(int i = 0; i < actorCount; i++) {
+            actors[i] = actorManager.createActor();
+            actorManager.addComponent<BenchPositionComponent>(actors[i]);
+            actorManager.addComponent<BenchVelocityComponent>(actors[i]);
+        }
+        actorManager.destroyActors(actors);
+        return actors.back();
+    };
+}
+
+static void benchAddRemoveComponent(ActorStorage const& storage) {
+    const int actorCount = 10000;
+    ActorManager actorManager(storage);
+    std::vector<Actor_t> actors(actorCount);
+    for(int i = 0; i < actorCount; i++) {
+        actors[i] = actorManager.createActor();
+        actorManager.addComponent<BenchPositionComponent>(actors[i]);
+    }
+    // A family keeps the family update path in the measurement
+    actorManager.getActorsFor(Family::all<BenchPositionComponent, BenchVelocityComponent>().get());
+
+    BENCHMARK(std::string("Add and remove a component on 10k actors (") + getStorageName(storage) + ")") {
+        for(Actor_t const& actor : actors) {
+            actorManager.addComponent<BenchVelocityComponent>(actor);
+        }
+        for(Actor_t const& actor : actors) {
+            actorManager.removeComponent<BenchVelocityComponent>(actor);
+        }
+        return actors.back();
+    };
+}
+
+static void benchIteration(ActorStorage const& storage, const int& actorCount, const std::string& countName) {
+    ActorManager actorManager(storage);
+    for(int i = 0; i < actorCount; i++) {
+        Actor_t actor = actorManager.createActor();
+        actorManager.addComponent<BenchPositionComponent>(actor);
+        // Every other actor is left out, so families and views have to filter
+        if(i % 2 == 0) {
+            actorManager.addComponent<BenchVelocityComponent>(actor);
+        }
+    }
+    Family const family = Family::all<BenchPositionComponent, BenchVelocityComponent>().get();
+    actorManager.getActorsFor(family);
+
+    std::string const suffix = " over " + countName + " actors (" + getStorageName(storage) + ")";
+    BENCHMARK("Family iteration" + suffix) {
+        float sum = 0.0f;
+        actorManager.getActorsFor(family).each([&actorManager, &sum](Actor_t actor) {
+            BenchPositionComponent& position = actorManager.getComponent<BenchPositionComponent>(actor);
+            BenchVelocityComponent const& velocity = actorManager.getComponent<BenchVelocityComponent>(actor);
+            position.x += velocity.x;
+            sum += position.x;
+        });
+        return sum;
+    };
+    BENCHMARK("View iteration" + suffix) {
+        float sum = 0.0f;
+        actorManager.view<BenchPositionComponent, BenchVelocityComponent>().each(
+            [&sum](Actor_t, BenchPositionComponent& position, BenchVelocityComponent const& velocity) {
+                position.x += velocity.x;
+                sum += position.x;
+            });
+        return sum;
+    };
+}
+
+TEST_CASE("Actor creation and destruction.", "[actors]") {
+    benchCreateDestroy(ActorStorage::COMPONENT_MAPS);
+    benchCreateDestroy(ActorStorage::ARCHETYPES);
+}
+
+TEST_CASE("Adding and removing components.", "[actors]") {
+    benchAddRemoveComponent(ActorStorage::COMPONENT_MAPS);
+    benchAddRemoveComponent(ActorStorage::ARCHETYPES);
+}
+
+TEST_CASE("Iterating actors.", "[actors]") {
+    for(ActorStorage storage : { ActorStorage::COMPONENT_MAPS, ActorStorage::ARCHETYPES }) {
+        benchIteration(storage, 1000, "1k");
+        benchIteration(storage, 100000, "100k");
+        benchIteration(storage, 1000000, "1M");
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <ff/actors/ActorManager.hpp>
+#include <ff/processes/ProcessManager.hpp>
+#include <ff/systems/Collision2DDetectionSystem.hpp>
+#include <ff/components/TransformComponent.hpp>
+#include <ff/components/Collision2DComponent.hpp>
+#include <ff/components/StaticColliderComponent.hpp>
+#include <ff/components/DynamicColliderComponent.hpp>
+#include <ff/Locator.hpp>
+#include <ff/messages/MessageBus.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace ff;
+
+static void benchBullets(const int& bulletCount) {
+    const int tilesPerSide = 64;
+    ActorManager actorManager;
+
+    for(int i = 0; i < tilesPerSide * tilesPerSide; i++) {
+        Actor_t tile = actorManager.createActor();
+        actorManager.addComponent<TransformComponent>(tile, glm::vec3(i % tilesPerSide, i / tilesPerSide, 0));
+        actorManager.addComponent<Collision2DComponent>(tile, std::initializer_list<Collision2DShape*>{
+            new PolygonCollision2DShape({ glm::vec2(-0.4f, -0.4f), glm::vec2(0.4f, -0.4f), glm::vec2(0.4f, 0.4f), glm::vec2(-0.4f, 0.4f) })
+        });
+        actorManager.addComponent<StaticColliderComponent>(tile);
+    }
+    std::vector<Actor_t> bullets(bulletCount);
+    for(int i = 0; i < bulletCount; i++) {
+        bullets[i] = actorManager.createActor();
+        actorManager.addComponent<TransformComponent>(bullets[i], glm::vec3((i * 7) % tilesPerSide, (i * 13) % tilesPerSide, 0));
+        actorManager.addComponent<Collision2DComponent>(bullets[i], std::initializer_list<Collision2DShape*>{ new CircleCollision2DShape(0.1f) });
+        actorManager.addComponent<DynamicColliderComponent>(bullets[i]);
+    }
+
+    ProcessManager processManager;
+    processManager.attachProcess<Collision2DDetectionSystem>(&actorManager, ProcessPriority::DEFAULT, 1.0f);
+    processManager.tick(0.0f);
+
+    // Bullets move by a fraction of a tile per update, so pairs start and end
+    float offset = 0.0f;
+    BENCHMARK("Detect collisions for " + std::to_string(bulletCount) + " bullets over 4k tiles") {
+        offset = offset > 1.0f ? 0.0f : offset + 0.25f;
+        for(int i = 0; i < bulletCount; i++) {
+            actorManager.getComponent<TransformComponent>(bullets[i]).setPosition((i * 7) % tilesPerSide + offset, (i * 13) % tilesPerSide);
+        }
+        processManager.tick(1.0f / 60.0f);
+        Locator::getMessageBus().flush();
+        return offset;
+    };
+
+    processManager.killAll(true);
+}
+
+TEST_CASE("Detecting 2D collisions.", "[collision]") {
+    benchBullets(1000);
+    benchBullets(10000);
+}
@@ -0,0 +1,58 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <ff/io/ByteSerializer.hpp>
+
+#include <cstdint>
+#include <string>
+
+struct BenchRecord {
+    uint32_t id;
+    int64_t time;
+    float x;
+    float y;
+    double weight;
+    bool active;
+    std::string name;
+
+    void serialize(ff::Serializer& serializer) {
+        serializer.serialize("id", id);
+        serializer.serialize("time", time);
+        serializer.serialize("x", x);
+        serializer.serialize("y", y);
+        serializer.serialize("weight", weight);
+        serializer.serialize("active", active);
+        serializer.serialize("name", name);
+    }
+};
+
+TEST_CASE("Serializing to bytes.", "[io]") {
+    const int recordCount = 1000;
+    // Large enough to hold every record on a single page
+    ff::ByteSerializer serializer(1024 * 1024);
+    BenchRecord record = { 7, -1234567, 1.5f, -2.5f, 0.25, true, "faithful fountain" };
+
+    BENCHMARK("Write and read back 1k records") {
+        serializer.setDirection(ff::SerializerDirection::WRITE);
+        serializer.resetHead();
+        for(int i = 0; i < recordCount; i++) {
+            record.serialize(serializer);
+        }
+
+        serializer.setDirection(ff::SerializerDirection::READ);
+        serializer.resetHead();
+        BenchRecord readRecord = {};
+        uint64_t checksum = 0;
+        for(int i = 0; i < recordCount; i++) {
+            readRecord.serialize(serializer);
+            checksum += readRecord.id;
+        }
+        return checksum;
+    };
+}
@@ -0,0 +1,80 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <ff/messages/MessageBus.hpp>
+#include <ff/messages/EventListener.hpp>
+#include <ff/messages/Event.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class BenchEvent: public ff::Event {
+public:
+    BenchEvent(const int& value)
+        :value(value) {
+    }
+    ~BenchEvent() {
+    }
+
+    static char const* getEventName() {
+        return "evt_bench";
+    }
+
+    inline std::string getName() const override {
+        return getEventName();
+    }
+
+    inline std::string stringify() const override {
+        return "";
+    }
+
+    int value;
+};
+
+class BenchEventListener: public ff::EventListener<BenchEvent> {
+public:
+    int sum = 0;
+
+    inline bool processEvent(BenchEvent const& evt) override {
+        sum += evt.value;
+        return false;
+    }
+};
+
+static void benchDispatch(const int& listenerCount) {
+    ff::MessageBus bus;
+    std::vector<std::unique_ptr<BenchEventListener>> listeners;
+    for(int i = 0; i < listenerCount; i++) {
+        listeners.push_back(std::make_unique<BenchEventListener>());
+        bus.addListener<BenchEvent>(listeners.back().get());
+    }
+
+    BENCHMARK("Dispatch to " + std::to_string(listenerCount) + " listeners") {
+        bus.dispatch<BenchEvent>(1);
+        return listeners.empty() ? 0 : listeners.back()->sum;
+    };
+    BENCHMARK("Enqueue and flush 1k events to " + std::to_string(listenerCount) + " listeners") {
+        for(int i = 0; i < 1000; i++) {
+            bus.enqueue<BenchEvent>(1);
+        }
+        bus.flush();
+        return listeners.empty() ? 0 : listeners.back()->sum;
+    };
+
+    for(auto& listener : listeners) {
+        bus.removeListener<BenchEvent>(listener.get());
+    }
+}
+
+TEST_CASE("Dispatching events.", "[messages]") {
+    benchDispatch(0);
+    benchDispatch(10);
+    benchDispatch(100);
+}
@@ -0,0 +1,77 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <ff/processes/ProcessManager.hpp>
+#include <ff/processes/Process.hpp>
+#include <ff/processes/DelegateProcess.hpp>
+#include <ff/processes/WaitProcess.hpp>
+
+#include <memory>
+#include <string>
+
+class BenchProcess : public ff::Process {
+public:
+    float elapsed = 0.0f;
+
+protected:
+    inline void onUpdate(const float& dt) override {
+        elapsed += dt;
+    }
+};
+
+static void benchTick(const int& processCount) {
+    ff::ProcessManager processManager;
+    std::shared_ptr<BenchProcess> lastProcess;
+    for(int i = 0; i < processCount; i++) {
+        lastProcess = processManager.attachProcess<BenchProcess>();
+    }
+    // Processes are initialized on their first tick
+    processManager.tick(0.0f);
+
+    BENCHMARK("Tick " + std::to_string(processCount) + " processes") {
+        processManager.tick(1.0f / 60.0f);
+        return lastProcess->elapsed;
+    };
+
+    processManager.killAll(true);
+}
+
+TEST_CASE("Ticking processes.", "[processes]") {
+    benchTick(100);
+    benchTick(1000);
+    benchTick(10000);
+}
+
+static void benchSpawn(const int& processCount) {
+    ff::ProcessManager processManager;
+    for(int i = 0; i < 1000; i++) {
+        processManager.attachProcess<BenchProcess>();
+    }
+    processManager.tick(0.0f);
+
+    // Short chains, as UI and effects code spawns them
+    int triggerCount = 0;
+    BENCHMARK("Spawn and finish " + std::to_string(processCount) + " wait and delegate chains") {
+        for(int i = 0; i < processCount; i++) {
+            processManager.attachProcess<ff::WaitProcess>(0.0f)->setNext(ff::makeProcess<ff::DelegateProcess>([&triggerCount]() {
+                triggerCount++;
+            }));
+        }
+        processManager.tick(1.0f / 60.0f);
+        processManager.tick(1.0f / 60.0f);
+        return triggerCount;
+    };
+
+    processManager.killAll(true);
+}
+
+TEST_CASE("Spawning short-lived processes.", "[processes]") {
+    benchSpawn(100);
+    benchSpawn(1000);
+}
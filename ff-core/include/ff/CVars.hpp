@@ -107,6 +107,13 @@ namespace ff {
         const bool& getInitialized() const;
         void setInitialized(const bool& initialized);
 
+        /**
+         * Incremented every time the value is modified through the CVar
+         * (or `notifyModified` is called). Used by `CVarHandle` to detect changes.
+         */
+        const uint32_t& getVersion() const;
+        void notifyModified();
+
         virtual std::string toString() const = 0;
         virtual std::string defaultToString() const = 0;
 
@@ -128,6 +135,7 @@ namespace ff {
         std::string _description;
         const CVarFlags _flags;
         bool _initialized;
+        uint32_t _version;
 
         template<typename T, typename U>
         T castTypeToType() const;
@@ -229,6 +237,7 @@ namespace ff {
     template<typename T>
     void CVar<T>::setFromINI(const INIFile& iniFile) {
         _val = iniFile.getValue<T>(getName());
+        notifyModified();
     }
 
     template<typename T>
@@ -242,6 +251,7 @@ namespace ff {
     template<typename T>
     void CVar<T>::resetToDefault() {
         _val = _defaultVal;
+        notifyModified();
     }
 
     template<typename T>
@@ -264,7 +274,11 @@ namespace ff {
 
     template<typename T>
     void CVar<T>::drawImGuiEdit() {
+        T const prevVal = _val;
         _val.drawImGuiEdit();
+        if(!(_val == prevVal)) {
+            notifyModified();
+        }
     }
     template<>
     void CVar<bool>::drawImGuiEdit();
@@ -332,6 +346,9 @@ namespace ff {
     template<typename T>
     void CVar<T>::serialize(Serializer& serializer) {
         serializer.serialize(getName().c_str(), _val);
+        if(serializer.getDirection() == SerializerDirection::READ) {
+            notifyModified();
+        }
     }
     //endregion
 
@@ -343,8 +360,23 @@ namespace ff {
             return get<T>(name);
         }
 
+        /**
+         * Values modified through the returned reference won't be seen by
+         * `CVarHandle::pollChanged`; use `set` (or `ICVar::notifyModified`).
+         * Prefer `CVarHandle` on hot paths, this performs a lookup every call.
+         */
         template<typename T>
         static T& get(const std::string& name) {
+            return getTypedCVar<T>(name)->get();
+        }
+        template<typename T>
+        static void set(const std::string& name, const T& val) {
+            CVar<T>* cvar = getTypedCVar<T>(name);
+            cvar->get() = val;
+            cvar->notifyModified();
+        }
+        template<typename T>
+        static CVar<T>* getTypedCVar(const std::string& name) {
             auto cvarIt = getCVarMap().find(name);
             if(cvarIt == getCVarMap().end()) {
                 FF_CONSOLE_FATAL("Invalid CVar name: " + name);
@@ -354,7 +386,7 @@ namespace ff {
             // a big problem.
             FF_ASSERT(cvarIt->second->getCastFlagType() == cvarsTypeToCastFlag<T>(),
                 "Types do not match (requested %s, CVar is %s).");
-            return static_cast<CVar<T>*>(cvarIt->second.get())->get();
+            return static_cast<CVar<T>*>(cvarIt->second.get());
         }
         template<typename T>
         static T cast(const std::string& name) {
@@ -395,6 +427,83 @@ namespace ff {
     private:
         static std::unordered_map<std::string, std::unique_ptr<ICVar>>& getCVarMap();
     };
+
+    //region CVar Handle
+    /**
+     * Caches a pointer to a CVar so that reading it is a direct load rather than
+     * a map lookup. The CVar is resolved on first use, so handles can be
+     * constructed before the CVar is registered (e.g. as statics).
+     */
+    template<typename T>
+    class CVarHandle {
+    public:
+        explicit CVarHandle(const std::string& name);
+
+        T const& get() const;
+        T const& operator*() const;
+        void set(const T& val);
+
+        /**
+         * Returns true if the CVar was modified since the last call (or since
+         * the handle was resolved). Intended for `HOT_MODIFY` CVars, whose
+         * consumers need to react to changes at runtime.
+         */
+        bool pollChanged();
+
+        const std::string& getName() const;
+
+    private:
+        std::string _name;
+        mutable CVar<T>* _cvar;
+        mutable uint32_t _lastVersion;
+
+        CVar<T>* resolve() const;
+    };
+
+    template<typename T>
+    CVarHandle<T>::CVarHandle(const std::string& name)
+        :_name(name),_cvar(nullptr),_lastVersion(0) {
+    }
+
+    template<typename T>
+    T const& CVarHandle<T>::get() const {
+        return resolve()->get();
+    }
+    template<typename T>
+    T const& CVarHandle<T>::operator*() const {
+        return get();
+    }
+    template<typename T>
+    void CVarHandle<T>::set(const T& val) {
+        CVar<T>* cvar = resolve();
+        cvar->get() = val;
+        cvar->notifyModified();
+    }
+
+    template<typename T>
+    bool CVarHandle<T>::pollChanged() {
+        CVar<T>* cvar = resolve();
+        if(cvar->getVersion() == _lastVersion) {
+            return false;
+        }
+        _lastVersion = cvar->getVersion();
+        return true;
+    }
+
+    template<typename T>
+    const std::string& CVarHandle<T>::getName() const {
+        return _name;
+    }
+
+    template<typename T>
+    CVar<T>* CVarHandle<T>::resolve() const {
+        if(_cvar == nullptr) {
+            _cvar = CVars::getTypedCVar<T>(_name);
+            _lastVersion = _cvar->getVersion();
+        }
+        return _cvar;
+    }
+    //endregion
 }
 
 //region Macros
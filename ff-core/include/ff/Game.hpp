@@ -12,6 +12,7 @@
 #include <ff/messages/MessageBus.hpp>
 #include <ff/messages/CmdHandler.hpp>
 #include <ff/commands/ShutdownCmd.hpp>
+#include <ff/CVars.hpp>
 
 #if defined(WIN32)
     #define FF_ENTRY_DECL extern "C" __declspec(dllexport)
@@ -41,6 +42,7 @@ namespace ff {
 
     private:
         ProcessManager _processManager;
+        CVarHandle<float> _processBudgetCVar;
 
         void shutdown();
     };
@@ -9,6 +9,7 @@
 
 #include <ff/Game.hpp>
 #include <ff/CommandLineOptions.hpp>
+#include <ff/CVars.hpp>
 #include <ff/env/IEnvironment.hpp>
 #include <ff/messages/EventListener.hpp>
 #include <ff/events/GameShutdownEvent.hpp>
@@ -99,6 +100,12 @@ namespace ff {
         tick_t _prevLoopTicks;
         bool _loopTimeInit;
         bool _forceZeroDelta;
+
+        CVarHandle<bool> _vsyncCVar;
+        CVarHandle<bool> _deltaSmoothingCVar;
+        CVarHandle<float> _acculmulatorMaxBeforeResetCVar;
+        CVarHandle<float> _tickFrequencyCVar;
+        CVarHandle<bool> _frameSmoothingCVar;
     };
 }
 
@@ -16,6 +16,7 @@
 #include <ff/env/IEnvironment.hpp>
 #include <ff/messages/MessageBus.hpp>
 #include <ff/graphics/CameraManager.hpp>
+#include <ff/processes/JobSystem.hpp>
 
 #include <ff/graphics/TextureManagerFwd.hpp>
 
@@ -27,6 +28,7 @@ namespace ff {
     class IEnvironment;
     class MessageBus;
     class ActorManager;
+    class JobSystem;
 
     class ILocatorImp {
     public:
@@ -49,6 +51,7 @@ namespace ff {
 
         virtual MessageBus& getMessageBus() = 0;
         virtual ActorManager& getActorManager() = 0;
+        virtual JobSystem& getJobSystem() = 0;
         virtual CameraManager& getCameraManager() = 0;
         virtual TextureManager<ColorTexture>& getColorTextureManager() = 0;
         virtual TextureManager<DepthTexture>& getDepthTextureManager() = 0;
@@ -78,6 +81,8 @@ namespace ff {
 
         static ActorManager& getActorManager();
 
+        static JobSystem& getJobSystem();
+
         static CameraManager& getCameraManager();
         static TextureManager<ColorTexture>& getColorTextureManager();
         static TextureManager<DepthTexture>& getDepthTextureManager();
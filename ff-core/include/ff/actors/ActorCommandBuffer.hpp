@@ -0,0 +1,135 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _FAITHFUL_FOUNTAIN_ACTORS_ACTOR_COMMAND_BUFFER_HPP
+#define _FAITHFUL_FOUNTAIN_ACTORS_ACTOR_COMMAND_BUFFER_HPP
+
+#include <ff/actors/Actor.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ff {
+    class ActorManager;
+
+    constexpr size_t FF_ACTOR_COMMAND_BUFFER_PAGE_SIZE = 4 * 1024;
+
+    /**
+     * Records structural changes (creating and destroying actors, adding and
+     * removing components) to apply later with `playback`, so they can be made
+     * while iterating actors or from JobSystem workers. Recording is thread-safe,
+     * but must not overlap with playback.
+     *
+     * Playback sorts the commands by actor, applies each actor's commands in the
+     * order they were recorded and then updates families once per actor.
+     * Destroying an actor discards its other commands in the same buffer.
+     */
+    class ActorCommandBuffer final {
+    public:
+        ActorCommandBuffer();
+        ~ActorCommandBuffer();
+        ActorCommandBuffer(const ActorCommandBuffer&) = delete;
+        ActorCommandBuffer& operator=(const ActorCommandBuffer&) = delete;
+
+        /**
+         * Returns a placeholder actor. It can be passed to the other commands of
+         * this buffer, and becomes a real actor on playback.
+         */
+        Actor_t createActor();
+        void destroyActor(const Actor_t& actor);
+        /**
+         * The component is constructed now and moved into the actor on playback.
+         */
+        template<typename T, typename... Args>
+        void addComponent(const Actor_t& actor, Args&&... args);
+        template<typename T>
+        void removeComponent(const Actor_t& actor);
+
+        bool isEmpty();
+        void playback(ActorManager& actorManager);
+        void clear();
+
+    private:
+        enum class CommandType : uint8_t {
+            DESTROY,
+            ADD_COMPONENT,
+            REMOVE_COMPONENT
+        };
+        struct Command {
+            Actor_t actor;
+            uint64_t sequence;
+            CommandType type;
+            // The component to add, if any
+            void* data;
+            void (*apply)(ActorManager& actorManager, const Actor_t& actor, void* const& data);
+            void (*destruct)(void* const& data);
+        };
+        /**
+         * Commands recorded by a single thread, with the components they carry
+         * stored in pages that are kept between playbacks.
+         */
+        struct Lane {
+            std::thread::id threadID;
+            std::vector<Command> commands;
+            std::vector<std::unique_ptr<unsigned char[]>> pages;
+            size_t usedPageCount = 0;
+            size_t pageOffset = 0;
+            std::vector<std::unique_ptr<unsigned char[]>> largeAllocations;
+
+            void* allocate(const size_t& size, const size_t& alignment);
+        };
+
+        uint64_t const _id;
+        std::mutex _lanesMutex;
+        std::vector<std::unique_ptr<Lane>> _lanes;
+        std::atomic<uint64_t> _nextSequence;
+        std::atomic<uint32_t> _createdActorCount;
+
+        Lane& getLane();
+        void record(Lane& lane, const Actor_t& actor, const CommandType& type, void* const& data,
+            void (*apply)(ActorManager&, const Actor_t&, void* const&),
+            void (*destruct)(void* const&));
+
+        static bool isPlaceholder(const Actor_t& actor);
+    };
+}
+
+#include <ff/actors/ActorManager.hpp>
+
+#include <new>
+#include <utility>
+
+namespace ff {
+    template<typename T, typename... Args>
+    void ActorCommandBuffer::addComponent(const Actor_t& actor, Args&&... args) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned components cannot be recorded.");
+
+        Lane& lane = getLane();
+        void* data = lane.allocate(sizeof(T), alignof(T));
+        new (data) T(std::forward<Args>(args)...);
+        record(lane, actor, CommandType::ADD_COMPONENT, data,
+            [](ActorManager& actorManager, const Actor_t& actor, void* const& data) {
+                actorManager.addComponentToStorage<T>(actor, std::move(*static_cast<T*>(data)));
+            },
+            [](void* const& data) {
+                static_cast<T*>(data)->~T();
+            });
+    }
+    template<typename T>
+    void ActorCommandBuffer::removeComponent(const Actor_t& actor) {
+        record(getLane(), actor, CommandType::REMOVE_COMPONENT, nullptr,
+            [](ActorManager& actorManager, const Actor_t& actor, void* const& data) {
+                actorManager.removeComponentFromStorage<T>(actor);
+            },
+            nullptr);
+    }
+}
+
+#endif
@@ -10,12 +10,15 @@
 #include <vector>
 #include <unordered_map>
 #include <memory>
+#include <thread>
+#include <typeinfo>
 
 #include <ff/actors/Actor.hpp>
 
 #include <ff/actors/Component.hpp>
 #include <ff/actors/ComponentMap.hpp>
 #include <ff/actors/ComponentMaskSet.hpp>
+#include <ff/actors/ArchetypeStorage.hpp>
 
 #include <ff/actors/IterableActorSet.hpp>
 
@@ -24,19 +27,43 @@
 
 namespace ff {
     class FamilyActorSet;
+    class ActorCommandBuffer;
+    template<typename... Ts>
+    class ActorView;
+
+    enum class ActorStorage {
+        // Each component type is stored in its own ComponentMap. Component
+        // addresses are stable, and adding/removing components is cheap.
+        COMPONENT_MAPS,
+        // Actors with the same component mask share SoA chunks (see ArchetypeStorage).
+        // Iterating with `eachChunk` walks contiguous memory.
+        ARCHETYPES
+    };
 
     class ActorManager final {
     friend class Actor;
     friend class IterableActorSet;
+    friend class ActorCommandBuffer;
+    template<typename... Ts>
+    friend class ActorView;
 
     public:
-        ActorManager();
+        ActorManager(ActorStorage const& storage = ActorStorage::COMPONENT_MAPS);
         ~ActorManager();
 
+        ActorStorage getStorage() const;
+
         Actor_t createActor();
         bool isActorAlive(const Actor_t& actor) const;
 
         void destroyActor(const Actor_t& actor);
+        /**
+         * Destroys every alive actor in `actors`. Component storage is visited once
+         * per component type rather than once per actor, so prefer this over
+         * repeated calls to destroyActor when tearing down large groups.
+         */
+        void destroyActors(Actor_t const* const& actors, size_t const& count);
+        void destroyActors(std::vector<Actor_t> const& actors);
         void destroyAllActors();
         void destroyAllActorsFor(Family const& family);
 
@@ -53,89 +80,203 @@ namespace ff {
         const T& getComponent(const Actor_t& actor) const;
         template<typename T>
         void removeComponent(const Actor_t& actor);
-        ComponentType getComponentMask(const Actor_t& actor) const;
+        const ComponentMask& getComponentMask(const Actor_t& actor) const;
+
+        /**
+         * Calls `fn(count, actors, Ts*... components)` for each run of actors that
+         * match `family` and have every component in `Ts`. With archetype storage,
+         * each call covers a whole chunk of contiguous components; with component
+         * maps, each call covers a single actor.
+         *
+         * Actors cannot gain or lose components, or be destroyed, while iterating.
+         */
+        template<typename... Ts, typename Fn>
+        void eachChunk(const Family& family, const Fn& fn);
+
+        /**
+         * Actors with all of `Ts`, iterable as `(actor, Ts&...)`. See ActorView.
+         */
+        template<typename... Ts>
+        ActorView<Ts...> view();
+        template<typename... Ts>
+        ActorView<Ts...> view(const Family& filter);
+
+        /**
+         * Creates the storage for `Ts` now rather than on first use. Storage can
+         * only be created on the thread that created the ActorManager, so
+         * processes updated concurrently (see Process::declareReads) call this
+         * in `onInitialize` for every component they use.
+         */
+        template<typename... Ts>
+        void prepareComponentStorage();
 
     private:
+        ActorStorage const _storage;
+        std::thread::id const _ownerThread;
+
         std::vector<Actor_t> _actors;
         ActorID _nextFreeActor;
         uint32_t _freeActorCount;
         IterableActorSet _actorsSet;
 
-        std::unordered_map<ComponentType, std::unique_ptr<IComponentMap>> _componentMaps;
+        // Indexed by ComponentIndex, sized up front so it's never reallocated
+        // while other threads read it; null until a component of that type is used
+        std::vector<std::unique_ptr<IComponentMap>> _componentMaps;
         ComponentMaskSet _componentMaskSet;
-
-        int _deferredManagerModificationStack;
-        void beginDeferringManagerModifications();
-        void endDeferringManagerModifications();
+        ArchetypeStorage _archetypeStorage;
 
         template<typename T>
         void initComponentMapForComponent();
+        template<typename T>
+        ComponentMap<T>* getComponentMap();
+
+        /**
+         * Storage and mask changes only; callers update the families.
+         */
+        template<typename T, typename... Args>
+        void addComponentToStorage(const Actor_t& actor, Args&&... args);
+        template<typename T>
+        void removeComponentFromStorage(const Actor_t& actor);
 
         std::unordered_map<Family, std::unique_ptr<FamilyActorSet>> _familyActorSets;
 
-        void updateFamilyActorMapsForActor(const Actor_t& actor, const ComponentType& prevMask);
+        void updateFamilyActorMapsForActor(const Actor_t& actor, const ComponentMask& prevMask);
+        void addActorToFamilies(const Actor_t& actor);
+        void removeActorFromFamilies(const Actor_t& actor);
+        /**
+         * Creates an actor without adding it to any family.
+         */
+        Actor_t allocateActor();
+        void releaseActor(const Actor_t& actor);
 
         bool isActorValid(Actor_t const& actor);
     };
 }
 
+#include <algorithm>
 #include <type_traits>
 
 namespace ff {
     template<typename T, typename... Args>
     T& ActorManager::addComponent(const Actor_t& actor, Args&&... args) {
-        ComponentType type = Component<T>::getType();
-        if(_componentMaps.find(type) == _componentMaps.end()) {
-            initComponentMapForComponent<T>();
-        }
-        ComponentMap<T>& map = static_cast<ComponentMap<T>&>(*_componentMaps.at(type));
-        ComponentType mask = getComponentMask(actor);
-        map.addComponent(actor, std::forward<Args>(args)...);
-        _componentMaskSet.addComponent(actor, type);
+        ComponentMask mask = getComponentMask(actor);
+        addComponentToStorage<T>(actor, std::forward<Args>(args)...);
         updateFamilyActorMapsForActor(actor, mask);
         return getComponent<T>(actor);
     }
     template<typename T>
     bool ActorManager::hasComponent(const Actor_t& actor) const {
-        return _componentMaskSet.hasComponent(actor, Component<T>::getType());
+        return _componentMaskSet.hasComponent(actor, Component<T>::getIndex());
     }
     template<typename T>
     T& ActorManager::getComponent(const Actor_t& actor) {
-        ComponentType type = Component<T>::getType();
-        if(_componentMaps.find(type) == _componentMaps.end()) {
-            initComponentMapForComponent<T>();
+        if(_storage == ActorStorage::ARCHETYPES) {
+            return _archetypeStorage.getComponent<T>(actor);
         }
-        ComponentMap<T>& map = static_cast<ComponentMap<T>&>(*_componentMaps.at(type));
-        return map.getComponent(actor);
+        return getComponentMap<T>()->getComponent(actor);
     }
     template<typename T>
     const T& ActorManager::getComponent(const Actor_t& actor) const {
-        ComponentType type = Component<T>::getType();
-        FF_ASSERT(_componentMaps.find(type) != _componentMaps.end(), "Component type not registered with ActorManager.");
-        const ComponentMap<T>& map = static_cast<const ComponentMap<T>&>(*_componentMaps.at(type));
-        return map.getComponent(actor);
+        if(_storage == ActorStorage::ARCHETYPES) {
+            return _archetypeStorage.getComponent<T>(actor);
+        }
+        ComponentIndex index = Component<T>::getIndex();
+        FF_ASSERT(index < _componentMaps.size() && _componentMaps[index] != nullptr, "Component type not registered with ActorManager.");
+        return static_cast<const ComponentMap<T>&>(*_componentMaps[index]).getComponent(actor);
     }
     template<typename T>
     void ActorManager::removeComponent(const Actor_t& actor) {
-        ComponentType type = Component<T>::getType();
-        if(_componentMaps.find(type) == _componentMaps.end()) {
-            initComponentMapForComponent<T>();
-        }
-        ComponentType mask = getComponentMask(actor);
-        ComponentMap<T>& map = static_cast<ComponentMap<T>&>(*_componentMaps.at(type));
-        map.removeComponent(actor);
-        _componentMaskSet.removeComponent(actor, type);
+        ComponentMask mask = getComponentMask(actor);
+        removeComponentFromStorage<T>(actor);
         updateFamilyActorMapsForActor(actor, mask);
     }
 
+    template<typename... Ts, typename Fn>
+    void ActorManager::eachChunk(const Family& family, const Fn& fn) {
+        static_assert(sizeof...(Ts) > 0, "eachChunk requires at least one component type.");
+
+        ComponentMask required = FF_ACTOR_COMPONENT_MASK_EMPTY;
+        for(ComponentMask const& type : { Component<Ts>::getType()... }) {
+            required |= type;
+        }
+
+        if(_storage == ActorStorage::COMPONENT_MAPS) {
+            view<Ts...>(family).each([&fn](Actor_t actor, Ts&... components) {
+                fn((size_t)1, &actor, &components...);
+            });
+            return;
+        }
+
+        _archetypeStorage.beginIteration();
+        for(auto const& archetype : _archetypeStorage.getArchetypes()) {
+            if((archetype->getMask() & required) != required
+                || !family.matches(archetype->getMask())) {
+                continue;
+            }
+            for(size_t chunk = 0; chunk < archetype->getChunkCount(); ++chunk) {
+                fn((size_t)archetype->getActorCount(chunk), archetype->getActors(chunk), archetype->template getColumn<Ts>(chunk)...);
+            }
+        }
+        _archetypeStorage.endIteration();
+    }
+
+    template<typename... Ts>
+    ActorView<Ts...> ActorManager::view() {
+        return ActorView<Ts...>(this);
+    }
+    template<typename... Ts>
+    ActorView<Ts...> ActorManager::view(const Family& filter) {
+        return ActorView<Ts...>(this, filter);
+    }
+
+    template<typename... Ts>
+    void ActorManager::prepareComponentStorage() {
+        if(_storage == ActorStorage::COMPONENT_MAPS) {
+            (getComponentMap<Ts>(), ...);
+        }
+    }
+
     template<typename T>
     void ActorManager::initComponentMapForComponent() {
         static_assert(std::is_base_of<Component<T>, T>::value, "T must extend off of Component<T>.");
+        FF_ASSERT(std::this_thread::get_id() == _ownerThread,
+            "Component storage for `%s` was first used off the ActorManager's thread (call `prepareComponentStorage` first).", typeid(T).name());
+
+        ComponentIndex index = Component<T>::getIndex();
+        _componentMaps[index] = std::make_unique<ComponentMap<T>>();
+        _componentMaps[index]->addEmptyActors((int)_actors.size());
+    }
+    template<typename T>
+    ComponentMap<T>* ActorManager::getComponentMap() {
+        ComponentIndex index = Component<T>::getIndex();
+        if(_componentMaps[index] == nullptr) {
+            initComponentMapForComponent<T>();
+        }
+        return static_cast<ComponentMap<T>*>(_componentMaps[index].get());
+    }
 
-        ComponentType type = Component<T>::getType();
-        _componentMaps.emplace(type, std::make_unique<ComponentMap<T>>());
-        _componentMaps[type]->addEmptyActors((int)_actors.size());
+    template<typename T, typename... Args>
+    void ActorManager::addComponentToStorage(const Actor_t& actor, Args&&... args) {
+        ComponentIndex index = Component<T>::getIndex();
+        if(_storage == ActorStorage::ARCHETYPES) {
+            _archetypeStorage.addComponent<T>(actor, getComponentMask(actor), std::forward<Args>(args)...);
+        } else {
+            getComponentMap<T>()->addComponent(actor, std::forward<Args>(args)...);
+        }
+        _componentMaskSet.addComponent(actor, index);
+    }
+    template<typename T>
+    void ActorManager::removeComponentFromStorage(const Actor_t& actor) {
+        ComponentIndex index = Component<T>::getIndex();
+        if(_storage == ActorStorage::ARCHETYPES) {
+            _archetypeStorage.removeComponent<T>(actor, getComponentMask(actor));
+        } else {
+            getComponentMap<T>()->removeComponent(actor);
+        }
+        _componentMaskSet.removeComponent(actor, index);
     }
 }
 
+#include <ff/actors/ActorView.hpp>
+
 #endif
@@ -0,0 +1,342 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _FAITHFUL_FOUNTAIN_ACTORS_ACTOR_VIEW_HPP
+#define _FAITHFUL_FOUNTAIN_ACTORS_ACTOR_VIEW_HPP
+
+#include <ff/actors/Actor.hpp>
+#include <ff/actors/Component.hpp>
+#include <ff/actors/ComponentMap.hpp>
+#include <ff/actors/ArchetypeStorage.hpp>
+#include <ff/actors/Family.hpp>
+
+#include <tuple>
+#include <vector>
+#include <cstddef>
+
+namespace ff {
+    class ActorManager;
+
+    /**
+     * Every actor that has all of `Ts` (and matches an optional filter family),
+     * yielding `(actor, Ts&...)`:
+     *
+     *     for(auto [actor, transform, model] : actorManager.view<TransformComponent, ModelComponent>()) { ... }
+     *     actorManager.view<TransformComponent>().each([](Actor_t actor, TransformComponent& transform) { ... });
+     *
+     * The storage for each component type is resolved once, when the view is
+     * created. With component maps, the map with the fewest components is walked
+     * and the others are probed by actor ID; with archetypes, matching chunks are
+     * walked directly.
+     *
+     * Actors added during iteration may or may not be visited. With archetype
+     * storage, no actor may gain or lose components while the view is alive.
+     */
+    template<typename... Ts>
+    class ActorView final {
+    public:
+        class Iterator final {
+        friend class ActorView;
+        public:
+            typedef std::tuple<Actor_t, Ts&...> value_type;
+
+            value_type operator*() const;
+            Iterator& operator++();
+            bool operator==(const Iterator& other) const;
+            bool operator!=(const Iterator& other) const;
+
+        private:
+            Iterator(ActorView* const& view, const bool& done);
+
+            ActorView* _view;
+            bool _done;
+            Actor_t _actor;
+            // Component maps: the component of each type for the current actor
+            // Archetypes: the first component of each column in the current chunk
+            std::tuple<Ts*...> _components;
+
+            // Component maps
+            size_t _slot;
+
+            // Archetypes
+            size_t _archetype;
+            size_t _chunk;
+            uint32_t _row;
+            uint32_t _rowCount;
+            Actor_t const* _actors;
+
+            void advanceComponentMaps();
+            void advanceArchetypes();
+        };
+
+        ActorView(ActorManager* const& actorManagerPtr);
+        ActorView(ActorManager* const& actorManagerPtr, const Family& filter);
+        ~ActorView();
+        ActorView(const ActorView&) = delete;
+        ActorView& operator=(const ActorView&) = delete;
+
+        Iterator begin();
+        Iterator end();
+
+        /**
+         * Calls `fn(actor, Ts&...)` for each actor in the view.
+         */
+        template<typename Fn>
+        void each(const Fn& fn);
+        /**
+         * For splitting iteration over threads (see `ff::parallelEach`): the view
+         * is `getPartitionCount()` partitions, each a slot of the smallest component
+         * map or, with archetypes, a whole chunk. Any ranges of them may be visited
+         * with `eachInPartitions` concurrently.
+         */
+        size_t getPartitionCount();
+        bool getPartitionsAreChunks() const;
+        template<typename Fn>
+        void eachInPartitions(const size_t& begin, const size_t& end, const Fn& fn);
+
+    private:
+        ActorManager* const _actorManagerPtr;
+        bool const _useArchetypes;
+        bool const _hasFilter;
+        Family const _filter;
+
+        std::tuple<ComponentMap<Ts>*...> _componentMaps;
+        IComponentMap* _smallestComponentMap;
+
+        std::vector<Archetype*> _archetypes;
+        // Archetypes only: every chunk of `_archetypes`, filled by getPartitionCount
+        std::vector<std::pair<Archetype*, size_t>> _chunks;
+
+        void init();
+        /**
+         * Component maps only. Returns true if the component in `slot` of the smallest
+         * map belongs to an actor in the view.
+         */
+        bool resolveSlot(const size_t& slot, Actor_t& actor, std::tuple<Ts*...>& components) const;
+    };
+}
+
+#include <ff/actors/ActorManager.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace ff {
+    template<typename... Ts>
+    ActorView<Ts...>::ActorView(ActorManager* const& actorManagerPtr)
+        :_actorManagerPtr(actorManagerPtr),
+        _useArchetypes(actorManagerPtr->getStorage() == ActorStorage::ARCHETYPES),
+        _hasFilter(false),
+        _filter(Family::all<Ts...>().get()),
+        _smallestComponentMap(nullptr) {
+        init();
+    }
+    template<typename... Ts>
+    ActorView<Ts...>::ActorView(ActorManager* const& actorManagerPtr, const Family& filter)
+        :_actorManagerPtr(actorManagerPtr),
+        _useArchetypes(actorManagerPtr->getStorage() == ActorStorage::ARCHETYPES),
+        _hasFilter(true),
+        _filter(filter),
+        _smallestComponentMap(nullptr) {
+        init();
+    }
+    template<typename... Ts>
+    ActorView<Ts...>::~ActorView() {
+        if(_useArchetypes) {
+            _actorManagerPtr->_archetypeStorage.endIteration();
+        }
+    }
+
+    template<typename... Ts>
+    void ActorView<Ts...>::init() {
+        static_assert(sizeof...(Ts) > 0, "A view requires at least one component type.");
+
+        if(_useArchetypes) {
+            ComponentMask required = FF_ACTOR_COMPONENT_MASK_EMPTY;
+            for(ComponentMask const& type : { Component<Ts>::getType()... }) {
+                required |= type;
+            }
+            for(auto const& archetype : _actorManagerPtr->_archetypeStorage.getArchetypes()) {
+                if((archetype->getMask() & required) == required
+                    && (!_hasFilter || _filter.matches(archetype->getMask()))) {
+                    _archetypes.push_back(archetype.get());
+                }
+            }
+            _actorManagerPtr->_archetypeStorage.beginIteration();
+            return;
+        }
+
+        _componentMaps = std::make_tuple(_actorManagerPtr->template getComponentMap<Ts>()...);
+        for(IComponentMap* componentMap : { static_cast<IComponentMap*>(std::get<ComponentMap<Ts>*>(_componentMaps))... }) {
+            if(_smallestComponentMap == nullptr
+                || componentMap->getComponentCount() < _smallestComponentMap->getComponentCount()) {
+                _smallestComponentMap = componentMap;
+            }
+        }
+    }
+
+    template<typename... Ts>
+    typename ActorView<Ts...>::Iterator ActorView<Ts...>::begin() {
+        return Iterator(this, false);
+    }
+    template<typename... Ts>
+    typename ActorView<Ts...>::Iterator ActorView<Ts...>::end() {
+        return Iterator(this, true);
+    }
+
+    template<typename... Ts>
+    template<typename Fn>
+    void ActorView<Ts...>::each(const Fn& fn) {
+        for(auto it = begin(); it != end(); ++it) {
+            std::apply(fn, *it);
+        }
+    }
+
+    template<typename... Ts>
+    size_t ActorView<Ts...>::getPartitionCount() {
+        if(!_useArchetypes) {
+            return _smallestComponentMap->getSlotCount();
+        }
+
+        _chunks.clear();
+        for(Archetype* archetype : _archetypes) {
+            for(size_t chunk = 0; chunk < archetype->getChunkCount(); ++chunk) {
+                _chunks.emplace_back(archetype, chunk);
+            }
+        }
+        return _chunks.size();
+    }
+    template<typename... Ts>
+    bool ActorView<Ts...>::getPartitionsAreChunks() const {
+        return _useArchetypes;
+    }
+    template<typename... Ts>
+    template<typename Fn>
+    void ActorView<Ts...>::eachInPartitions(const size_t& begin, const size_t& end, const Fn& fn) {
+        if(_useArchetypes) {
+            for(size_t i = begin; i < end; ++i) {
+                Archetype& archetype = *_chunks[i].first;
+                size_t const& chunk = _chunks[i].second;
+                Actor_t const* actors = archetype.getActors(chunk);
+                std::tuple<Ts*...> columns = std::make_tuple(archetype.template getColumn<Ts>(chunk)...);
+                for(uint32_t row = 0; row < archetype.getActorCount(chunk); ++row) {
+                    fn(actors[row], std::get<Ts*>(columns)[row]...);
+                }
+            }
+            return;
+        }
+
+        Actor_t actor;
+        std::tuple<Ts*...> components;
+        for(size_t slot = begin; slot < end; ++slot) {
+            if(resolveSlot(slot, actor, components)) {
+                fn(actor, *std::get<Ts*>(components)...);
+            }
+        }
+    }
+
+    template<typename... Ts>
+    bool ActorView<Ts...>::resolveSlot(const size_t& slot, Actor_t& actor, std::tuple<Ts*...>& components) const {
+        ActorID actorID = _smallestComponentMap->getActorAtSlot(slot);
+        if(actorID == FF_ACTOR_INVALID) {
+            return false;
+        }
+        components = std::make_tuple(std::get<ComponentMap<Ts>*>(_componentMaps)->tryGetComponent(actorID)...);
+        for(bool isNull : { std::get<Ts*>(components) == nullptr... }) {
+            if(isNull) {
+                return false;
+            }
+        }
+        actor = _actorManagerPtr->_actors[actorID];
+        return !_hasFilter || _filter.matches(_actorManagerPtr->getComponentMask(actor));
+    }
+
+    template<typename... Ts>
+    ActorView<Ts...>::Iterator::Iterator(ActorView* const& view, const bool& done)
+        :_view(view),
+        _done(done),
+        _actor(NullActor),
+        _slot(0),
+        _archetype(0),
+        _chunk(0),
+        _row(0),
+        _rowCount(0),
+        _actors(nullptr) {
+        if(_done) {
+            return;
+        }
+        // Position on the first match; the advance functions move past the current position first
+        if(_view->_useArchetypes) {
+            _archetype = 0;
+            _chunk = 0;
+            _row = 0;
+            _rowCount = 0;
+            advanceArchetypes();
+        } else {
+            _slot = (size_t)-1;
+            advanceComponentMaps();
+        }
+    }
+
+    template<typename... Ts>
+    typename ActorView<Ts...>::Iterator::value_type ActorView<Ts...>::Iterator::operator*() const {
+        return value_type(_actor, std::get<Ts*>(_components)[_row]...);
+    }
+    template<typename... Ts>
+    typename ActorView<Ts...>::Iterator& ActorView<Ts...>::Iterator::operator++() {
+        if(_view->_useArchetypes) {
+            ++_row;
+            advanceArchetypes();
+        } else {
+            advanceComponentMaps();
+        }
+        return *this;
+    }
+    template<typename... Ts>
+    bool ActorView<Ts...>::Iterator::operator==(const Iterator& other) const {
+        return _done == other._done && (_done || _actor == other._actor);
+    }
+    template<typename... Ts>
+    bool ActorView<Ts...>::Iterator::operator!=(const Iterator& other) const {
+        return !(*this == other);
+    }
+
+    template<typename... Ts>
+    void ActorView<Ts...>::Iterator::advanceComponentMaps() {
+        // The slot count is re-read every step, since adding components can add pages
+        while(++_slot < _view->_smallestComponentMap->getSlotCount()) {
+            if(_view->resolveSlot(_slot, _actor, _components)) {
+                return;
+            }
+        }
+        _done = true;
+    }
+    template<typename... Ts>
+    void ActorView<Ts...>::Iterator::advanceArchetypes() {
+        while(_row >= _rowCount) {
+            if(_actors != nullptr) {
+                ++_chunk;
+            }
+            while(_archetype < _view->_archetypes.size()
+                && _chunk >= _view->_archetypes[_archetype]->getChunkCount()) {
+                ++_archetype;
+                _chunk = 0;
+            }
+            if(_archetype >= _view->_archetypes.size()) {
+                _done = true;
+                return;
+            }
+            Archetype& archetype = *_view->_archetypes[_archetype];
+            _row = 0;
+            _rowCount = archetype.getActorCount(_chunk);
+            _actors = archetype.getActors(_chunk);
+            _components = std::make_tuple(archetype.template getColumn<Ts>(_chunk)...);
+        }
+        _actor = _actors[_row];
+    }
+}
+
+#endif
@@ -0,0 +1,255 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _FAITHFUL_FOUNTAIN_ACTORS_ARCHETYPE_STORAGE_HPP
+#define _FAITHFUL_FOUNTAIN_ACTORS_ARCHETYPE_STORAGE_HPP
+
+#include <ff/actors/Actor.hpp>
+#include <ff/actors/Component.hpp>
+
+#include <vector>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <cstddef>
+#include <stdint.h>
+
+namespace ff {
+    namespace _internal {
+        /**
+         * Type-erased operations on a component type, so that archetype chunks can
+         * hold components of any type in raw memory.
+         */
+        struct ComponentColumnInfo {
+            ComponentMask type;
+            ComponentIndex index;
+            size_t size;
+            size_t alignment;
+            // Constructs `dst` from `src`. `src` is left to be destructed by the caller.
+            void (*moveConstruct)(void* dst, void* src);
+            void (*destruct)(void* component);
+            void (*dispatchRemoved)(Actor_t const& actor);
+            void (*dispatchRemovedBulk)(Actor_t const* const& actors, size_t const& count);
+        };
+
+        template<typename T>
+        ComponentColumnInfo const& getComponentColumnInfo();
+    }
+
+    constexpr size_t FF_ARCHETYPE_CHUNK_SIZE = 16 * 1024;
+
+    /**
+     * A fixed-size block of memory holding up to `Archetype::getChunkCapacity()`
+     * actors. Each component type of the archetype is laid out as its own
+     * contiguous column.
+     */
+    struct ArchetypeChunk final {
+        ArchetypeChunk(size_t const& size, size_t const& alignment, uint32_t const& capacity);
+        ~ArchetypeChunk();
+        ArchetypeChunk(ArchetypeChunk const&) = delete;
+        ArchetypeChunk& operator=(ArchetypeChunk const&) = delete;
+
+        unsigned char* data;
+        size_t alignment;
+        std::vector<Actor_t> actors;
+    };
+
+    /**
+     * Every actor with exactly the same component mask. Actors are packed into
+     * the front of the chunk list; only the last chunk may be partially full.
+     */
+    class Archetype final {
+    friend class ArchetypeStorage;
+    public:
+        Archetype(ComponentMask const& mask, std::vector<_internal::ComponentColumnInfo const*> const& columns);
+        ~Archetype() = default;
+
+        const ComponentMask& getMask() const;
+        uint32_t getChunkCapacity() const;
+        size_t getChunkCount() const;
+        size_t getActorCount() const;
+
+        uint32_t getActorCount(size_t const& chunk) const;
+        Actor_t const* getActors(size_t const& chunk) const;
+        bool hasColumn(ComponentIndex const& index) const;
+
+        template<typename T>
+        T* getColumn(size_t const& chunk);
+
+    private:
+        ComponentMask _mask;
+        std::vector<_internal::ComponentColumnInfo const*> _columns;
+        // Column for each component index, or -1 if the archetype doesn't have it
+        std::array<int16_t, FF_MAX_COMPONENTS> _columnIndices;
+        std::vector<size_t> _columnOffsets;
+        uint32_t _chunkCapacity;
+        size_t _chunkSize;
+        size_t _chunkAlignment;
+        std::vector<std::unique_ptr<ArchetypeChunk>> _chunks;
+        // The last chunk to empty, kept so an actor moving in and out of the
+        // archetype doesn't allocate and free a chunk each time
+        std::unique_ptr<ArchetypeChunk> _spareChunk;
+
+        void* getComponent(uint32_t const& chunk, uint32_t const& row, size_t const& column);
+    };
+
+    /**
+     * Alternative to ComponentMaps for ActorManager. Actors sharing a component
+     * mask are grouped into archetypes, so iterating a family walks contiguous
+     * memory rather than doing a lookup per component per actor.
+     *
+     * The trade-off is that adding or removing a component moves every one of the
+     * actor's components, and component addresses are only stable until the next
+     * structural change (add/remove component, destroy actor) of the archetype.
+     */
+    class ArchetypeStorage final {
+    public:
+        ArchetypeStorage();
+        ~ArchetypeStorage();
+
+        void addEmptyActor();
+        void addEmptyActors(const int& count);
+
+        template<typename T, typename... Args>
+        void addComponent(const Actor_t& actor, const ComponentMask& prevMask, Args&&... args);
+        template<typename T>
+        void removeComponent(const Actor_t& actor, const ComponentMask& prevMask);
+        void removeAllComponents(const Actor_t& actor);
+        /**
+         * Sends one ComponentsRemovedEvent per component type (see there for
+         * ComponentRemovedEvent). `actors` must not contain duplicates.
+         */
+        void removeAllComponents(Actor_t const* const& actors, const size_t& count);
+        template<typename T>
+        T& getComponent(const Actor_t& actor);
+        template<typename T>
+        const T& getComponent(const Actor_t& actor) const;
+
+        const std::vector<std::unique_ptr<Archetype>>& getArchetypes() const;
+
+        /**
+         * While iterating, actors may not move between archetypes, since that
+         * would invalidate the chunk being walked.
+         */
+        void beginIteration();
+        void endIteration();
+
+    private:
+        struct Location {
+            uint32_t archetype;
+            uint32_t chunk;
+            uint32_t row;
+        };
+        static constexpr uint32_t NO_ARCHETYPE = FF_ACTOR_INVALID;
+
+        std::vector<Location> _locations;
+        std::vector<std::unique_ptr<Archetype>> _archetypes;
+        std::unordered_map<ComponentMask, uint32_t> _archetypeIndices;
+        std::array<_internal::ComponentColumnInfo const*, FF_MAX_COMPONENTS> _columnInfos;
+        // Atomic, since views may be created on several threads at once
+        std::atomic<uint32_t> _iterationDepth;
+
+        void registerColumn(_internal::ComponentColumnInfo const& info);
+        uint32_t getOrCreateArchetype(const ComponentMask& mask);
+        void* getComponent(const Actor_t& actor, const ComponentIndex& index) const;
+        /**
+         * Moves the actor to the archetype for `mask`, moving every component the
+         * two archetypes share and destructing the rest. Components in `mask` that
+         * the actor didn't have are left unconstructed.
+         */
+        void moveActor(const Actor_t& actor, const ComponentMask& mask);
+        void removeRow(const uint32_t& archetype, const uint32_t& chunk, const uint32_t& row);
+    };
+}
+
+#include <ff/Console.hpp>
+#include <ff/Locator.hpp>
+#include <ff/actors/ComponentMap.hpp>
+#include <ff/events/actors/ComponentRemovedEvent.hpp>
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ff {
+    namespace _internal {
+        template<typename T>
+        ComponentColumnInfo const& getComponentColumnInfo() {
+#ifdef FF_ACTOR_ARCHETYPE_STORAGE
+            // The main ActorManager stores everything in archetypes, so catch it early
+            static_assert(std::is_move_constructible<T>::value, "Components must be move constructible to be stored in archetypes.");
+#endif
+            static ComponentColumnInfo const info = {
+                Component<T>::getType(),
+                Component<T>::getIndex(),
+                sizeof(T),
+                alignof(T),
+                [](void* dst, void* src) {
+                    // Component maps never move components, so only archetypes need this
+                    if constexpr(std::is_move_constructible<T>::value) {
+                        new (dst) T(std::move(*static_cast<T*>(src)));
+                    } else {
+                        FF_CONSOLE_FATAL("Component %s must be move constructible to be stored in archetypes.", typeid(T).name());
+                    }
+                },
+                [](void* component) {
+                    static_cast<T*>(component)->~T();
+                },
+                [](Actor_t const& actor) {
+                    if constexpr(T::dispatchesRemovedEvents) {
+                        Locator::getMessageBus().dispatch<ComponentRemovedEvent<T>>(actor);
+                    }
+                },
+                [](Actor_t const* const& actors, size_t const& count) {
+                    if constexpr(T::dispatchesRemovedEvents) {
+                        dispatchComponentsRemoved<T>(actors, count);
+                    }
+                }
+            };
+            return info;
+        }
+    }
+
+    template<typename T>
+    T* Archetype::getColumn(size_t const& chunk) {
+        int16_t column = _columnIndices[_internal::getComponentColumnInfo<T>().index];
+        FF_ASSERT(column >= 0, "Archetype does not have component %s.", typeid(T).name());
+        return reinterpret_cast<T*>(_chunks[chunk]->data + _columnOffsets[column]);
+    }
+
+    template<typename T, typename... Args>
+    void ArchetypeStorage::addComponent(const Actor_t& actor, const ComponentMask& prevMask, Args&&... args) {
+        _internal::ComponentColumnInfo const& info = _internal::getComponentColumnInfo<T>();
+        FF_ASSERT(!prevMask.test(info.index), "Actor %s already has component.", actor);
+        registerColumn(info);
+
+        moveActor(actor, prevMask | info.type);
+        new (getComponent(actor, info.index)) T(std::forward<Args>(args)...);
+    }
+    template<typename T>
+    void ArchetypeStorage::removeComponent(const Actor_t& actor, const ComponentMask& prevMask) {
+        _internal::ComponentColumnInfo const& info = _internal::getComponentColumnInfo<T>();
+        if(!prevMask.test(info.index)) {
+            return;
+        }
+
+        if constexpr(T::dispatchesRemovedEvents) {
+            Locator::getMessageBus().dispatch<ComponentRemovedEvent<T>>(actor);
+        }
+        moveActor(actor, prevMask & ~info.type);
+    }
+    template<typename T>
+    T& ArchetypeStorage::getComponent(const Actor_t& actor) {
+        return *static_cast<T*>(getComponent(actor, _internal::getComponentColumnInfo<T>().index));
+    }
+    template<typename T>
+    const T& ArchetypeStorage::getComponent(const Actor_t& actor) const {
+        return *static_cast<T const*>(getComponent(actor, _internal::getComponentColumnInfo<T>().index));
+    }
+}
+
+#endif
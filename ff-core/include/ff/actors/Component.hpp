@@ -7,18 +7,14 @@
 #ifndef _FAITHFUL_FOUNTAIN_ACTORS_COMPONENT_HPP
 #define _FAITHFUL_FOUNTAIN_ACTORS_COMPONENT_HPP
 
-#include <bitset>
-#include <typeindex>
+#include <ff/actors/ComponentMask.hpp>
 
-#define FF_MAX_COMPONENTS 64
+#include <typeindex>
 
 namespace ff {
-    typedef std::bitset<FF_MAX_COMPONENTS> ComponentType;
-    constexpr ComponentType FF_ACTOR_COMPONENT_MASK_EMPTY = 0;
-
     namespace _internal {
         struct IComponent {
-            virtual const ComponentType& getComponentType() const = 0;
+            virtual const ComponentMask& getComponentType() const = 0;
 
             virtual ~IComponent() {}
         };
@@ -29,24 +25,43 @@ namespace ff {
         virtual ~Component() {
         }
 
-        const ComponentType& getComponentType() const override;
-        static const ComponentType& getType();
+        /**
+         * Whether removing this component dispatches ComponentRemovedEvent and
+         * ComponentsRemovedEvent. Components nobody listens for can opt out:
+         *
+         *     struct TagComponent : Component<TagComponent> {
+         *         static constexpr bool dispatchesRemovedEvents = false;
+         *     };
+         */
+        static constexpr bool dispatchesRemovedEvents = true;
+
+        const ComponentMask& getComponentType() const override;
+        /**
+         * Mask with only this component's bit set.
+         */
+        static const ComponentMask& getType();
+        static ComponentIndex getIndex();
     };
 
     namespace _internal {
-        ComponentType getNextComponentType();
-        ComponentType getComponentType(const std::type_index& type);
+        ComponentIndex getComponentIndex(const std::type_index& type);
+        ComponentIndex getComponentCount();
     }
 
     template<typename T>
-    const ComponentType& Component<T>::getComponentType() const {
+    const ComponentMask& Component<T>::getComponentType() const {
         return Component<T>::getType();
     }
     template<typename T>
-    const ComponentType& Component<T>::getType() {
-        static ComponentType type = _internal::getComponentType(typeid(Component<T>));
+    const ComponentMask& Component<T>::getType() {
+        static ComponentMask const type = ComponentMask::fromIndex(getIndex());
         return type;
     }
+    template<typename T>
+    ComponentIndex Component<T>::getIndex() {
+        static ComponentIndex const index = _internal::getComponentIndex(typeid(Component<T>));
+        return index;
+    }
 }
 
 #endif
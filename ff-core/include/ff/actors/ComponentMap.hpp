@@ -11,50 +11,84 @@
 
 #include <vector>
 #include <memory>
-#include <array>
+#include <new>
 
 #include <ff/events/actors/ComponentRemovedEvent.hpp>
+#include <ff/events/actors/ComponentsRemovedEvent.hpp>
 
 namespace ff {
     struct IComponentMap {
+        IComponentMap();
         virtual ~IComponentMap() = default;
 
         virtual void addEmptyActor() = 0;
         virtual void addEmptyActors(const int& count) = 0;
-        virtual void removeAllActors() = 0;
 
         virtual void removeComponent(const Actor_t& actor) = 0;
+        /**
+         * Removes the component from each actor in `actors` that has it, with a
+         * single ComponentsRemovedEvent (see there for ComponentRemovedEvent).
+         * `actors` must not contain duplicates.
+         */
+        virtual void removeComponents(Actor_t const* const& actors, const size_t& count) = 0;
         virtual bool hasComponent(const Actor_t& actor) const = 0;
+
+        size_t getComponentCount() const;
+        size_t getSlotCount() const;
+        /**
+         * Returns the ID of the actor owning the component in `slot`, or
+         * FF_ACTOR_INVALID if the slot is free.
+         */
+        ActorID getActorAtSlot(const size_t& slot) const;
+
+    protected:
+        std::vector<ActorID> _actorIndices;
+        
+        std::vector<ActorID> _actorList;
+        int _abandondedComponentCount;
     };
 
     constexpr size_t FF_COMPONENT_MAP_PAGE_SIZE = 256;
 
+    /**
+     * Components live in pages of raw storage: they are constructed in place when
+     * added and destructed when removed, so T needs neither a default constructor
+     * nor to be movable, and free slots hold no objects.
+     */
     template<typename T>
     class ComponentMap : public IComponentMap {
     public:
         ComponentMap();
-        virtual ~ComponentMap() = default;
-        
+        virtual ~ComponentMap();
+        ComponentMap(const ComponentMap&) = delete;
+        ComponentMap& operator=(const ComponentMap&) = delete;
+
         void addEmptyActor() override;
         void addEmptyActors(const int& count) override;
-        virtual void removeAllActors() override;
 
         template<typename... Args>
         void addComponent(const Actor_t& actor, Args&&... args);
         void removeComponent(const Actor_t& actor) override;
+        void removeComponents(Actor_t const* const& actors, const size_t& count) override;
         bool hasComponent(const Actor_t& actor) const override;
         T& getComponent(const Actor_t& actor);
         const T& getComponent(const Actor_t& actor) const;
+        T* tryGetComponent(const ActorID& actorID);
 
     private:
-        std::vector<ActorID> _actorIndices;
-        
-        std::vector<ActorID> _actorList;
-        std::vector<std::unique_ptr<std::array<T, FF_COMPONENT_MAP_PAGE_SIZE>>> _componentListPages;
-        int _abandondedComponentCount;
+        struct Page {
+            alignas(T) unsigned char data[sizeof(T) * FF_COMPONENT_MAP_PAGE_SIZE];
+        };
+
+        std::vector<std::unique_ptr<Page>> _componentListPages;
         int _nextAbandonedComponent;
+        // Reused by `removeComponents`. Moved out while in use, so removals
+        // from within a listener don't share it.
+        std::vector<Actor_t> _removedActors;
 
         void addNewPage();
+        T* getSlot(const size_t& index) const;
+        void destroyComponent(const ActorID& actorID);
     };
 }
 
@@ -62,10 +96,46 @@ namespace ff {
 #include <ff/Locator.hpp>
 
 namespace ff {
+    namespace _internal {
+        template<typename T>
+        void dispatchComponentsRemoved(Actor_t const* const& actors, const size_t& count) {
+            MessageBus& messageBus = Locator::getMessageBus();
+            if(messageBus.hasListeners<ComponentRemovedEvent<T>>()) {
+                for(size_t i = 0; i < count; i++) {
+                    messageBus.dispatch<ComponentRemovedEvent<T>>(actors[i]);
+                }
+            }
+            messageBus.dispatch<ComponentsRemovedEvent<T>>(actors, count);
+        }
+    }
+
+    inline IComponentMap::IComponentMap()
+        :_abandondedComponentCount(0) {
+    }
+    inline size_t IComponentMap::getComponentCount() const {
+        return _actorList.size() - _abandondedComponentCount;
+    }
+    inline size_t IComponentMap::getSlotCount() const {
+        return _actorList.size();
+    }
+    inline ActorID IComponentMap::getActorAtSlot(const size_t& slot) const {
+        // Free slots hold the next free slot instead of an actor, which never
+        // points back to `slot`
+        ActorID actorID = _actorList[slot];
+        return actorID < _actorIndices.size() && _actorIndices[actorID] == slot ? actorID : FF_ACTOR_INVALID;
+    }
+
     template<typename T>
     ComponentMap<T>::ComponentMap()
-        :_abandondedComponentCount(0),
-        _nextAbandonedComponent(0) {
+        :_nextAbandonedComponent(0) {
+    }
+    template<typename T>
+    ComponentMap<T>::~ComponentMap() {
+        for(size_t slot = 0; slot < getSlotCount(); slot++) {
+            if(getActorAtSlot(slot) != FF_ACTOR_INVALID) {
+                getSlot(slot)->~T();
+            }
+        }
     }
 
     template<typename T>
@@ -76,12 +146,6 @@ namespace ff {
     void ComponentMap<T>::addEmptyActors(const int& count) {
         _actorIndices.resize(_actorIndices.size() + count, FF_ACTOR_INVALID);
     }
-    template<typename T>
-    void ComponentMap<T>::removeAllActors() {
-        for(int i = 0; i < _actorIndices.size(); i++) {
-            removeComponent(_actorIndices[i]);
-        }
-    }
 
     template<typename T>
     template<typename... Args>
@@ -101,8 +165,7 @@ namespace ff {
             _actorList[index] = actorID;
             _abandondedComponentCount--;
 
-            T component(std::forward<Args>(args)...);
-            std::swap(component, _componentListPages[index / FF_COMPONENT_MAP_PAGE_SIZE]->at(index % FF_COMPONENT_MAP_PAGE_SIZE));
+            new (getSlot(index)) T(std::forward<Args>(args)...);
         }
     }
     template<typename T>
@@ -111,28 +174,30 @@ namespace ff {
             return;
         }
 
-        ActorID actorID = convertActorToID(actor);
-
-        Locator::getMessageBus().dispatch<ComponentRemovedEvent<T>>(actor);
-
-        const int& index = _actorIndices[actorID];
-
-        T tempT;
-        std::swap(_componentListPages[index / FF_COMPONENT_MAP_PAGE_SIZE]->at(index % FF_COMPONENT_MAP_PAGE_SIZE), tempT);
-
-        _actorList[index] = FF_ACTOR_INVALID;
-        if(_abandondedComponentCount > 0) {
-            int lastAbandondedComponent = _nextAbandonedComponent;
-            while(_actorList[lastAbandondedComponent] != FF_ACTOR_INVALID) {
-                lastAbandondedComponent = _actorList[lastAbandondedComponent];
+        if constexpr(T::dispatchesRemovedEvents) {
+            Locator::getMessageBus().dispatch<ComponentRemovedEvent<T>>(actor);
+        }
+        destroyComponent(convertActorToID(actor));
+    }
+    template<typename T>
+    void ComponentMap<T>::removeComponents(Actor_t const* const& actors, const size_t& count) {
+        std::vector<Actor_t> removedActors = std::move(_removedActors);
+        removedActors.clear();
+        for(size_t i = 0; i < count; i++) {
+            if(hasComponent(actors[i])) {
+                removedActors.push_back(actors[i]);
             }
-            _actorList[lastAbandondedComponent] = index;
-        } else {
-            _nextAbandonedComponent = index;
         }
-        _abandondedComponentCount++;
 
-        _actorIndices[actorID] = FF_ACTOR_INVALID;
+        if(!removedActors.empty()) {
+            if constexpr(T::dispatchesRemovedEvents) {
+                _internal::dispatchComponentsRemoved<T>(removedActors.data(), removedActors.size());
+            }
+            for(Actor_t const& actor : removedActors) {
+                destroyComponent(convertActorToID(actor));
+            }
+        }
+        _removedActors = std::move(removedActors);
     }
     template<typename T>
     bool ComponentMap<T>::hasComponent(const Actor_t& actor) const {
@@ -142,36 +207,54 @@ namespace ff {
     T& ComponentMap<T>::getComponent(const Actor_t& actor) {
         ActorID actorID = convertActorToID(actor);
         FF_ASSERT(hasComponent(actor), "Actor %s does not have component.", actorID);
-        int page = _actorIndices[actorID] / FF_COMPONENT_MAP_PAGE_SIZE;
-        return _componentListPages[page]->at(_actorIndices[actorID] % FF_COMPONENT_MAP_PAGE_SIZE);
+        return *getSlot(_actorIndices[actorID]);
     }
     template<typename T>
     const T& ComponentMap<T>::getComponent(const Actor_t& actor) const {
         ActorID actorID = convertActorToID(actor);
         FF_ASSERT(hasComponent(actor), "Actor %s does not have component.", actorID);
-        int page = _actorIndices[actorID] / FF_COMPONENT_MAP_PAGE_SIZE;
-        return _componentListPages[page]->at(_actorIndices[actorID] % FF_COMPONENT_MAP_PAGE_SIZE);
+        return *getSlot(_actorIndices[actorID]);
+    }
+    
+    template<typename T>
+    T* ComponentMap<T>::tryGetComponent(const ActorID& actorID) {
+        if(actorID >= _actorIndices.size() || _actorIndices[actorID] == FF_ACTOR_INVALID) {
+            return nullptr;
+        }
+        return getSlot(_actorIndices[actorID]);
     }
     
     template<typename T>
     void ComponentMap<T>::addNewPage() {
-        _componentListPages.emplace_back(std::make_unique<std::array<T, FF_COMPONENT_MAP_PAGE_SIZE>>());
+        // Default-initialized, so the storage isn't zeroed
+        _componentListPages.emplace_back(new Page);
         _actorList.resize(_actorList.size() + FF_COMPONENT_MAP_PAGE_SIZE);
-        _actorList.back() = FF_ACTOR_INVALID;
-        for(int i = _actorList.size() - FF_COMPONENT_MAP_PAGE_SIZE; i < _actorList.size() - 1; i++) {
+        int pageStart = _actorList.size() - FF_COMPONENT_MAP_PAGE_SIZE;
+        for(int i = pageStart; i < _actorList.size() - 1; i++) {
             _actorList[i] = i + 1;
         }
-        if(_abandondedComponentCount > 0) {
-            int lastAbandondedComponent = _nextAbandonedComponent;
-            while(_actorList[lastAbandondedComponent] != FF_ACTOR_INVALID) {
-                lastAbandondedComponent = _actorList[lastAbandondedComponent];
-            }
-            _actorList[lastAbandondedComponent] = _actorList.size() - FF_COMPONENT_MAP_PAGE_SIZE;
-        } else {
-            _nextAbandonedComponent = _actorList.size() - FF_COMPONENT_MAP_PAGE_SIZE;
-        }
+        // The new page is chained in front of any slots that are already free
+        _actorList.back() = _abandondedComponentCount > 0 ? _nextAbandonedComponent : FF_ACTOR_INVALID;
+        _nextAbandonedComponent = pageStart;
         _abandondedComponentCount += FF_COMPONENT_MAP_PAGE_SIZE;
     }
+    template<typename T>
+    void ComponentMap<T>::destroyComponent(const ActorID& actorID) {
+        const int index = _actorIndices[actorID];
+        getSlot(index)->~T();
+
+        // Abandoned components form a LIFO free list, so the slot is pushed onto the head
+        _actorList[index] = _abandondedComponentCount > 0 ? _nextAbandonedComponent : FF_ACTOR_INVALID;
+        _nextAbandonedComponent = index;
+        _abandondedComponentCount++;
+
+        _actorIndices[actorID] = FF_ACTOR_INVALID;
+    }
+    template<typename T>
+    T* ComponentMap<T>::getSlot(const size_t& index) const {
+        Page& page = *_componentListPages[index / FF_COMPONENT_MAP_PAGE_SIZE];
+        return std::launder(reinterpret_cast<T*>(page.data) + index % FF_COMPONENT_MAP_PAGE_SIZE);
+    }
 }
 
 #endif
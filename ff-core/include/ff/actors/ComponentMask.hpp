@@ -0,0 +1,148 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _FAITHFUL_FOUNTAIN_ACTORS_COMPONENT_MASK_HPP
+#define _FAITHFUL_FOUNTAIN_ACTORS_COMPONENT_MASK_HPP
+
+#include <ff/util/Hash.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// Configured with the FF_MAX_COMPONENTS CMake cache variable
+#ifndef FF_MAX_COMPONENTS
+#define FF_MAX_COMPONENTS 128
+#endif
+
+#define FF_COMPONENT_MASK_WORD_COUNT ((FF_MAX_COMPONENTS + 63) / 64)
+
+namespace ff {
+    /**
+     * Dense index of a component type, assigned in registration order.
+     */
+    using ComponentIndex = uint32_t;
+
+    /**
+     * Set of component types, one bit per ComponentIndex. Stored as a fixed
+     * array of 64-bit words so every operation is a short, branch-free loop the
+     * compiler can unroll and vectorize.
+     */
+    class ComponentMask final {
+    public:
+        constexpr ComponentMask()
+            :_words() {
+        }
+
+        static ComponentMask fromIndex(const ComponentIndex& index) {
+            ComponentMask mask;
+            mask.set(index);
+            return mask;
+        }
+
+        bool test(const ComponentIndex& index) const {
+            return (_words[index / 64] >> (index % 64)) & 1;
+        }
+        void set(const ComponentIndex& index) {
+            _words[index / 64] |= uint64_t(1) << (index % 64);
+        }
+        void reset(const ComponentIndex& index) {
+            _words[index / 64] &= ~(uint64_t(1) << (index % 64));
+        }
+
+        bool any() const {
+            uint64_t bits = 0;
+            for(size_t i = 0; i < FF_COMPONENT_MASK_WORD_COUNT; ++i) {
+                bits |= _words[i];
+            }
+            return bits != 0;
+        }
+        bool none() const {
+            return !any();
+        }
+        /**
+         * Calls `fn(index)` for every set bit, in increasing order.
+         */
+        template<typename Fn>
+        void eachIndex(const Fn& fn) const {
+            for(size_t i = 0; i < FF_COMPONENT_MASK_WORD_COUNT; ++i) {
+                uint64_t word = _words[i];
+                while(word != 0) {
+                    ComponentIndex bit = 0;
+                    while(((word >> bit) & 1) == 0) {
+                        ++bit;
+                    }
+                    fn((ComponentIndex)(i * 64) + bit);
+                    word &= word - 1;
+                }
+            }
+        }
+
+        const uint64_t& getWord(const size_t& i) const {
+            return _words[i];
+        }
+
+        ComponentMask& operator|=(const ComponentMask& rhs) {
+            for(size_t i = 0; i < FF_COMPONENT_MASK_WORD_COUNT; ++i) {
+                _words[i] |= rhs._words[i];
+            }
+            return *this;
+        }
+        ComponentMask& operator&=(const ComponentMask& rhs) {
+            for(size_t i = 0; i < FF_COMPONENT_MASK_WORD_COUNT; ++i) {
+                _words[i] &= rhs._words[i];
+            }
+            return *this;
+        }
+        ComponentMask operator|(const ComponentMask& rhs) const {
+            ComponentMask mask = *this;
+            mask |= rhs;
+            return mask;
+        }
+        ComponentMask operator&(const ComponentMask& rhs) const {
+            ComponentMask mask = *this;
+            mask &= rhs;
+            return mask;
+        }
+        ComponentMask operator~() const {
+            ComponentMask mask;
+            for(size_t i = 0; i < FF_COMPONENT_MASK_WORD_COUNT; ++i) {
+                mask._words[i] = ~_words[i];
+            }
+            return mask;
+        }
+        bool operator==(const ComponentMask& rhs) const {
+            uint64_t diff = 0;
+            for(size_t i = 0; i < FF_COMPONENT_MASK_WORD_COUNT; ++i) {
+                diff |= _words[i] ^ rhs._words[i];
+            }
+            return diff == 0;
+        }
+        bool operator!=(const ComponentMask& rhs) const {
+            return !(*this == rhs);
+        }
+
+    private:
+        uint64_t _words[FF_COMPONENT_MASK_WORD_COUNT];
+    };
+
+    constexpr ComponentMask FF_ACTOR_COMPONENT_MASK_EMPTY = ComponentMask();
+}
+
+namespace std {
+    template<>
+    struct hash<ff::ComponentMask> {
+        size_t operator()(const ff::ComponentMask& mask) const {
+            uint64_t seed = 0;
+            for(size_t i = 0; i < FF_COMPONENT_MASK_WORD_COUNT; ++i) {
+                ff::hash_combine_num(seed, mask.getWord(i));
+            }
+            return (size_t)seed;
+        }
+    };
+}
+
+#endif
@@ -10,7 +10,6 @@
 #include <ff/actors/Actor.hpp>
 #include <ff/actors/Component.hpp>
 #include <vector>
-#include <bitset>
 
 namespace ff {
     class ComponentMaskSet final {
@@ -21,15 +20,15 @@ namespace ff {
         void addEmptyActor();
         void addEmptyActors(const int& count);
 
-        void addComponent(const Actor_t& actor, const ComponentType& type);
-        void removeComponent(const Actor_t& actor, const ComponentType& type);
-        bool hasComponent(const Actor_t& actor, const ComponentType& type) const;
-        const ComponentType& getComponentMask(const Actor_t& actor) const;
+        void addComponent(const Actor_t& actor, const ComponentIndex& index);
+        void removeComponent(const Actor_t& actor, const ComponentIndex& index);
+        bool hasComponent(const Actor_t& actor, const ComponentIndex& index) const;
+        const ComponentMask& getComponentMask(const Actor_t& actor) const;
 
         void clearMask(Actor_t const& actor);
 
     private:
-        std::vector<ComponentType> _componentMasks;
+        std::vector<ComponentMask> _componentMasks;
     };
 }
 
@@ -26,7 +26,7 @@ namespace ff {
         virtual ~Family();
 
         bool matches(ActorManager* const& actorManager, const Actor_t& actor) const;
-        bool matches(const ComponentType& mask) const;
+        bool matches(const ComponentMask& mask) const;
 
         bool equals(const Family& other) const;
         bool operator==(const Family& rhs) const;
@@ -41,9 +41,9 @@ namespace ff {
     private:
         Family();
 
-        ComponentType _allMask;
-        ComponentType _oneMask;
-        ComponentType _excludeMask;
+        ComponentMask _allMask;
+        ComponentMask _oneMask;
+        ComponentMask _excludeMask;
     };
 
     class FamilyBuilder {
@@ -115,7 +115,7 @@ namespace ff {
         static_assert(conjunction<std::integral_constant<bool, std::is_base_of<_internal::IComponent, Components>::value>...>::value,
             "Component does not extend off of Component<T>.");
 
-        std::unordered_set<ComponentType> types = { Component<Components>::getType()... };
+        std::unordered_set<ComponentMask> types = { Component<Components>::getType()... };
         for(auto it = types.begin();
             it != types.end();
             it++) {
@@ -129,7 +129,7 @@ namespace ff {
         static_assert(conjunction<std::integral_constant<bool, std::is_base_of<_internal::IComponent, Components>::value>...>::value,
             "Component does not extend off of Component<T>.");
 
-        std::unordered_set<ComponentType> types = { Component<Components>::getType()... };
+        std::unordered_set<ComponentMask> types = { Component<Components>::getType()... };
 
         for(auto it = types.begin();
             it != types.end();
@@ -144,7 +144,7 @@ namespace ff {
         static_assert(conjunction<std::integral_constant<bool, std::is_base_of<_internal::IComponent, Components>::value>...>::value,
             "Component does not extend off of Component<T>.");
 
-        std::unordered_set<ComponentType> types = { Component<Components>::getType()... };
+        std::unordered_set<ComponentMask> types = { Component<Components>::getType()... };
 
         for(auto it = types.begin();
             it != types.end();
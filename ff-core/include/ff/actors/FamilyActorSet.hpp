@@ -11,9 +11,15 @@
 #include <ff/actors/Family.hpp>
 #include <ff/actors/IterableActorSet.hpp>
 #include <vector>
+#include <functional>
 #include <stdint.h>
 
 namespace ff {
+    /**
+     * Actors matching a family, kept packed in `_actors` with a sparse
+     * actor ID -> slot index, so adding, removing and membership tests are
+     * constant time and iteration never visits empty slots.
+     */
     class FamilyActorSet final {
     public:
         FamilyActorSet(ActorManager* const& actorManagerPtr,
@@ -27,15 +33,28 @@ namespace ff {
         void removeAllActors();
         bool hasActor(const Actor_t& actor) const;
 
+        void each(const std::function<void(Actor_t)>& iterFn);
+        size_t getPartitionCount() const;
+        void eachInPartitions(const size_t& begin, const size_t& end, const std::function<void(Actor_t)>& iterFn) const;
+        int count() const;
+
         const IterableActorSet& getActors() const;
 
     private:
         ActorManager* const _actorManagerPtr;
         Family _family;
         std::vector<Actor_t> _actors;
+        std::vector<uint32_t> _actorIndices;
         IterableActorSet _iterableActors;
-        uint32_t _nextOpenIndex;
-        uint32_t _emptySpots;
+
+        // Actors removed mid-iteration are nulled in place rather than swapped
+        // out, so the iteration doesn't skip or revisit anyone. They are
+        // compacted once the outermost iteration finishes.
+        uint32_t _iterationDepth;
+        uint32_t _pendingRemovalCount;
+
+        void swapRemove(const uint32_t& index);
+        void compact();
     };
 }
 
@@ -11,18 +11,28 @@
 
 #include <ff/actors/Actor.hpp>
 #include <vector>
+#include <cstddef>
 
 namespace ff {
     class ActorManager;
+    class FamilyActorSet;
 
     class IterableActorSet {
     public:
         IterableActorSet(ActorManager* const& actorManagerPtr,
             std::vector<Actor_t>* const& actorListPtr,
             uint32_t* const& deletedActorCount = nullptr);
+        IterableActorSet(FamilyActorSet* const& familyActorSetPtr);
         virtual ~IterableActorSet();
 
         void each(const std::function<void(Actor_t)>& iterFn) const;
+        /**
+         * For splitting iteration over threads (see `ff::parallelEach`): the set is
+         * `getPartitionCount()` slots, and any ranges of them may be visited with
+         * `eachInPartitions` concurrently.
+         */
+        size_t getPartitionCount() const;
+        void eachInPartitions(const size_t& begin, const size_t& end, const std::function<void(Actor_t)>& iterFn) const;
         bool contains(const Actor_t& actor) const;
         int count() const;
 
@@ -30,6 +40,7 @@ namespace ff {
         ActorManager* const _actorManagerPtr;
         std::vector<Actor_t>* _actors;
         uint32_t* _deletedActorCount;
+        FamilyActorSet* const _familyActorSetPtr;
     };
 }
 
@@ -15,9 +15,12 @@
 #include <vector>
 #include <array>
 #include <mutex>
+#include <atomic>
 
 #include <ff/audio/AudioSource.hpp>
 
+#include <ff/CVars.hpp>
+
 #include <ff/messages/EventListener.hpp>
 #include <ff/messages/CmdHandler.hpp>
 #include <ff/commands/audio/PlayAudioSourceCmd.hpp>
@@ -54,9 +57,27 @@ namespace ff {
         void onKill() override;
 
     private:
-        std::vector<std::shared_ptr<AudioSource>> _sources;
+        /**
+         * Who sends `AudioSourceInactiveEvent` for a source. The audio thread
+         * claims the event while posting it, and `onUpdate` sends it for any
+         * source that went inactive without a successful post.
+         */
+        enum class InactiveEventState {
+            NOT_SENT,
+            POSTING,
+            SENT
+        };
+        struct PlayingSource {
+            PlayingSource(std::shared_ptr<AudioSource> const& source);
+
+            std::shared_ptr<AudioSource> source;
+            std::atomic<InactiveEventState> inactiveEventState;
+        };
+
+        std::vector<std::shared_ptr<PlayingSource>> _sources;
         std::mutex _sourcesMutex;
         std::array<float, AUDIO_CORE_CALLBACK_WORKING_BUFFER> _workingBuffer;
+        CVarHandle<float> _masterVolumeCVar;
     };
 }
 
@@ -0,0 +1,99 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _FAITHFUL_FOUNTAIN_COLLISION_COLLISION_2D_BATCH_HPP
+#define _FAITHFUL_FOUNTAIN_COLLISION_COLLISION_2D_BATCH_HPP
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+
+namespace ff {
+    constexpr size_t FF_COLLISION_2D_BATCH_MASK_BITS = 32;
+
+    /**
+     * Tests one shape against many at a time, four per instruction with SSE2 or
+     * NEON (and one at a time elsewhere). Results are bit masks, with bit i of
+     * word i / 32 set if element i passed.
+     */
+    namespace Collision2DBatch {
+        inline size_t getMaskWordCount(const size_t& count) {
+            return (count + FF_COLLISION_2D_BATCH_MASK_BITS - 1) / FF_COLLISION_2D_BATCH_MASK_BITS;
+        }
+
+        /**
+         * Sets the bits of the boxes overlapping [min, max], touching edges included.
+         */
+        void overlapAABBs(const glm::vec2& min, const glm::vec2& max,
+            const float* const& minX, const float* const& minY, const float* const& maxX, const float* const& maxY, const size_t& count,
+            uint32_t* const& masks);
+        /**
+         * Sets the bits of the circles closer than the sum of the radii. Circles
+         * with a NaN radius never pass.
+         */
+        void overlapCircles(const glm::vec2& center, const float& radius,
+            const float* const& centerX, const float* const& centerY, const float* const& radii, const size_t& count,
+            uint32_t* const& masks);
+
+        /**
+         * Calls `fn(i)` for every set bit i, in increasing order.
+         */
+        template<typename Fn>
+        void forEachSetBit(const uint32_t* const& masks, const size_t& wordCount, Fn const& fn);
+    }
+
+    /**
+     * AABBs stored as one array per coordinate, for Collision2DBatch.
+     */
+    class Collision2DBounds final {
+    public:
+        void push_back(const glm::vec2& min, const glm::vec2& max);
+        void set(const size_t& index, const glm::vec2& min, const glm::vec2& max);
+        /**
+         * Moves the last AABB into `index`.
+         */
+        void swapRemove(const size_t& index);
+        void clear();
+        size_t size() const;
+
+        /**
+         * Tests `count` AABBs from `begin` against [min, max], with bit i of
+         * `masks` standing for AABB `begin + i`.
+         */
+        void overlap(const glm::vec2& min, const glm::vec2& max, const size_t& begin, const size_t& count, uint32_t* const& masks) const;
+
+    private:
+        std::vector<float> _minX;
+        std::vector<float> _minY;
+        std::vector<float> _maxX;
+        std::vector<float> _maxY;
+    };
+}
+
+namespace ff {
+    namespace Collision2DBatch {
+        template<typename Fn>
+        void forEachSetBit(const uint32_t* const& masks, const size_t& wordCount, Fn const& fn) {
+            for(size_t word = 0; word < wordCount; ++word) {
+                uint32_t bits = masks[word];
+                for(size_t bit = 0; bits != 0; ++bit, bits >>= 1) {
+                    // Skip runs of clear bits a nibble at a time
+                    while((bits & 0xF) == 0) {
+                        bits >>= 4;
+                        bit += 4;
+                    }
+                    if((bits & 1) != 0) {
+                        fn(word * FF_COLLISION_2D_BATCH_MASK_BITS + bit);
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif
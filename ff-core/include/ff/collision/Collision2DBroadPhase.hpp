@@ -0,0 +1,78 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _FAITHFUL_FOUNTAIN_COLLISION_COLLISION_2D_BROAD_PHASE_HPP
+#define _FAITHFUL_FOUNTAIN_COLLISION_COLLISION_2D_BROAD_PHASE_HPP
+
+#include <ff/actors/Actor.hpp>
+#include <ff/math/Rectangle.hpp>
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+
+namespace ff {
+    typedef uint32_t Collision2DProxy;
+
+    constexpr Collision2DProxy FF_COLLISION_2D_NULL_PROXY = 0xFFFFFFFF;
+
+    /**
+     * Spatial index of actor AABBs, used to find the colliders near a region
+     * without testing all of them.
+     *
+     * Queries are read-only and may run concurrently with each other, but not
+     * with creating, moving or destroying proxies.
+     */
+    class Collision2DBroadPhase {
+    public:
+        virtual ~Collision2DBroadPhase();
+
+        virtual Collision2DProxy createProxy(const Rectangle& aabb, const Actor_t& actor) = 0;
+        virtual void moveProxy(const Collision2DProxy& proxy, const Rectangle& aabb) = 0;
+        virtual void destroyProxy(const Collision2DProxy& proxy) = 0;
+        virtual void clear() = 0;
+
+        /**
+         * May be larger than the AABB the proxy was given.
+         */
+        virtual Rectangle getAABB(const Collision2DProxy& proxy) const = 0;
+        virtual const Actor_t& getActor(const Collision2DProxy& proxy) const = 0;
+        /**
+         * Every proxy is less than the capacity.
+         */
+        virtual size_t getProxyCapacity() const = 0;
+        virtual size_t getProxyCount() const = 0;
+
+        /**
+         * Appends the proxies whose AABB overlaps `aabb` to `proxies`, in increasing
+         * order and without duplicates.
+         */
+        virtual void query(const Rectangle& aabb, std::vector<Collision2DProxy>& proxies) const = 0;
+        /**
+         * Appends the proxies whose AABB the segment from `from` to `to` crosses to
+         * `proxies`, nearest to `from` first.
+         */
+        void queryRay(const glm::vec2& from, const glm::vec2& to, std::vector<Collision2DProxy>& proxies) const;
+
+    protected:
+        /**
+         * Returns true if the segment crosses the box, with `fraction` set to how
+         * far along the segment it enters (0 if `from` is inside the box).
+         */
+        static bool intersectsSegment(const glm::vec2& min, const glm::vec2& max,
+            const glm::vec2& from, const glm::vec2& to, float& fraction);
+
+        /**
+         * Appends the proxies whose AABB the segment crosses, in any order.
+         * The default queries the segment's AABB and tests each result.
+         */
+        virtual void queryRayCandidates(const glm::vec2& from, const glm::vec2& to, std::vector<Collision2DProxy>& proxies) const;
+    };
+}
+
+#endif
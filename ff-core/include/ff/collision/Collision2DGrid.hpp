@@ -0,0 +1,89 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _FAITHFUL_FOUNTAIN_COLLISION_COLLISION_2D_GRID_HPP
+#define _FAITHFUL_FOUNTAIN_COLLISION_COLLISION_2D_GRID_HPP
+
+#include <ff/collision/Collision2DBroadPhase.hpp>
+#include <ff/collision/Collision2DBatch.hpp>
+
+#include <glm/glm.hpp>
+
+#include <unordered_map>
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+
+namespace ff {
+    constexpr float FF_COLLISION_2D_GRID_DEFAULT_CELL_SIZE = 64.0f;
+    // Proxies covering more cells than this are kept in a single list that
+    // every query scans, rather than being inserted into each cell
+    constexpr int FF_COLLISION_2D_GRID_MAX_CELLS_PER_PROXY = 64;
+
+    /**
+     * Uniform grid of AABBs for the 2D broad phase. Each proxy is bucketed into
+     * every cell its AABB covers, so a query only visits the proxies near it.
+     * Moving a proxy only touches the cell lists when it crosses a cell edge.
+     *
+     * Each cell keeps its proxies' AABBs in Collision2DBounds, so a query tests
+     * several of them at a time.
+     */
+    class Collision2DGrid final : public Collision2DBroadPhase {
+    public:
+        Collision2DGrid(const float& cellSize = FF_COLLISION_2D_GRID_DEFAULT_CELL_SIZE);
+        virtual ~Collision2DGrid();
+
+        Collision2DProxy createProxy(const Rectangle& aabb, const Actor_t& actor) override;
+        void moveProxy(const Collision2DProxy& proxy, const Rectangle& aabb) override;
+        void destroyProxy(const Collision2DProxy& proxy) override;
+        void clear() override;
+
+        Rectangle getAABB(const Collision2DProxy& proxy) const override;
+        const Actor_t& getActor(const Collision2DProxy& proxy) const override;
+        size_t getProxyCapacity() const override;
+        size_t getProxyCount() const override;
+
+        void query(const Rectangle& aabb, std::vector<Collision2DProxy>& proxies) const override;
+
+        const float& getCellSize() const;
+        /**
+         * Re-buckets every proxy. Proxies keep their IDs.
+         */
+        void setCellSize(const float& cellSize);
+
+    private:
+        struct Cell {
+            std::vector<Collision2DProxy> proxies;
+            // In the same order as the proxies
+            Collision2DBounds bounds;
+        };
+        struct Proxy {
+            glm::vec2 min;
+            glm::vec2 max;
+            Actor_t actor;
+            glm::ivec2 cellMin;
+            glm::ivec2 cellMax;
+            bool oversized;
+        };
+
+        float _cellSize;
+        std::vector<Proxy> _proxies;
+        std::vector<Collision2DProxy> _freeProxies;
+        std::unordered_map<uint64_t, Cell> _cells;
+        Cell _oversizedCell;
+
+        void insertIntoCells(const Collision2DProxy& proxy);
+        void removeFromCells(const Collision2DProxy& proxy);
+        void computeCellRange(const glm::vec2& min, const glm::vec2& max, glm::ivec2& cellMin, glm::ivec2& cellMax) const;
+        bool isOversized(const glm::ivec2& cellMin, const glm::ivec2& cellMax) const;
+
+        static uint64_t getCellKey(const int& x, const int& y);
+        static size_t findProxy(const Cell& cell, const Collision2DProxy& proxy);
+        static void queryCell(const Cell& cell, const glm::vec2& min, const glm::vec2& max, std::vector<Collision2DProxy>& proxies);
+    };
+}
+
+#endif
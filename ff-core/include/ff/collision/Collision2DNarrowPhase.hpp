@@ -0,0 +1,57 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _FAITHFUL_FOUNTAIN_COLLISION_COLLISION_2D_NARROW_PHASE_HPP
+#define _FAITHFUL_FOUNTAIN_COLLISION_COLLISION_2D_NARROW_PHASE_HPP
+
+#include <ff/components/Collision2DComponent.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+
+namespace ff {
+    /**
+     * A shape transformed into world space, so that it can be tested against
+     * many others without being transformed (or allocated) again.
+     */
+    struct Collision2DWorldShape {
+        Collision2DShapeType type;
+        glm::vec2 min;
+        glm::vec2 max;
+        // Offset applied; the center for circles
+        glm::vec2 position;
+        // Circles only
+        float radius;
+        // Polygons only, counter-clockwise; normals[i] is the outward unit normal
+        // of the edge from vertices[i] to vertices[i + 1]
+        size_t vertexCount;
+        glm::vec2 vertices[FF_COLLISION_2D_MAX_POLYGON_VERTICES];
+        glm::vec2 normals[FF_COLLISION_2D_MAX_POLYGON_VERTICES];
+    };
+
+    namespace Collision2DNarrowPhase {
+        void computeWorldShape(const Collision2DShape& shape, const float& cos, const float& sin, const float& scale, const glm::vec2& position,
+            Collision2DWorldShape& worldShape);
+
+        /**
+         * Returns true if the shapes intersect, with each normal pointing from its
+         * shape towards the other. Doesn't allocate.
+         */
+        bool testShapes(const Collision2DWorldShape& shapeA, glm::vec2& normA,
+            const Collision2DWorldShape& shapeB, glm::vec2& normB, float& penetration);
+        /**
+         * Returns true if shapeA, moved by `displacement` without rotating, starts
+         * touching shapeB on the way, with `fraction` the part of the displacement
+         * done by then and normA pointing from shapeA towards shapeB. Shapes that
+         * overlap before moving are left to testShapes.
+         */
+        bool sweepShapes(const Collision2DWorldShape& shapeA, const glm::vec2& displacement,
+            const Collision2DWorldShape& shapeB, float& fraction, glm::vec2& normA);
+    }
+}
+
+#endif
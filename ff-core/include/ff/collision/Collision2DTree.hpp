@@ -0,0 +1,107 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _FAITHFUL_FOUNTAIN_COLLISION_COLLISION_2D_TREE_HPP
+#define _FAITHFUL_FOUNTAIN_COLLISION_COLLISION_2D_TREE_HPP
+
+#include <ff/collision/Collision2DBroadPhase.hpp>
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+
+namespace ff {
+    constexpr float FF_COLLISION_2D_TREE_DEFAULT_AABB_MARGIN = 4.0f;
+    // Balancing keeps the tree far shallower than this for any proxy count that fits in memory
+    constexpr int FF_COLLISION_2D_TREE_MAX_DEPTH = 64;
+
+    /**
+     * Dynamic AABB tree for the 2D broad phase. Each leaf stores its proxy's AABB
+     * grown by a margin, so moving a proxy within that fat AABB doesn't touch
+     * the tree, and one that leaves it is only removed and reinserted on its own.
+     *
+     * Unlike a grid, queries stay cheap however spread out or differently sized
+     * the proxies are, at the cost of a few more node visits for dense, uniform
+     * scenes. Inserting picks the sibling that grows the tree the least, and
+     * rotations keep it balanced.
+     */
+    class Collision2DTree final : public Collision2DBroadPhase {
+    public:
+        Collision2DTree(const float& aabbMargin = FF_COLLISION_2D_TREE_DEFAULT_AABB_MARGIN);
+        virtual ~Collision2DTree();
+
+        Collision2DProxy createProxy(const Rectangle& aabb, const Actor_t& actor) override;
+        /**
+         * Only updates the tree if `aabb` isn't inside the proxy's fat AABB.
+         */
+        void moveProxy(const Collision2DProxy& proxy, const Rectangle& aabb) override;
+        void destroyProxy(const Collision2DProxy& proxy) override;
+        void clear() override;
+
+        /**
+         * The AABB the proxy was last given; queries only return proxies it overlaps.
+         */
+        Rectangle getAABB(const Collision2DProxy& proxy) const override;
+        Rectangle getFatAABB(const Collision2DProxy& proxy) const;
+        const Actor_t& getActor(const Collision2DProxy& proxy) const override;
+        size_t getProxyCapacity() const override;
+        size_t getProxyCount() const override;
+
+        void query(const Rectangle& aabb, std::vector<Collision2DProxy>& proxies) const override;
+
+        const float& getAABBMargin() const;
+        /**
+         * Applies to proxies created or reinserted afterwards.
+         */
+        void setAABBMargin(const float& aabbMargin);
+        /**
+         * Edges from the root to the deepest leaf, or -1 when empty.
+         */
+        int getHeight() const;
+
+    protected:
+        void queryRayCandidates(const glm::vec2& from, const glm::vec2& to, std::vector<Collision2DProxy>& proxies) const override;
+
+    private:
+        struct Node {
+            // Fat AABB for leaves, and the union of the children for internal nodes
+            glm::vec2 min;
+            glm::vec2 max;
+            // Only set for leaves
+            glm::vec2 tightMin;
+            glm::vec2 tightMax;
+            Actor_t actor;
+            // Next free node for free nodes
+            Collision2DProxy parent;
+            Collision2DProxy child1;
+            Collision2DProxy child2;
+            // 0 for leaves, -1 for free nodes
+            int height;
+        };
+
+        float _aabbMargin;
+        std::vector<Node> _nodes;
+        Collision2DProxy _root;
+        Collision2DProxy _freeNodes;
+        size_t _proxyCount;
+
+        Collision2DProxy allocateNode();
+        void freeNode(const Collision2DProxy& node);
+        void insertLeaf(const Collision2DProxy& leaf);
+        void removeLeaf(const Collision2DProxy& leaf);
+        /**
+         * Rotates the taller grandchild up if the node's children differ in height
+         * by more than one, returning the node now in its place.
+         */
+        Collision2DProxy balance(const Collision2DProxy& node);
+        void refit(const Collision2DProxy& node);
+        bool isLeaf(const Collision2DProxy& node) const;
+    };
+}
+
+#endif
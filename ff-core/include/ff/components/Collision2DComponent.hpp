@@ -9,11 +9,11 @@
 
 #include <ff/actors/Component.hpp>
 #include <ff/actors/Actor.hpp>
-#include <unordered_set>
 #include <vector>
 #include <memory>
 #include <glm/glm.hpp>
 #include <ff/math/Rectangle.hpp>
+#include <ff/collision/Collision2DBroadPhase.hpp>
 
 namespace ff {
     typedef uint8_t CollisionGroup;
@@ -29,15 +29,28 @@ namespace ff {
 
     constexpr CollisionGroup COLLISION_GROUP_ALL = 0xFF;
 
+    // Lets the narrow phase keep polygons in fixed-size buffers
+    constexpr size_t FF_COLLISION_2D_MAX_POLYGON_VERTICES = 16;
+
+    enum class Collision2DShapeType : uint8_t {
+        CIRCLE,
+        POLYGON,
+        COUNT
+    };
+
     class Collision2DShape {
     friend struct Collision2DComponent;
 
     public:
-        Collision2DShape();
+        Collision2DShape(const Collision2DShapeType& type);
         virtual ~Collision2DShape();
 
         virtual Rectangle getAABB(const float& cos, const float& sin, const float& scale, const glm::vec2& position) = 0;
 
+        /**
+         * Which subclass this is, so the narrow phase can dispatch without casting.
+         */
+        const Collision2DShapeType& getType() const;
         const glm::vec2& getOffset() const;
         void setOffset(const glm::vec2& offset);
 
@@ -45,6 +58,7 @@ namespace ff {
         virtual Collision2DShape* createRawPtrCopy() = 0;
 
     private:
+        Collision2DShapeType _type;
         glm::vec2 _offset;
     };
 
@@ -70,6 +84,9 @@ namespace ff {
 
     class PolygonCollision2DShape : public Collision2DShape {
     public:
+        /**
+         * At most FF_COLLISION_2D_MAX_POLYGON_VERTICES vertices.
+         */
         PolygonCollision2DShape(const std::vector<glm::vec2>& vertices);
         ~PolygonCollision2DShape();
 
@@ -100,9 +117,15 @@ namespace ff {
         CollisionGroup group;
         CollisionGroup mask;
 
+        /**
+         * The number of colliders this one intersected on the last update.
+         */
         size_t getCollidingCount() const;
     private:
-        std::unordered_set<Actor_t> _currentlyCollidingWith;
+        // Kept up to date by Collision2DDetectionSystem, which tracks the pairs
+        size_t _collidingCount;
+        // Static and kinematic colliders only; see Collision2DDetectionSystem
+        Collision2DProxy _broadPhaseProxy;
     };
 }
 
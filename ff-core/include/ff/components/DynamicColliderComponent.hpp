@@ -12,6 +12,13 @@
 namespace ff {
     struct DynamicColliderComponent : public Component<DynamicColliderComponent>
     {
+        DynamicColliderComponent(const bool& continuous = false)
+            :continuous(continuous) {
+        }
+
+        // Also detect collisions along the path moved since the transform was
+        // last reset, so that fast colliders can't pass through thin ones
+        bool continuous;
     };
 }
 
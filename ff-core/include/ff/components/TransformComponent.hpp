@@ -44,6 +44,7 @@ namespace ff {
         void set2DRotation(const float& rotation, const bool& reset = false);
         void rotate2D(const float& angle);
         float get2DRotation() const;
+        float getLast2DRotation() const;
 
         void setRotation(const glm::vec3& eulerAngles, const bool& reset = false);
         void setRotation(const float& pitch, const float& yaw, const float& roll, const bool& reset = false);
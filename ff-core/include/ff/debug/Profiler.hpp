@@ -0,0 +1,113 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _FAITHFUL_FOUNTAIN_DEBUG_PROFILER_HPP
+#define _FAITHFUL_FOUNTAIN_DEBUG_PROFILER_HPP
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <typeinfo>
+
+#define FF_PROFILE_CONCAT_IMPL(a, b) a##b
+#define FF_PROFILE_CONCAT(a, b) FF_PROFILE_CONCAT_IMPL(a, b)
+
+/**
+ * Times the rest of the enclosing scope as a zone called `name`, which must be
+ * a string literal. Compiles to nothing unless built with FF_PROFILER.
+ */
+#ifdef FF_PROFILER
+#define FF_PROFILE_ZONE(name) ::ff::ProfileZone const FF_PROFILE_CONCAT(_ffProfileZone, __LINE__)(name "")
+#else
+#define FF_PROFILE_ZONE(name) do {} while(0)
+#endif
+
+namespace ff {
+    constexpr size_t FF_PROFILER_THREAD_BUFFER_SIZE = 16384; // Must be a power of 2
+
+    /**
+     * A zone's totals for one frame. Zones with the same name are only merged
+     * if they also have the same parent, on the same thread.
+     */
+    struct ProfileZoneStatistic {
+        char const* name;
+        // 0 for zones that weren't inside another
+        size_t depth;
+        // In the order threads first entered a zone
+        size_t thread;
+        size_t callCount;
+        double duration;
+    };
+
+    namespace _internal {
+        extern std::atomic<bool> profilerEnabled;
+    }
+
+    /**
+     * Each thread records the beginning and end of its zones into its own
+     * lock-free ring buffer, and `endFrame` turns them into a tree of zones
+     * per thread. Zones that don't fit in a thread's buffer are dropped.
+     */
+    namespace Profiler {
+        void setEnabled(const bool& enabled);
+        inline bool getEnabled() {
+            return _internal::profilerEnabled.load(std::memory_order_relaxed);
+        }
+
+        void beginZone(char const* const& name);
+        void endZone(char const* const& name);
+
+        /**
+         * Collects the zones every thread has ended since the last call. Call once
+         * a frame, from one thread, outside any zone. Zones still open (e.g. on
+         * other threads) are counted in the frame they end in.
+         */
+        void endFrame();
+        /**
+         * Zones of the last frame, depth first, each thread's after the last's.
+         */
+        const std::vector<ProfileZoneStatistic>& getLastFrame();
+        uint32_t getAndResetDroppedCount();
+
+        /**
+         * Readable name of `type`, for zones named after a type. Demangled once
+         * per type, and valid for the rest of the program. Thread-safe.
+         */
+        char const* getTypeName(const std::type_info& type);
+    }
+
+    /**
+     * Times its own lifetime as a zone called `name`, which must stay valid
+     * until the zone is collected (e.g. a literal or `Profiler::getTypeName`).
+     */
+    class ProfileZone final {
+    public:
+        explicit ProfileZone(char const* const& name);
+        ~ProfileZone();
+
+        ProfileZone(const ProfileZone&) = delete;
+        ProfileZone& operator=(const ProfileZone&) = delete;
+
+    private:
+        // Null if the profiler was disabled when the zone began
+        char const* _name;
+    };
+
+    inline ProfileZone::ProfileZone(char const* const& name)
+        :_name(Profiler::getEnabled() ? name : nullptr) {
+        if(_name != nullptr) {
+            Profiler::beginZone(_name);
+        }
+    }
+    inline ProfileZone::~ProfileZone() {
+        if(_name != nullptr) {
+            Profiler::endZone(_name);
+        }
+    }
+}
+
+#endif
@@ -22,7 +22,9 @@ namespace ff {
         bool measuring;
     };
     struct ListStatistic {
+        // Once full, a ring buffer with the oldest value at `oldest`
         std::vector<float> values;
+        size_t oldest;
         int maxSize;
     };
 
@@ -37,6 +37,7 @@ private:
     void consoleWindow();
     void cvarsWindow();
     void statisticsWindow();
+    void profilerWindow();
 };
 
 }
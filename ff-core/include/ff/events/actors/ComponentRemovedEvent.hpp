@@ -16,6 +16,10 @@
 
 namespace ff {
 
+/**
+ * When many actors lose `T` at once, this is only sent if it has listeners
+ * (other than wildcard ones); see ComponentsRemovedEvent.
+ */
 template<typename T>
 class ComponentRemovedEvent: public ff::Event {
 public:
@@ -0,0 +1,52 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _FAITHFUL_FOUNTAIN_EVENTS_ACTORS_COMPONENTS_REMOVED_EVENT_HPP
+#define _FAITHFUL_FOUNTAIN_EVENTS_ACTORS_COMPONENTS_REMOVED_EVENT_HPP
+
+#include <ff/messages/Event.hpp>
+
+#include <ff/actors/Actor.hpp>
+
+#include <tinyformat/tinyformat.h>
+#include <typeinfo>
+#include <cstddef>
+
+namespace ff {
+
+/**
+ * Sent when many actors lose a component at once (e.g.
+ * `ActorManager::destroyActors`). ComponentRemovedEvent is then only sent per
+ * actor if something listens for it by type or name. The components are still
+ * readable during dispatch; `actors` is only valid until it returns.
+ */
+template<typename T>
+class ComponentsRemovedEvent: public ff::Event {
+public:
+    ComponentsRemovedEvent(Actor_t const* const& actors, size_t const& count)
+        :actors(actors),
+        count(count) { }
+    ~ComponentsRemovedEvent() = default;
+
+    static char const* getEventName() {
+        static std::string name = tinyformat::format("evt_components_removed_%s", typeid(T).name()).c_str();
+        return name.c_str();
+    }
+
+    inline std::string getName() const override {
+        return getEventName();
+    };
+    inline std::string stringify() const override {
+        return tinyformat::format("%s from %s actors", typeid(T).name(), count);
+    };
+
+    Actor_t const* actors;
+    size_t count;
+};
+
+}
+
+#endif
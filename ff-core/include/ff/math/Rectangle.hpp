@@ -28,9 +28,9 @@ namespace ff {
 
         const glm::vec2 getPosition() const;
 
-        bool intersects(const Rectangle& other);
-        bool contains(const Rectangle& other);
-        bool contains(const glm::vec2& point);
+        bool intersects(const Rectangle& other) const;
+        bool contains(const Rectangle& other) const;
+        bool contains(const glm::vec2& point) const;
 
     private:
         glm::vec2 _bottomLeft;
@@ -0,0 +1,104 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _FAITHFUL_FOUNTAIN_MESSAGES_CONCURRENT_EVENT_QUEUE_HPP
+#define _FAITHFUL_FOUNTAIN_MESSAGES_CONCURRENT_EVENT_QUEUE_HPP
+
+#include <ff/messages/Event.hpp>
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace ff {
+
+class MessageBus;
+
+namespace _internal {
+    // Defined in MessageBus.hpp
+    template<typename T>
+    void enqueuePostedEvent(MessageBus& bus, T const& evt);
+}
+
+constexpr size_t CONCURRENT_EVENT_QUEUE_CAPACITY = 1024; // Must be a power of 2
+constexpr size_t CONCURRENT_EVENT_QUEUE_SLOT_SIZE = 96;
+
+/**
+ * Bounded, lock-free multi-producer/single-consumer queue of events. Any thread
+ * may post; only the thread that owns the MessageBus may drain. Events are
+ * constructed in place in fixed-size slots, so posting never allocates and
+ * never blocks (which makes it safe to use from real-time audio callbacks).
+ *
+ * Based on Dmitry Vyukov's bounded MPMC queue:
+ * https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ */
+class ConcurrentEventQueue final {
+public:
+    ConcurrentEventQueue();
+    ~ConcurrentEventQueue();
+
+    /**
+     * Returns false if the queue is full; the event is dropped.
+     */
+    template<typename T, typename... Args>
+    bool tryPost(Args... args);
+
+    /**
+     * Moves every posted event into `bus`'s queued events. Main thread only.
+     */
+    void drain(MessageBus& bus);
+
+    uint32_t getAndResetDroppedCount();
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        // Enqueues the event to `bus` (if not null) and destroys it
+        void (*deliver)(MessageBus* bus, void* evt);
+        alignas(std::max_align_t) unsigned char storage[CONCURRENT_EVENT_QUEUE_SLOT_SIZE];
+    };
+
+    std::unique_ptr<Slot[]> _slots;
+    std::atomic<size_t> _enqueuePos;
+    size_t _dequeuePos;
+    std::atomic<uint32_t> _droppedCount;
+
+    Slot* acquireSlot();
+    void implDrain(MessageBus* bus);
+};
+
+template<typename T, typename... Args>
+bool ConcurrentEventQueue::tryPost(Args... args) {
+    static_assert(std::is_base_of<Event, T>::value, "Only events can be posted.");
+    static_assert(sizeof(T) <= CONCURRENT_EVENT_QUEUE_SLOT_SIZE, "Event is too large to be posted; increase CONCURRENT_EVENT_QUEUE_SLOT_SIZE.");
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Event alignment is too large to be posted.");
+
+    Slot* slot = acquireSlot();
+    if(slot == nullptr) {
+        _droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    new (slot->storage) T(args...);
+    slot->deliver = [](MessageBus* bus, void* evt) {
+        T* tEvt = static_cast<T*>(evt);
+        if(bus != nullptr) {
+            _internal::enqueuePostedEvent<T>(*bus, *tEvt);
+        }
+        tEvt->~T();
+    };
+    // `acquireSlot` reserved position `sequence`; publishing `sequence + 1`
+    // hands the slot to the consumer.
+    slot->sequence.store(slot->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    return true;
+}
+
+}
+
+#endif
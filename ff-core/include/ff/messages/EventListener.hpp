@@ -10,7 +10,10 @@
 #include <ff/messages/Event.hpp>
 #include <ff/messages/MessageListenerPriority.hpp>
 
+#include <ff/util/Macros.hpp>
+
 #include <memory>
+#include <cstddef>
 
 namespace ff {
 
@@ -25,16 +28,27 @@ private:
     MessageBus* _bus;
     MessageListenerPriority_t _priority;
 
-    virtual bool implProcessEvent(std::shared_ptr<Event> const& evt) = 0;
+    virtual bool implProcessEvent(Event const& evt) = 0;
+    /**
+     * Processes a batch of queued events. `evts` points to the first event,
+     * and each following event is `stride` bytes after the previous one.
+     * By default each event is processed individually.
+     */
+    virtual void implProcessEvents(Event* const& evts, size_t const& stride, size_t const& count);
 };
 
+/**
+ * Listens to events by name. The event is only valid for the duration of
+ * `processEvent` (it may live on the dispatcher's stack or in a queue), so
+ * copy out whatever is needed rather than keeping a reference to it.
+ */
 class GenericEventListener : public IEventListener {
 friend class MessageBus;
 public:
-    virtual bool processEvent(std::shared_ptr<Event> const& evt) = 0;
+    virtual bool processEvent(Event const& evt) = 0;
 
 private:
-    bool implProcessEvent(std::shared_ptr<Event> const& evt) override;
+    bool implProcessEvent(Event const& evt) override;
 };
 
 template<typename T, typename std::enable_if<std::is_base_of<Event, T>::value>::type* En = nullptr>
@@ -42,15 +56,33 @@ class EventListener : public IEventListener {
 friend class MessageBus;
 public:
     virtual bool processEvent(T const& evt) = 0;
+    /**
+     * Processes a contiguous batch of queued events (see `MessageBus::enqueue`).
+     * Override to handle the whole batch at once; by default `processEvent` is
+     * called for each event. Queued events cannot be consumed.
+     */
+    virtual void processEvents(T const* const& evts, size_t const& count);
 
 private:
-    bool implProcessEvent(std::shared_ptr<Event> const& evt) override;
+    bool implProcessEvent(Event const& evt) override;
+    void implProcessEvents(Event* const& evts, size_t const& stride, size_t const& count) override;
 };
 
 template<typename T, typename std::enable_if<std::is_base_of<Event, T>::value>::type* En>
-bool EventListener<T, En>::implProcessEvent(std::shared_ptr<Event> const& evt) {
-    T* tEvt = static_cast<T*>(evt.get());
-    return processEvent(*tEvt);
+void EventListener<T, En>::processEvents(T const* const& evts, size_t const& count) {
+    for(size_t i = 0; i < count; i++) {
+        processEvent(evts[i]);
+    }
+}
+
+template<typename T, typename std::enable_if<std::is_base_of<Event, T>::value>::type* En>
+bool EventListener<T, En>::implProcessEvent(Event const& evt) {
+    return processEvent(static_cast<T const&>(evt));
+}
+template<typename T, typename std::enable_if<std::is_base_of<Event, T>::value>::type* En>
+void EventListener<T, En>::implProcessEvents(Event* const& evts, size_t const& stride, size_t const& count) {
+    FF_UNUSED(stride);
+    processEvents(static_cast<T const*>(evts), count);
 }
 
 }
@@ -0,0 +1,120 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _FAITHFUL_FOUNTAIN_MESSAGES_EVENT_QUEUE_HPP
+#define _FAITHFUL_FOUNTAIN_MESSAGES_EVENT_QUEUE_HPP
+
+#include <ff/messages/Event.hpp>
+
+#include <vector>
+#include <cstddef>
+
+namespace ff {
+
+class IEventListener;
+
+class IEventQueue {
+friend class MessageBus;
+public:
+    IEventQueue(char const* eventName, std::vector<IEventListener*>* listeners);
+    virtual ~IEventQueue() = default;
+
+    char const* getEventName() const;
+
+    virtual size_t getPendingCount() const = 0;
+
+private:
+    char const* _eventName;
+    std::vector<IEventListener*>* _listeners;
+
+    /**
+     * Swaps the pending events into the delivery buffer. Events enqueued during
+     * delivery go to the (now empty) pending buffer, so the delivery buffer
+     * never reallocates while listeners are reading from it.
+     */
+    virtual void swapBuffers() = 0;
+    virtual size_t getDeliveryCount() const = 0;
+    virtual Event* getDeliveryEvents() = 0;
+    virtual size_t getStride() const = 0;
+    virtual void clearDeliveryEvents() = 0;
+};
+
+/**
+ * Per-type contiguous storage for queued events. Events are double-buffered
+ * rather than kept in a single ring since the queue is drained completely on
+ * every flush, so a delivered batch is always a single contiguous span.
+ */
+template<typename T>
+class EventQueue : public IEventQueue {
+public:
+    EventQueue(std::vector<IEventListener*>* listeners);
+    ~EventQueue() = default;
+
+    template<typename... Args>
+    void enqueue(Args... args);
+
+    size_t getPendingCount() const override;
+
+private:
+    std::vector<T> _pending;
+    std::vector<T> _delivery;
+
+    void swapBuffers() override;
+    size_t getDeliveryCount() const override;
+    Event* getDeliveryEvents() override;
+    size_t getStride() const override;
+    void clearDeliveryEvents() override;
+};
+
+inline IEventQueue::IEventQueue(char const* eventName, std::vector<IEventListener*>* listeners)
+    :_eventName(eventName),
+    _listeners(listeners) {
+}
+inline char const* IEventQueue::getEventName() const {
+    return _eventName;
+}
+
+template<typename T>
+EventQueue<T>::EventQueue(std::vector<IEventListener*>* listeners)
+    :IEventQueue(T::getEventName(), listeners) {
+}
+
+template<typename T>
+template<typename... Args>
+void EventQueue<T>::enqueue(Args... args) {
+    _pending.emplace_back(args...);
+}
+
+template<typename T>
+size_t EventQueue<T>::getPendingCount() const {
+    return _pending.size();
+}
+
+template<typename T>
+void EventQueue<T>::swapBuffers() {
+    _delivery.swap(_pending);
+}
+template<typename T>
+size_t EventQueue<T>::getDeliveryCount() const {
+    return _delivery.size();
+}
+template<typename T>
+Event* EventQueue<T>::getDeliveryEvents() {
+    return _delivery.size() > 0 ? static_cast<Event*>(_delivery.data()) : nullptr;
+}
+template<typename T>
+size_t EventQueue<T>::getStride() const {
+    return sizeof(T);
+}
+template<typename T>
+void EventQueue<T>::clearDeliveryEvents() {
+    // Keeps capacity, so steady-state queueing doesn't allocate
+    _delivery.clear();
+}
+
+}
+
+#endif
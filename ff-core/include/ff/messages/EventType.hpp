@@ -0,0 +1,33 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _FAITHFUL_FOUNTAIN_MESSAGES_EVENT_TYPE_HPP
+#define _FAITHFUL_FOUNTAIN_MESSAGES_EVENT_TYPE_HPP
+
+#include <cstdint>
+#include <typeindex>
+
+namespace ff {
+
+typedef uint32_t EventTypeID_t;
+
+namespace _internal {
+    EventTypeID_t getEventTypeID(const std::type_index& type);
+}
+
+/**
+ * Returns a dense, per-type integer ID for event type `T`. IDs start at 0 and are
+ * assigned in the order types are first seen, so they can be used to index flat arrays.
+ */
+template<typename T>
+EventTypeID_t getEventTypeID() {
+    static EventTypeID_t const id = _internal::getEventTypeID(typeid(T));
+    return id;
+}
+
+}
+
+#endif
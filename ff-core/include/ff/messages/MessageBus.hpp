@@ -8,13 +8,17 @@
 #define _FAITHFUL_FOUNTAIN_MESSAGES_MESSAGE_BUS_HPP
 
 #include <ff/messages/Event.hpp>
+#include <ff/messages/EventType.hpp>
 #include <ff/messages/EventListener.hpp>
+#include <ff/messages/EventQueue.hpp>
+#include <ff/messages/ConcurrentEventQueue.hpp>
 #include <ff/messages/Cmd.hpp>
 #include <ff/messages/CmdHandler.hpp>
 #include <ff/messages/MessageListenerPriority.hpp>
 
 #include <ff/Console.hpp>
 #include <ff/CVars.hpp>
+#include <ff/debug/Profiler.hpp>
 #include <ff/io/Serializer.hpp>
 
 #include <vector>
@@ -39,6 +43,29 @@ public:
     void dispatch(Args... args);
     template<typename T, typename... Args, typename std::enable_if<std::is_base_of<Cmd<typename T::Ret>, T>::value>::type* En = nullptr>
     std::unique_ptr<typename T::Ret> dispatch(Serializer& serializer);
+
+    /**
+     * Queues an event to be delivered on the next `flush`, rather than immediately.
+     * Queued events of the same type are stored contiguously and delivered to
+     * listeners as a batch (see `EventListener::processEvents`). Queued events
+     * cannot be consumed.
+     */
+    template<typename T, typename... Args, typename std::enable_if<std::is_base_of<Event, T>::value>::type* En = nullptr>
+    void enqueue(Args... args);
+    /**
+     * Thread-safe, lock-free and allocation-free version of `enqueue`, for
+     * posting events from other threads (e.g. audio callbacks). Posted events
+     * are moved into the queued events at the start of the next `flush`.
+     * Returns false if the event was dropped because too many are pending.
+     */
+    template<typename T, typename... Args, typename std::enable_if<std::is_base_of<Event, T>::value>::type* En = nullptr>
+    bool post(Args... args);
+    /**
+     * Delivers all queued and posted events, grouped by type. Events enqueued
+     * while flushing are delivered on the following flush. `GameServicer` flushes
+     * at the end of every update tick.
+     */
+    void flush();
     template<typename T, typename... Args, typename std::enable_if<std::is_base_of<Cmd<typename T::Ret>, T>::value>::type* En = nullptr>
     std::unique_ptr<typename T::Ret> dispatch(Args... args);
 
@@ -53,6 +80,12 @@ public:
         MessageListenerPriority_t const& priority = MessageListenerPriority::DEFAULT);
     template<typename T, typename std::enable_if<std::is_base_of<Event, T>::value>::type* En = nullptr>
     void removeListener(EventListener<T>* const& listenerPtr);
+    /**
+     * Whether anything listens for `T` by type or by name. Wildcard listeners
+     * aren't counted.
+     */
+    template<typename T, typename std::enable_if<std::is_base_of<Event, T>::value>::type* En = nullptr>
+    bool hasListeners();
 
     template<typename T, typename std::enable_if<std::is_base_of<Cmd<typename T::Ret>, T>::value>::type* En = nullptr>
     void addHandler(CmdHandler<T, En>* const& handlerPtr);
@@ -65,7 +98,36 @@ private:
     std::unordered_map<std::string, std::vector<IEventListener*>> _eventListenersPendingRemove;
     std::vector<IEventListener*> _eventListenersPendingAllRemove;
     std::unordered_map<std::string, ICmdHandler*> _cmdHandlers;
-    bool _isProcessing;
+    // Indexed by EventTypeID_t. Points into _eventListeners (node-based, so
+    // the pointers stay valid) so typed dispatch skips the string lookup.
+    std::vector<std::vector<IEventListener*>*> _typedEventListeners;
+    std::vector<IEventListener*>* _wildcardEventListeners;
+    // Indexed by EventTypeID_t
+    std::vector<std::unique_ptr<IEventQueue>> _eventQueues;
+    ConcurrentEventQueue _postedEvents;
+    bool _isFlushing;
+    // Depth rather than a flag so that events dispatched from within a
+    // listener don't clean up the lists the outer dispatch is iterating.
+    uint32_t _processingDepth;
+
+#ifdef FF_MESSAGE_BUS_LOGGING
+    std::string _messageFilterSource;
+    std::regex _messageFilter;
+
+    bool shouldLogMessage(std::string const& name);
+#endif
+
+    template<typename T>
+    std::vector<IEventListener*>& getEventListeners();
+    bool processEventListeners(std::vector<IEventListener*>& listeners,
+        char const* eventName,
+        Event const& evt);
+    void processEventListenerBatch(std::vector<IEventListener*>& listeners,
+        char const* eventName,
+        Event* const& evts,
+        size_t const& stride,
+        size_t const& count);
+    bool isEventListenerPendingRemoval(char const* eventName, IEventListener* listener) const;
 
     void implRemoveIEventListener(IEventListener* listener);
     void implRemoveICmdHandler(ICmdHandler* handler);
@@ -77,54 +139,62 @@ private:
 namespace ff {
 template<typename T, typename... Args, typename std::enable_if<std::is_base_of<Event, T>::value>::type* En>
 void MessageBus::dispatch(Args... args) { // Event dispatch
-    auto evt = std::make_shared<T>(args...);
-
-    _isProcessing = true;
-
-    if(!std::regex_match(evt->getName(), std::regex(CVars::get<std::string>("message_filter")))) { // Exclusive
-        FF_CONSOLE_LOG("[%s] %s", evt->getName(), evt->stringify());
-    }
-
-    std::vector<IEventListener*>& wildcardListeners = _eventListeners[MESSAGE_WILDCARD];
-    std::vector<IEventListener*>& listenersPendingRemoval = _eventListenersPendingRemove[MESSAGE_WILDCARD];
-    for(int i = 0; i < wildcardListeners.size(); i++) {
-        if(std::find(_eventListenersPendingRemove[MESSAGE_WILDCARD].begin(),
-            _eventListenersPendingRemove[MESSAGE_WILDCARD].end(),
-            wildcardListeners[i])
-            != _eventListenersPendingRemove[MESSAGE_WILDCARD].end()) {
-            continue;
-        }
-        if (wildcardListeners[i]->implProcessEvent(evt)) {
-            return;
-        }
-    }
-    std::string const name = evt->getName();
-    std::vector<IEventListener*>& eventListeners = _eventListeners[name];
-    listenersPendingRemoval = _eventListenersPendingRemove[name];
-    for(int i = 0; i < eventListeners.size(); i++) {
-        if(std::find(listenersPendingRemoval.begin(),
-            listenersPendingRemoval.end(),
-            eventListeners[i])
-            != listenersPendingRemoval.end()) {
-            continue;
-        }
-        if(eventListeners[i]->implProcessEvent(evt)) {
-            return;
-        }
-    }
-
-    _isProcessing = false;
-
-    cleanupListenersAndHandlers();
+    FF_PROFILE_ZONE("MessageBus::dispatch");
+    T evt(args...);
+
+#ifdef FF_MESSAGE_BUS_LOGGING
+    if(shouldLogMessage(evt.getName())) {
+        FF_CONSOLE_LOG("[%s] %s", evt.getName(), evt.stringify());
+    }
+#endif
+
+    std::vector<IEventListener*>& eventListeners = getEventListeners<T>();
+
+    _processingDepth++;
+    if(!processEventListeners(*_wildcardEventListeners, MESSAGE_WILDCARD, evt)) {
+        processEventListeners(eventListeners, T::getEventName(), evt);
+    }
+    _processingDepth--;
+
+    if(_processingDepth == 0) {
+        cleanupListenersAndHandlers();
+    }
+}
+template<typename T, typename... Args, typename std::enable_if<std::is_base_of<Event, T>::value>::type* En>
+void MessageBus::enqueue(Args... args) {
+    EventTypeID_t const id = getEventTypeID<T>();
+    if(id >= _eventQueues.size()) {
+        _eventQueues.resize(id + 1);
+    }
+    if(_eventQueues[id] == nullptr) {
+        _eventQueues[id] = std::make_unique<EventQueue<T>>(&getEventListeners<T>());
+    }
+    static_cast<EventQueue<T>*>(_eventQueues[id].get())->enqueue(args...);
 }
+
+template<typename T, typename... Args, typename std::enable_if<std::is_base_of<Event, T>::value>::type* En>
+bool MessageBus::post(Args... args) {
+    return _postedEvents.tryPost<T>(args...);
+}
+
+namespace _internal {
+    template<typename T>
+    void enqueuePostedEvent(MessageBus& bus, T const& evt) {
+        bus.enqueue<T>(evt);
+    }
+}
+
 template<typename T, typename... Args, typename std::enable_if<std::is_base_of<Cmd<typename T::Ret>, T>::value>::type* En>
 std::unique_ptr<typename T::Ret> MessageBus::dispatch(Args... args) { // Cmd dispatch                                                                  //
+    FF_PROFILE_ZONE("MessageBus::dispatch");
     T cmd(args...);
 
     auto it = _cmdHandlers.find(cmd.getName());
-    if(!std::regex_match(cmd.getName(), std::regex(CVars::get<std::string>("message_filter")))) { // Exclusive
+#ifdef FF_MESSAGE_BUS_LOGGING
+    if(shouldLogMessage(cmd.getName())) {
         FF_CONSOLE_LOG("[%s] (%s) %s", cmd.getName(), it != _cmdHandlers.end() ? "ACK" : "NACK", cmd.stringify());
     }
+#endif
     if(it == _cmdHandlers.end()
         || it->second == nullptr) {
         return nullptr;
@@ -135,15 +205,18 @@ std::unique_ptr<typename T::Ret> MessageBus::dispatch(Args... args) { // Cmd dis
 }
 template<typename T, typename... Args, typename std::enable_if<std::is_base_of<Cmd<typename T::Ret>, T>::value>::type* En>
 std::unique_ptr<typename T::Ret> MessageBus::dispatch(Serializer& serializer) {
+    FF_PROFILE_ZONE("MessageBus::dispatch");
     FF_ASSERT(serializer.getDirection() == ff::SerializerDirection::READ,
         "Serializer direction must be READ.");
     T cmd;
     cmd.serialize(serializer);
 
     auto it = _cmdHandlers.find(cmd.getName());
-    if(!std::regex_match(cmd.getName(), std::regex(CVars::get<std::string>("message_filter")))) { // Exclusive
+#ifdef FF_MESSAGE_BUS_LOGGING
+    if(shouldLogMessage(cmd.getName())) {
         FF_CONSOLE_LOG("[%s] (%s) %s", cmd.getName(), it != _cmdHandlers.end() ? "ACK" : "NACK", cmd.stringify());
     }
+#endif
     if(it == _cmdHandlers.end()
         || it->second == nullptr) {
         return nullptr;
@@ -156,7 +229,7 @@ std::unique_ptr<typename T::Ret> MessageBus::dispatch(Serializer& serializer) {
 template<typename T, typename std::enable_if<std::is_base_of<Event, T>::value>::type* En>
 void MessageBus::addListener(EventListener<T>* const& listenerPtr,
     MessageListenerPriority_t const& priority) {
-    std::vector<IEventListener*>& eventListeners = _eventListeners[T::getEventName()];
+    std::vector<IEventListener*>& eventListeners = getEventListeners<T>();
     IEventListener* iListenerPtr = (IEventListener*)listenerPtr;
     if(std::find(eventListeners.begin(),
         eventListeners.end(),
@@ -166,7 +239,7 @@ void MessageBus::addListener(EventListener<T>* const& listenerPtr,
     }
     iListenerPtr->_priority = priority;
     
-    if(_isProcessing) {
+    if(_processingDepth > 0) {
         _eventListenersPendingAdd[T::getEventName()].push_back(iListenerPtr);
         return;
     }
@@ -181,10 +254,10 @@ void MessageBus::addListener(EventListener<T>* const& listenerPtr,
 }
 template<typename T, typename std::enable_if<std::is_base_of<Event, T>::value>::type* En>
 void MessageBus::removeListener(EventListener<T>* const& listenerPtr) {
-    std::vector<IEventListener*>& eventListeners = _eventListeners[T::getEventName()];
+    std::vector<IEventListener*>& eventListeners = getEventListeners<T>();
     IEventListener* iListenerPtr = (IEventListener*)listenerPtr;
 
-    if(_isProcessing) {
+    if(_processingDepth > 0) {
         _eventListenersPendingRemove[T::getEventName()].push_back(iListenerPtr);
         return;
     }
@@ -200,6 +273,23 @@ void MessageBus::removeListener(EventListener<T>* const& listenerPtr) {
     }
 }
 
+template<typename T, typename std::enable_if<std::is_base_of<Event, T>::value>::type* En>
+bool MessageBus::hasListeners() {
+    return !getEventListeners<T>().empty();
+}
+
+template<typename T>
+std::vector<IEventListener*>& MessageBus::getEventListeners() {
+    EventTypeID_t const id = getEventTypeID<T>();
+    if(id >= _typedEventListeners.size()) {
+        _typedEventListeners.resize(id + 1, nullptr);
+    }
+    if(_typedEventListeners[id] == nullptr) {
+        _typedEventListeners[id] = &_eventListeners[T::getEventName()];
+    }
+    return *_typedEventListeners[id];
+}
+
 template<typename T, typename std::enable_if<std::is_base_of<Cmd<typename T::Ret>, T>::value>::type* En>
 void MessageBus::addHandler(CmdHandler<T, En>* const& handlerPtr) {
     FF_ASSERT(_cmdHandlers.find(T::getCmdName()) == _cmdHandlers.end()
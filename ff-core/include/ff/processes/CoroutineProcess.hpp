@@ -0,0 +1,111 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _FAITHFUL_FOUNTAIN_PROCESSES_COROUTINE_PROCESS_HPP
+#define _FAITHFUL_FOUNTAIN_PROCESSES_COROUTINE_PROCESS_HPP
+
+#include <ff/processes/Process.hpp>
+
+#include <ff/messages/EventListener.hpp>
+
+#include <functional>
+#include <type_traits>
+
+/**
+ * Starts the body of `CoroutineProcess::onResume`.
+ */
+#define FF_COROUTINE_BEGIN() switch(_resumePoint) { case 0:
+/**
+ * Starts an await (`wait`, `waitForEvent`) and suspends until it finishes.
+ * Execution resumes after this line on a later update.
+ */
+#define FF_COROUTINE_AWAIT(awaitable) do { awaitable; _resumePoint = __LINE__; return; case __LINE__:; } while(0)
+/**
+ * Suspends until the next update.
+ */
+#define FF_COROUTINE_YIELD() do { _resumePoint = __LINE__; return; case __LINE__:; } while(0)
+/**
+ * Ends the body of `CoroutineProcess::onResume`, killing the process.
+ */
+#define FF_COROUTINE_END() } kill()
+
+namespace ff {
+    /**
+     * A process that runs a whole scripted sequence (waits, events, actions) as
+     * one object, instead of a chain of WaitProcess, WaitForEventProcess and
+     * DelegateProcess with one process per step:
+     *
+     *     void onResume() override {
+     *         FF_COROUTINE_BEGIN();
+     *         FF_COROUTINE_AWAIT(wait(0.5f));
+     *         spawnEnemies();
+     *         FF_COROUTINE_AWAIT(waitForEvent<CollisionStartEvent>());
+     *         FF_COROUTINE_END();
+     *     }
+     *
+     * C++17 has no coroutines, so `onResume` is re-entered from the start and
+     * switches to where it left off. Local variables don't survive an await or
+     * yield (keep state in members), and awaits can't be inside another switch.
+     */
+    class CoroutineProcess : public Process,
+        public GenericEventListener {
+    public:
+        CoroutineProcess(ProcessPriority_t const& priority = ProcessPriority::INHERITED);
+        virtual ~CoroutineProcess();
+
+        bool processEvent(const Event& evt) override;
+
+        bool getWaiting() const;
+
+    protected:
+        // Where onResume continues; 0 until the first await or yield
+        int _resumePoint;
+
+        /**
+         * Resumes the sequence, from an update once nothing is awaited.
+         */
+        virtual void onResume() = 0;
+
+        /**
+         * Awaits `duration` seconds of updates.
+         */
+        void wait(const float& duration);
+        /**
+         * Awaits an event of type T (enqueued, posted or dispatched) for which
+         * `filter` returns true, if given.
+         */
+        template<typename T, typename std::enable_if<std::is_base_of<Event, T>::value>::type* En = nullptr>
+        void waitForEvent(const std::function<bool(const T&)>& filter = nullptr);
+
+        void onKill() override;
+
+    private:
+        float _waitDuration;
+        char const* _awaitedEventName;
+        std::function<bool(const Event&)> _eventFilter;
+
+        void onUpdate(const float& dt) override;
+
+        void listenForEvent(char const* const& eventName);
+        void stopListening();
+    };
+}
+
+namespace ff {
+    template<typename T, typename std::enable_if<std::is_base_of<Event, T>::value>::type* En>
+    void CoroutineProcess::waitForEvent(const std::function<bool(const T&)>& filter) {
+        if(filter) {
+            _eventFilter = [filter](const Event& evt) {
+                return filter(static_cast<const T&>(evt));
+            };
+        } else {
+            _eventFilter = nullptr;
+        }
+        listenForEvent(T::getEventName());
+    }
+}
+
+#endif
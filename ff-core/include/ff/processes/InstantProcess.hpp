@@ -14,7 +14,9 @@ namespace ff {
     friend class ProcessManager;
 
     public:
-        InstantProcess(ProcessPriority_t const& priority = ProcessPriority::INHERITED):Process(priority) {}
+        InstantProcess(ProcessPriority_t const& priority = ProcessPriority::INHERITED):Process(priority) {
+            _instant = true;
+        }
         ~InstantProcess() {}
 
     protected:
@@ -0,0 +1,73 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _FAITHFUL_FOUNTAIN_PROCESSES_JOB_SYSTEM_HPP
+#define _FAITHFUL_FOUNTAIN_PROCESSES_JOB_SYSTEM_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ff {
+    constexpr size_t FF_PARALLEL_FOR_EACH_GRAIN_SIZE = 256;
+
+    /**
+     * Fixed pool of worker threads for fork/join parallelism. The calling thread
+     * always takes part in the work, so a JobSystem with no workers simply runs
+     * everything inline.
+     */
+    class JobSystem final {
+    public:
+        JobSystem(size_t const& workerCount = getDefaultWorkerCount());
+        ~JobSystem();
+        JobSystem(JobSystem const&) = delete;
+        JobSystem& operator=(JobSystem const&) = delete;
+
+        size_t getWorkerCount() const;
+
+        /**
+         * Calls `fn(begin, end)` for consecutive ranges covering [0, count), each
+         * at most `grainSize` long, and returns once all of them have finished.
+         *
+         * Calls made from inside a job, or while another thread is already running
+         * a parallelFor, run serially on the calling thread instead.
+         */
+        void parallelFor(size_t const& count, size_t const& grainSize, std::function<void(size_t, size_t)> const& fn);
+
+        static size_t getDefaultWorkerCount();
+        static bool isInJob();
+
+    private:
+        struct Job {
+            std::function<void(size_t, size_t)> const* fn;
+            size_t count;
+            size_t grainSize;
+            std::atomic<size_t> nextRange;
+            // Guarded by `_mutex`
+            size_t activeWorkers;
+            uint64_t id;
+        };
+
+        std::vector<std::thread> _workers;
+        std::mutex _mutex;
+        std::condition_variable _jobAvailable;
+        std::condition_variable _jobDone;
+        Job* _currentJob;
+        uint64_t _nextJobID;
+        bool _shuttingDown;
+        std::mutex _submitMutex;
+
+        void workerLoop();
+        static void runRanges(Job& job);
+    };
+}
+
+#endif
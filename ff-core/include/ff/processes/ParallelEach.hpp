@@ -0,0 +1,48 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _FAITHFUL_FOUNTAIN_PROCESSES_PARALLEL_EACH_HPP
+#define _FAITHFUL_FOUNTAIN_PROCESSES_PARALLEL_EACH_HPP
+
+#include <ff/processes/JobSystem.hpp>
+#include <ff/actors/ActorManager.hpp>
+#include <ff/actors/ActorView.hpp>
+#include <ff/actors/IterableActorSet.hpp>
+
+#include <functional>
+#include <cstddef>
+
+namespace ff {
+    /**
+     * Like `each`, but spread over the JobSystem in ranges of `grainSize` actors
+     * (or, with archetypes, a chunk at a time). `fn` is called concurrently, so
+     * actors must not be created or destroyed, nor gain or lose components,
+     * until it returns.
+     */
+    template<typename... Ts, typename Fn>
+    void parallelEach(ActorView<Ts...>& view, const Fn& fn, const size_t& grainSize = FF_PARALLEL_FOR_EACH_GRAIN_SIZE);
+    template<typename... Ts, typename Fn>
+    void parallelEach(ActorView<Ts...>&& view, const Fn& fn, const size_t& grainSize = FF_PARALLEL_FOR_EACH_GRAIN_SIZE);
+    void parallelEach(const IterableActorSet& actors, const std::function<void(Actor_t)>& iterFn, const size_t& grainSize = FF_PARALLEL_FOR_EACH_GRAIN_SIZE);
+}
+
+#include <ff/Locator.hpp>
+
+namespace ff {
+    template<typename... Ts, typename Fn>
+    void parallelEach(ActorView<Ts...>& view, const Fn& fn, const size_t& grainSize) {
+        size_t const partitionCount = view.getPartitionCount();
+        Locator::getJobSystem().parallelFor(partitionCount, view.getPartitionsAreChunks() ? 1 : grainSize, [&view, &fn](size_t begin, size_t end) {
+            view.eachInPartitions(begin, end, fn);
+        });
+    }
+    template<typename... Ts, typename Fn>
+    void parallelEach(ActorView<Ts...>&& view, const Fn& fn, const size_t& grainSize) {
+        parallelEach(view, fn, grainSize);
+    }
+}
+
+#endif
@@ -11,6 +11,7 @@
 #include <cstdint>
 
 #include <ff/processes/ProcessModifier.hpp>
+#include <ff/actors/Component.hpp>
 #include <set>
 
 #include <type_traits>
@@ -35,10 +36,17 @@ namespace ff {
     namespace ProcessFlags {
         constexpr int INITIALIZE_ON_ATTACH = 1 << 0;
         constexpr int REQUEST_NO_PAUSE = 1 << 1;
+        /**
+         * Updated in the ProcessManager's budgeted lane instead, which stops
+         * once its time budget for the tick is used up. Processes it didn't get
+         * to are updated first next tick, with the time they missed.
+         */
+        constexpr int BUDGETED = 1 << 2;
     }
 
     class Process : public std::enable_shared_from_this<Process> {
     friend class ProcessManager;
+    friend class InstantProcess;
 
     public:
         Process(ProcessPriority_t const& priority = ProcessPriority::INHERITED);
@@ -72,6 +80,17 @@ namespace ff {
         std::shared_ptr<Process> addFlags(const int& flag);
         bool hasFlag(const int& flag);
 
+        /**
+         * Processes that declare which components they read and write may be
+         * updated concurrently (on JobSystem workers) with other processes of the
+         * same priority whose accesses don't conflict. See
+         * `declareReads`/`declareWrites`.
+         */
+        bool getDeclaresComponentAccess() const;
+        const ComponentMask& getReadComponents() const;
+        const ComponentMask& getWriteComponents() const;
+        bool conflictsWith(const ComponentMask& reads, const ComponentMask& writes) const;
+
     protected:
         virtual void onInitialize();
         virtual void onPreUpdate();
@@ -82,10 +101,33 @@ namespace ff {
         virtual void onTogglePause();
 
         void setPriority(ProcessPriority_t const& priority);
+
+        /**
+         * False once the budgeted lane has used up its budget for the tick, so
+         * `onUpdate` can work in small steps until then. Always true for
+         * processes that aren't budgeted.
+         */
+        bool hasBudgetLeft() const;
+
+        /**
+         * Declaring component access opts the process in to concurrent updates.
+         * `onUpdate` may then run on a worker thread and must only touch the
+         * declared components. It must not dispatch events, nor create or
+         * destroy actors or add and remove components; anything else shared
+         * must be thread-safe, such as `MessageBus::post`. Storage for the
+         * declared components must be created in `onInitialize`, with
+         * `ActorManager::prepareComponentStorage`.
+         */
+        template<typename... Ts>
+        void declareReads();
+        template<typename... Ts>
+        void declareWrites();
     private:
         std::shared_ptr<Process> _pNext;
 
         bool _attached;
+        // Set by InstantProcess, so chains can be walked without casting
+        bool _instant;
         bool _initialized;
         bool _alive;
         bool _paused;
@@ -94,14 +136,38 @@ namespace ff {
         ProcessPriority_t _priority;
         int _flags;
 
+        // Budgeted processes only: time not yet passed to `update`, and when
+        // the lane's budget for this tick runs out (a timer_lib tick)
+        float _pendingDt;
+        uint64_t _budgetDeadline;
+
         std::set<std::unique_ptr<ProcessModifier>> _modifiers;
 
+        bool _declaresComponentAccess;
+        ComponentMask _readComponents;
+        ComponentMask _writeComponents;
+
         void initialize();
         void initializeModifiers();
         void updateModifiers(const float& dt);
         void killModifiers();
         void togglePauseModifiers();
     };
+
+    template<typename... Ts>
+    void Process::declareReads() {
+        _declaresComponentAccess = true;
+        for(ComponentMask const& type : { ComponentMask(), Component<Ts>::getType()... }) {
+            _readComponents |= type;
+        }
+    }
+    template<typename... Ts>
+    void Process::declareWrites() {
+        _declaresComponentAccess = true;
+        for(ComponentMask const& type : { ComponentMask(), Component<Ts>::getType()... }) {
+            _writeComponents |= type;
+        }
+    }
 }
 
 #endif
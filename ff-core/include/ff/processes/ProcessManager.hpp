@@ -8,16 +8,31 @@
 #define _FAITHFUL_FOUNTAIN_PROCESSES_PROCESS_MANAGER_HPP
 
 #include <ff/processes/Process.hpp>
+#include <ff/processes/ProcessPool.hpp>
 #include <memory>
 #include <vector>
 
 namespace ff {
+    /**
+     * Processes are kept in one list in descending priority, each priority's
+     * processes together in attachment order. Processes attached during a tick
+     * are merged in all at once after it, and dead ones removed in one pass.
+     *
+     * Processes with `ProcessFlags::BUDGETED` are kept apart, in the order they
+     * were attached, and updated after the rest. Each tick carries on from the
+     * first process the last one didn't get to, and updates each process at
+     * most once, stopping when the budget (see `setBudget`) is used up. At
+     * least one process is updated every tick, so the lane can't stall.
+     */
     class ProcessManager final {
     public:
         ProcessManager();
         virtual ~ProcessManager();
 
         std::shared_ptr<Process> attachProcess(const std::shared_ptr<Process>& process, const int& flags = 0);
+        /**
+         * Creates the process with makeProcess, so from ProcessPool.
+         */
         template<typename P, typename... Args>
         std::shared_ptr<P> attachProcess(Args... args);
 
@@ -26,17 +41,47 @@ namespace ff {
         void togglePauseAll();
 
         const std::vector<std::shared_ptr<Process>>& getProcesses() const;
+        const std::vector<std::shared_ptr<Process>>& getBudgetedProcesses() const;
+
+        /**
+         * Time the budgeted lane may take each tick, in seconds.
+         */
+        void setBudget(const float& budget);
+        const float& getBudget() const;
+        /**
+         * How far the budgeted lane is behind after the last tick: the number of
+         * processes it didn't get to, and the most time any of them is owed.
+         */
+        const size_t& getBudgetedBehindCount() const;
+        const float& getBudgetedLag() const;
 
     protected:
         std::vector<std::shared_ptr<Process>> _processes;
     private:
         std::vector<std::shared_ptr<Process>> _pendingProcesses;
+        // Reused between ticks to avoid reallocating
+        std::vector<std::shared_ptr<Process>> _deadProcesses;
         bool _isTicking;
+
+        std::vector<std::shared_ptr<Process>> _budgetedProcesses;
+        // The budgeted process to update first next tick
+        size_t _budgetedCursor;
+        float _budget;
+        size_t _budgetedBehindCount;
+        float _budgetedLag;
+
+        /**
+         * Returns false if the process is already attached.
+         */
+        bool prepareProcess(const std::shared_ptr<Process>& process);
+        void attachPendingProcesses();
+        void tickBudgeted(const float& dt);
+        size_t getConcurrentBatchEnd(const size_t& begin) const;
     };
 
     template<typename P, typename... Args>
     std::shared_ptr<P> ProcessManager::attachProcess(Args... args) {
-        return std::static_pointer_cast<P>(attachProcess(std::make_shared<P>(args...)));
+        return std::static_pointer_cast<P>(attachProcess(makeProcess<P>(args...)));
     }
 }
 
@@ -0,0 +1,81 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef _FAITHFUL_FOUNTAIN_PROCESSES_PROCESS_POOL_HPP
+#define _FAITHFUL_FOUNTAIN_PROCESSES_PROCESS_POOL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace ff {
+    constexpr size_t FF_PROCESS_POOL_BLOCK_GRANULARITY = 64;
+    constexpr size_t FF_PROCESS_POOL_MAX_BLOCK_SIZE = 1024;
+    constexpr size_t FF_PROCESS_POOL_BLOCKS_PER_CHUNK = 32;
+
+    /**
+     * Blocks for processes in sizes of multiples of 64 bytes, up to 1024. Freed
+     * blocks go back on a free list for their size rather than to the heap, so
+     * short-lived processes (waits, delegates, animations) are cheap to spawn.
+     * Larger sizes use operator new. Thread-safe.
+     */
+    namespace ProcessPool {
+        void* allocate(const size_t& size);
+        void deallocate(void* const& ptr, const size_t& size);
+
+        /**
+         * Blocks of `size`'s class on its free list.
+         */
+        size_t getFreeBlockCount(const size_t& size);
+    }
+
+    /**
+     * Allocates from ProcessPool, for std::allocate_shared.
+     */
+    template<typename T>
+    class ProcessAllocator final {
+    public:
+        typedef T value_type;
+
+        ProcessAllocator() noexcept {}
+        template<typename U>
+        ProcessAllocator(const ProcessAllocator<U>& other) noexcept {}
+
+        T* allocate(const size_t& count);
+        void deallocate(T* const& ptr, const size_t& count);
+
+        template<typename U>
+        bool operator==(const ProcessAllocator<U>& other) const noexcept { return true; }
+        template<typename U>
+        bool operator!=(const ProcessAllocator<U>& other) const noexcept { return false; }
+    };
+
+    /**
+     * Like std::make_shared, but the process and its reference counts share one
+     * pooled block.
+     */
+    template<typename P, typename... Args>
+    std::shared_ptr<P> makeProcess(Args&&... args);
+}
+
+namespace ff {
+    template<typename T>
+    T* ProcessAllocator<T>::allocate(const size_t& count) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Pooled processes can't be over-aligned.");
+        return static_cast<T*>(ProcessPool::allocate(count * sizeof(T)));
+    }
+    template<typename T>
+    void ProcessAllocator<T>::deallocate(T* const& ptr, const size_t& count) {
+        ProcessPool::deallocate(ptr, count * sizeof(T));
+    }
+
+    template<typename P, typename... Args>
+    std::shared_ptr<P> makeProcess(Args&&... args) {
+        return std::allocate_shared<P>(ProcessAllocator<P>(), std::forward<Args>(args)...);
+    }
+}
+
+#endif
@@ -25,7 +25,7 @@ namespace ff {
         WaitForEventProcess(const std::vector<std::string>& messageNames, const bool& registerOnInitialize = true);
         ~WaitForEventProcess();
 
-        bool processEvent(const std::shared_ptr<ff::Event>& message) override;
+        bool processEvent(const ff::Event& message) override;
 
     private:
         std::vector<std::string> _messageNames;
@@ -28,7 +28,7 @@ namespace ff {
 
         const Timer& getTimer() const;
 
-        bool processEvent(const std::shared_ptr<ff::Event>& evt) override;
+        bool processEvent(const ff::Event& evt) override;
 
     private:
         Timer _timer;
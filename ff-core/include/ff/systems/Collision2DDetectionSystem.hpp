@@ -11,30 +11,193 @@
 #include <ff/processes/Process.hpp>
 #include <glm/glm.hpp>
 #include <ff/components/Collision2DComponent.hpp>
+#include <ff/components/TransformComponent.hpp>
+#include <ff/collision/Collision2DBatch.hpp>
+#include <ff/collision/Collision2DBroadPhase.hpp>
+#include <ff/collision/Collision2DGrid.hpp>
+#include <ff/collision/Collision2DNarrowPhase.hpp>
+
+#include <memory>
+#include <vector>
 
 namespace ff {
+    /**
+     * Tests dynamic colliders against static and kinematic colliders, enqueueing
+     * CollisionStartEvent/CollisionEndEvent as pairs start and stop intersecting.
+     *
+     * Static and kinematic colliders are kept in a broad phase between updates
+     * (a uniform grid unless another is set), and are only moved in it when
+     * their transform changes (or their shape count does; other shape changes
+     * are picked up the next time they move). Each dynamic collider is only
+     * tested against the colliders the broad phase finds near its AABB.
+     *
+     * Shapes are transformed into world space once per update for dynamic
+     * colliders, and whenever they move for static and kinematic ones, so
+     * testing shape pairs doesn't allocate or recompute them. A dynamic
+     * collider's candidate shapes are gathered into coordinate arrays, so that
+     * each of its shapes is tested against several of them at a time before
+     * the exact test.
+     *
+     * Broad phase queries run in parallel per dynamic collider, then the pairs
+     * they find are tested in parallel in fixed-size ranges, so that one
+     * collider in a crowd doesn't hold up a whole update. Results are sorted by
+     * actor pair before events are enqueued, so the event order doesn't depend
+     * on thread timing, storage order or which broad phase is used.
+     *
+     * The intersecting pairs of each update are kept as a sorted contact list,
+     * and merged against the previous update's to find the pairs that started
+     * and stopped intersecting. Contacts with a destroyed actor end without a
+     * CollisionEndEvent.
+     *
+     * Continuous dynamic colliders that moved since their transform was last
+     * reset are also swept from their last position to the current one (keeping
+     * their last rotation), and any pair they met on the way intersects for this
+     * update, even if it doesn't at the current position.
+     */
     class Collision2DDetectionSystem final : public Process {
     public:
-        Collision2DDetectionSystem(ActorManager* const& actorManagerPtr, ProcessPriority_t const& priority = ff::ProcessPriority::DEFAULT);
+        Collision2DDetectionSystem(ActorManager* const& actorManagerPtr, ProcessPriority_t const& priority = ff::ProcessPriority::DEFAULT,
+            float const& gridCellSize = FF_COLLISION_2D_GRID_DEFAULT_CELL_SIZE);
         virtual ~Collision2DDetectionSystem();
 
+        /**
+         * Replaces the static broad phase with a grid of this cell size, which
+         * should be around the size of a typical static collider, e.g. a tile.
+         */
+        void setGridCellSize(float const& gridCellSize);
+        /**
+         * Static and kinematic colliders are moved into the new broad phase on the
+         * next update. A Collision2DTree suits sparse scenes or widely varying
+         * collider sizes better than a grid.
+         */
+        void setStaticBroadPhase(std::unique_ptr<Collision2DBroadPhase> broadPhase);
+        const Collision2DBroadPhase& getStaticBroadPhase() const;
+
+        /**
+         * Appends the static and kinematic colliders whose AABB overlaps `aabb`,
+         * as of the last update, to `actors`.
+         */
+        void queryAABB(const Rectangle& aabb, std::vector<Actor_t>& actors) const;
+        /**
+         * Appends the static and kinematic colliders whose AABB the segment from
+         * `from` to `to` crosses, as of the last update, to `actors`, nearest first.
+         */
+        void queryRay(const glm::vec2& from, const glm::vec2& to, std::vector<Actor_t>& actors) const;
+
     protected:
         void onUpdate(const float& dt) override;
 
     private:
+        struct ColliderRef {
+            Actor_t actor;
+            TransformComponent* transformCompPtr;
+            Collision2DComponent* collisionCompPtr;
+            // Whether the actor is also a dynamic collider (for static and kinematic
+            // colliders) or also a static or kinematic one (for dynamic colliders)
+            bool inBothSets;
+        };
+        struct DynamicCollider {
+            ColliderRef ref;
+            // Into _dynamicWorldShapes and _dynamicLastWorldShapes
+            size_t worldShapesBegin;
+            // Continuous and moved since the last reset
+            bool swept;
+            glm::vec2 displacement;
+        };
+        struct StaticCollider {
+            ColliderRef ref;
+            std::vector<Collision2DWorldShape> worldShapes;
+            // Transform when the broad phase was last updated, to detect movement
+            glm::vec3 position;
+            glm::quat rotation;
+            float scale;
+            size_t shapeCount;
+            uint64_t lastSeenUpdate;
+        };
+        // The shapes of one dynamic collider's candidates, laid out for Collision2DBatch
+        struct CandidateShapes {
+            Collision2DBounds bounds;
+            // NaN radius for shapes that aren't circles
+            std::vector<float> centerX;
+            std::vector<float> centerY;
+            std::vector<float> radii;
+            std::vector<Collision2DWorldShape const*> shapes;
+            // Index of the pair test each shape belongs to
+            std::vector<uint32_t> pairTests;
+            std::vector<uint32_t> circleMasks;
+            std::vector<uint32_t> overlapMasks;
+            std::vector<uint32_t> circleOverlapMasks;
+            // Earliest sweep hit of each pair test
+            std::vector<float> sweepFractions;
+            std::vector<glm::vec2> sweepNormals;
+        };
+        struct PairTest {
+            // Index into _dynamicColliders
+            uint32_t colliderA;
+            // Proxy of the static or kinematic collider
+            Collision2DProxy colliderB;
+            Actor_t actorA;
+            Actor_t actorB;
+            bool intersecting;
+            glm::vec2 normA;
+            glm::vec2 normB;
+            float penetration;
+        };
+        struct Contact {
+            // As in the CollisionStartEvent
+            Actor_t actorA;
+            Actor_t actorB;
+        };
+
         ActorManager* const _actorManagerPtr;
 
-        bool checkShapeIntersection(const glm::vec2& posA, const float& cosA, const float& sinA, const float& scaleA, const Collision2DShape& shapeA, glm::vec2& normA,
-            const glm::vec2& posB, const float& cosB, const float& sinB, const float& scaleB, const Collision2DShape& shapeB, glm::vec2& normB, float& penetration);
-        bool checkCircleCircleIntersection(const glm::vec2& posA, const CircleCollision2DShape& circleA, const float& scaleA, glm::vec2& normA,
-            const glm::vec2& posB, const CircleCollision2DShape& circleB, const float& scaleB, glm::vec2& normB, float& penetration);
-        bool checkPolygonCircleIntersection(const glm::vec2& posA, const float& cosA, const float& sinA, const float& scaleA, const PolygonCollision2DShape& polygonA, glm::vec2& normA,
-            const glm::vec2& posB, const CircleCollision2DShape& circleB, const float& scaleB, glm::vec2& normBm, float& penetration);
-        bool checkPolygonPolygonIntersection(const glm::vec2& posA, const float& cosA, const float& sinA, const float& scaleA, const PolygonCollision2DShape& polygonA, glm::vec2& normA,
-            const glm::vec2& posB, const float& cosB, const float& sinB, const float& scaleB, const PolygonCollision2DShape& polygonB, glm::vec2& normB, float& penetration);
-
-        glm::vec2 computeSupport(const std::vector<glm::vec2>& verts, const glm::vec2& dir);
-        float findAxisOfLeastPenetration(size_t& faceIndex, const std::vector<glm::vec2>& vertsA, const std::vector<glm::vec2>& vertsB);
+        std::unique_ptr<Collision2DBroadPhase> _staticBroadPhase;
+        // Indexed by broad phase proxy
+        std::vector<StaticCollider> _staticColliders;
+        uint64_t _updateCount;
+
+        // Reused between updates to avoid reallocating
+        std::vector<DynamicCollider> _dynamicColliders;
+        std::vector<Collision2DWorldShape> _dynamicWorldShapes;
+        // Swept colliders only, at their last position and rotation
+        std::vector<Collision2DWorldShape> _dynamicLastWorldShapes;
+        // Filled for a static or kinematic collider that moved, then swapped into it
+        std::vector<Collision2DWorldShape> _movedWorldShapes;
+        // One list per dynamic collider, filled in parallel
+        std::vector<std::vector<Collision2DProxy>> _candidates;
+        // Every candidate pair, grouped by dynamic collider
+        std::vector<PairTest> _pairTests;
+        // Intersecting pairs, sorted by compareActorPairs; swapped each update
+        std::vector<Contact> _contacts;
+        std::vector<Contact> _previousContacts;
+
+        void updateStaticBroadPhase();
+        /**
+         * Fills `candidates` with the proxies of the colliders that colliderA
+         * should be tested against.
+         */
+        void findCandidates(const DynamicCollider& colliderA, std::vector<Collision2DProxy>& candidates);
+        /**
+         * Tests _pairTests[begin, end), which must all have the same colliderA.
+         */
+        void testPairs(const size_t& begin, const size_t& end, CandidateShapes& candidateShapes);
+        /**
+         * Sweeps the swept colliderA of _pairTests[begin, end) against the
+         * candidate shapes testPairs gathered.
+         */
+        void sweepPairs(const size_t& begin, const size_t& end, CandidateShapes& candidateShapes);
+        void startContact(const PairTest& pairTest);
+        void endContact(const Contact& contact);
+        void decrementCollidingCount(const Actor_t& actor);
+
+        static void computeWorldShapes(const Collision2DComponent& collisionComp, const float& rotation, const float& scale, const glm::vec2& position,
+            Collision2DWorldShape* const& worldShapes);
+        /**
+         * Orders pairs by their lower actor, then their higher one, so that a pair
+         * keeps its place whichever side tested it.
+         */
+        static bool compareActorPairs(const Actor_t& actorA1, const Actor_t& actorB1, const Actor_t& actorA2, const Actor_t& actorB2);
+        static Rectangle computeAABB(const TransformComponent& transformComp, const Collision2DWorldShape* const& worldShapes, const size_t& shapeCount);
     };
 }
 
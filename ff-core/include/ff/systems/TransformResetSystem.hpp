@@ -16,6 +16,7 @@ namespace ff {
         ~TransformResetSystem() = default;
 
     protected:
+        void onInitialize() override;
         void onUpdate(const float& dt) override;
 
     private:
@@ -7,6 +7,8 @@
 #ifndef _FAITHFUL_FOUNTAIN_UTIL_HASH_HPP
 #define _FAITHFUL_FOUNTAIN_UTIL_HASH_HPP
 
+#include <cstdint>
+#include <functional>
 #include <utility>
 
 namespace ff {
@@ -25,6 +25,7 @@ FF_CVAR_DEFINE(debug_show_console, bool, false, ff::CVarFlags::NONE, "Displa/hid
 FF_CVAR_DEFINE(debug_show_cvars, bool, false, ff::CVarFlags::NONE, "Display/hide statistics window.")
 FF_CVAR_DEFINE(debug_show_playback, bool, false, ff::CVarFlags::NONE, "Display/hide statistics window.")
 FF_CVAR_DEFINE(debug_show_statistics, bool, false, ff::CVarFlags::NONE, "Display/hide statistics window.")
+FF_CVAR_DEFINE(debug_show_profiler, bool, false, ff::CVarFlags::NONE, "Display/hide profiler window.")
 FF_CVAR_DEFINE(debug_show_render_pipeline, bool, true, ff::CVarFlags::NONE, "Display/hide render pipeline window.")
 
 FF_CVAR_DEFINE(debug_cam_speed, float, 10.0f, ff::CVarFlags::DEV_PRESERVE, "Speed of debug camera movement.")
@@ -33,6 +34,7 @@ FF_CVAR_DEFINE(debug_cam_sensitivity, float, 100.0f, ff::CVarFlags::DEV_PRESERVE
 FF_CVAR_DEFINE(asset_bundle_path, std::string, "./Assets", ff::CVarFlags::PRESERVE, "Path to the asset bundle (directory built using Asset Processor).")
 
 FF_CVAR_DEFINE(tick_frequency, float, 60, ff::CVarFlags::DEV_PRESERVE, "Frequency at which to tick game logic internally.")
+FF_CVAR_DEFINE(process_budget_ms, float, 2, ff::CVarFlags::DEV_PRESERVE, "Time budgeted processes may take each tick, in milliseconds.")
 FF_CVAR_DEFINE(acculmulator_max_before_reset, float, 2, ff::CVarFlags::DEV_PRESERVE, "Maximum value the acculmulator can contain before resetting to 0.")
 
 FF_CVAR_DEFINE(message_filter, std::string, "evt_keyboard[A-z_]+|evt_mouse[A-z_]+|evt_gamepad[A-z_]+|evt_motion[A-z_]+|evt_imgui[A-z_]+|evt_env_text[A-z_]+|cmd_env_request_cursor[A-z_]+|cmd_render[A-z_]+", ff::CVarFlags::PRESERVE, "Regex filter for events and commands on the developer console (exclusive).")
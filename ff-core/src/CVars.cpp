@@ -88,7 +88,7 @@ namespace ff {
 
     //region CVar Definition
     ICVar::ICVar(const std::string& name, const CVarFlags& flags, const std::string& description)
-        :_name(name),_flags(flags),_description(description),_initialized(false) {
+        :_name(name),_flags(flags),_description(description),_initialized(false),_version(0) {
     }
     ICVar::~ICVar() {
     }
@@ -110,6 +110,13 @@ namespace ff {
         _initialized = initialized;
     }
 
+    const uint32_t& ICVar::getVersion() const {
+        return _version;
+    }
+    void ICVar::notifyModified() {
+        _version++;
+    }
+
     template<>
     bool CVar<float>::matchesDefault() {
         return glm::abs(_val - _defaultVal) <= 1 / glm::pow(10.0f, INI_FILE_FLOAT_PRECISION);
@@ -130,85 +137,109 @@ namespace ff {
 
     template<>
     void CVar<bool>::drawImGuiEdit() {
-        ImGui::Checkbox("##editv", &_val);
+        if(ImGui::Checkbox("##editv", &_val)) {
+            notifyModified();
+        }
     }
     template<>
     void CVar<int8_t>::drawImGuiEdit() {
         int i = _val;
-        ImGui::InputInt("##editv", &i);
-        _val = (int8_t)glm::clamp(i,
-            (int)std::numeric_limits<int8_t>::min(),
-            (int)std::numeric_limits<int8_t>::max());
+        if(ImGui::InputInt("##editv", &i)) {
+            _val = (int8_t)glm::clamp(i,
+                (int)std::numeric_limits<int8_t>::min(),
+                (int)std::numeric_limits<int8_t>::max());
+            notifyModified();
+        }
     }
     template<>
     void CVar<uint8_t>::drawImGuiEdit() {
         int i = _val;
-        ImGui::InputInt("##editv", &i);
-        _val = (uint8_t)glm::clamp(i,
-            (int)std::numeric_limits<uint8_t>::min(),
-            (int)std::numeric_limits<uint8_t>::max());
+        if(ImGui::InputInt("##editv", &i)) {
+            _val = (uint8_t)glm::clamp(i,
+                (int)std::numeric_limits<uint8_t>::min(),
+                (int)std::numeric_limits<uint8_t>::max());
+            notifyModified();
+        }
     }
     template<>
     void CVar<int16_t>::drawImGuiEdit() {
         int i = _val;
-        ImGui::InputInt("##editv", &i);
-        _val = (int16_t)glm::clamp(i,
-            (int)std::numeric_limits<int16_t>::min(),
-            (int)std::numeric_limits<int16_t>::max());
+        if(ImGui::InputInt("##editv", &i)) {
+            _val = (int16_t)glm::clamp(i,
+                (int)std::numeric_limits<int16_t>::min(),
+                (int)std::numeric_limits<int16_t>::max());
+            notifyModified();
+        }
     }
     template<>
     void CVar<uint16_t>::drawImGuiEdit() {
         int i = _val;
-        ImGui::InputInt("##editv", &i);
-        _val = (uint16_t)glm::clamp(i,
-            (int)std::numeric_limits<uint16_t>::min(),
-            (int)std::numeric_limits<uint16_t>::max());
+        if(ImGui::InputInt("##editv", &i)) {
+            _val = (uint16_t)glm::clamp(i,
+                (int)std::numeric_limits<uint16_t>::min(),
+                (int)std::numeric_limits<uint16_t>::max());
+            notifyModified();
+        }
     }
     template<>
     void CVar<int32_t>::drawImGuiEdit() {
         int i = _val;
-        ImGui::InputInt("##editv", &i);
-        _val = (int32_t)glm::clamp(i,
-            (int)std::numeric_limits<int32_t>::min(),
-            (int)std::numeric_limits<int32_t>::max());
+        if(ImGui::InputInt("##editv", &i)) {
+            _val = (int32_t)glm::clamp(i,
+                (int)std::numeric_limits<int32_t>::min(),
+                (int)std::numeric_limits<int32_t>::max());
+            notifyModified();
+        }
     }
     template<>
     void CVar<uint32_t>::drawImGuiEdit() {
         int i = _val;
-        ImGui::InputInt("##editv", &i);
-        _val = (uint32_t)glm::clamp(i,
-            (int)std::numeric_limits<uint32_t>::min(),
-            (int)std::numeric_limits<uint32_t>::max());
+        if(ImGui::InputInt("##editv", &i)) {
+            _val = (uint32_t)glm::clamp(i,
+                (int)std::numeric_limits<uint32_t>::min(),
+                (int)std::numeric_limits<uint32_t>::max());
+            notifyModified();
+        }
     }
     template<>
     void CVar<int64_t>::drawImGuiEdit() {
         int i = _val;
-        ImGui::InputInt("##editv", &i);
-        _val = (int64_t)glm::clamp(i,
-            (int)std::numeric_limits<int64_t>::min(),
-            (int)std::numeric_limits<int64_t>::max());
+        if(ImGui::InputInt("##editv", &i)) {
+            _val = (int64_t)glm::clamp(i,
+                (int)std::numeric_limits<int64_t>::min(),
+                (int)std::numeric_limits<int64_t>::max());
+            notifyModified();
+        }
     }
     template<>
     void CVar<uint64_t>::drawImGuiEdit() {
         int i = _val;
-        ImGui::InputInt("##editv", &i);
-        _val = (uint64_t)glm::clamp(i,
-            (int)std::numeric_limits<uint64_t>::min(),
-            (int)std::numeric_limits<uint64_t>::max());
+        if(ImGui::InputInt("##editv", &i)) {
+            _val = (uint64_t)glm::clamp(i,
+                (int)std::numeric_limits<uint64_t>::min(),
+                (int)std::numeric_limits<uint64_t>::max());
+            notifyModified();
+        }
     }
     template<>
     void CVar<float>::drawImGuiEdit() {
-        ImGui::InputFloat("##editv", &_val);
+        if(ImGui::InputFloat("##editv", &_val)) {
+            notifyModified();
+        }
     }
     template<>
     void CVar<double>::drawImGuiEdit() {
-        ImGui::InputDouble("##editv", &_val);
+        if(ImGui::InputDouble("##editv", &_val)) {
+            notifyModified();
+        }
     }
     template<>
     void CVar<std::string>::drawImGuiEdit() {
-        ImGui::InputText("##editv",
+        if(ImGui::InputText("##editv",
             &_val,
-            0);
+            0)) {
+            notifyModified();
+        }
     }
 
     template<>
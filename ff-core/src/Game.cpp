@@ -13,7 +13,8 @@
 #include <ff/events/GameShutdownEvent.hpp>
 
 namespace ff {
-    Game::Game() {
+    Game::Game()
+        :_processBudgetCVar("process_budget_ms") {
         Locator::getMessageBus().addHandler<ShutdownCmd>(this);
     }
     Game::~Game() {
@@ -21,20 +22,19 @@ namespace ff {
 
     void Game::update(const float& dt) {
         Locator::getStatistics().beginStopwatch("game_update_time");
+        _processManager.setBudget(_processBudgetCVar.get() / 1000);
         _processManager.tick(dt);
         Locator::getStatistics().pushListValue("Game Update Time (ms)", Locator::getStatistics().endStopwatch("game_update_time") * 1000);
+        Locator::getStatistics().pushListValue("Budgeted Processes Behind", _processManager.getBudgetedBehindCount());
+        Locator::getStatistics().pushListValue("Budgeted Process Lag (ms)", _processManager.getBudgetedLag() * 1000);
     }
 
     bool Game::getAlive() const {
-        return _processManager.getProcesses().size() > 0;
+        return _processManager.getProcesses().size() > 0
+            || _processManager.getBudgetedProcesses().size() > 0;
     }
     void Game::shutdown() {
-        for (auto it = _processManager.getProcesses().begin();
-            it != _processManager.getProcesses().end();
-            it++) {
-            (*it)->setNext(nullptr);
-        }
-        _processManager.killAll();
+        _processManager.killAll(false, true);
     }
 
     std::shared_ptr<Process> Game::attachProcess(std::shared_ptr<Process> process) {
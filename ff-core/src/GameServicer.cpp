@@ -8,6 +8,7 @@
 #include <ff/CVars.hpp>
 #include <ff/Console.hpp>
 #include <ff/Locator.hpp>
+#include <ff/debug/Profiler.hpp>
 #include <ff/processes/NullProcess.hpp>
 #include <ff/assets/DirectoryAssetBundle.hpp>
 #include <memory>
@@ -62,7 +63,12 @@ namespace ff {
         _libraryHandle(nullptr),
         _preInitialized(false),
         _loopTimeInit(false),
-        _forceZeroDelta(false) {
+        _forceZeroDelta(false),
+        _vsyncCVar("graphics_vsync"),
+        _deltaSmoothingCVar("graphics_delta_smoothing"),
+        _acculmulatorMaxBeforeResetCVar("acculmulator_max_before_reset"),
+        _tickFrequencyCVar("tick_frequency"),
+        _frameSmoothingCVar("graphics_frame_smoothing") {
     }
     GameServicer::~GameServicer() {
 #if !defined(FF_HARD_LINK_ENTRY)
@@ -291,8 +297,8 @@ namespace ff {
 
         Locator::getStatistics().pushListValue("Frame dt (ms)", dt);
 
-        if(CVars::get<bool>("graphics_vsync")) {
-            if(CVars::get<bool>("graphics_delta_smoothing")) {
+        if(_vsyncCVar.get()) {
+            if(_deltaSmoothingCVar.get()) {
                 // Smoothing is only available when vsync is enabled, since
                 // frames are always displayed at equal intervals. When vsync
                 // is disabled, frames are shown ASAP, so the dt can be
@@ -327,10 +333,10 @@ namespace ff {
         }
 
         acculmulator += dt;
-        if(acculmulator > CVars::get<float>("acculmulator_max_before_reset")) {
+        if(acculmulator > _acculmulatorMaxBeforeResetCVar.get()) {
             acculmulator = 0;
         }
-        const float tickPeriod = 1 / CVars::get<float>("tick_frequency");
+        const float tickPeriod = 1 / _tickFrequencyCVar.get();
         while (acculmulator >= tickPeriod) {
             acculmulator -= tickPeriod;
             update(tickPeriod);
@@ -341,20 +347,31 @@ namespace ff {
             dt);
 
         _gameLoopPtr->onService();
+
+#ifdef FF_PROFILER
+        Profiler::endFrame();
+#endif
     }
 
     void GameServicer::update(const float& tickPeriod) {
+        FF_PROFILE_ZONE("GameServicer::update");
+
         // @todo This needs to be wrapped with an @autoreleasepool
         // Or, ya know, just have the game loop do it itself...
         _gameLoopPtr->update(tickPeriod);
         _game.update(tickPeriod);
+
+        // Deliver events queued during this tick
+        Locator::getMessageBus().flush();
     }
     void GameServicer::render(const float& tickPeriod, const float& acculmulator, const float& timeSinceLastFrame) {
+        FF_PROFILE_ZONE("GameServicer::render");
+
         // @todo This needs to be wrapped with an @autoreleasepool
         // This one actually does because Metal will do whatever it wants
         Locator::getGraphicsDevice().preRender();
         float betweenFrameAlpha;
-        if (ff::CVars::get<bool>("graphics_frame_smoothing")) {
+        if (_frameSmoothingCVar.get()) {
             betweenFrameAlpha = acculmulator / tickPeriod;
         }
         else {
@@ -23,7 +23,12 @@ namespace ff {
             _audioBackend = std::make_unique<NullAudioBackend>();
             _environment = std::make_unique<NullEnvironment>();
             _messageBus = std::make_unique<MessageBus>();
+#ifdef FF_ACTOR_ARCHETYPE_STORAGE
+            _actorManager = std::make_unique<ActorManager>(ActorStorage::ARCHETYPES);
+#else
             _actorManager = std::make_unique<ActorManager>();
+#endif
+            _jobSystem = std::make_unique<JobSystem>();
             _cameraManager = std::make_unique<CameraManager>();
             _colorTextureManager = std::make_unique<TextureManager<ColorTexture>>();
             _depthTextureManager = std::make_unique<TextureManager<DepthTexture>>();
@@ -71,6 +76,10 @@ namespace ff {
             return *_actorManager;
         }
 
+        JobSystem& getJobSystem() override {
+            return *_jobSystem;
+        }
+
         CameraManager& getCameraManager() override {
             return *_cameraManager;
         }
@@ -90,6 +99,7 @@ namespace ff {
             _environment.reset();
             _messageBus.reset();
             _actorManager.reset();
+            _jobSystem.reset();
             _cameraManager.reset();
             _colorTextureManager.reset();
             _depthTextureManager.reset();
@@ -103,6 +113,7 @@ namespace ff {
         std::unique_ptr<IEnvironment> _environment;
         std::unique_ptr<MessageBus> _messageBus;
         std::unique_ptr<ActorManager> _actorManager;
+        std::unique_ptr<JobSystem> _jobSystem;
         std::unique_ptr<CameraManager> _cameraManager;
         std::unique_ptr<TextureManager<ColorTexture>> _colorTextureManager;
         std::unique_ptr<TextureManager<DepthTexture>> _depthTextureManager;
@@ -148,6 +159,10 @@ namespace ff {
         return getLocatorImpInstance()->getActorManager();
     }
 
+    JobSystem& Locator::getJobSystem() {
+        return getLocatorImpInstance()->getJobSystem();
+    }
+
     CameraManager& Locator::getCameraManager() {
         return getLocatorImpInstance()->getCameraManager();
     }
@@ -0,0 +1,180 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <ff/actors/ActorCommandBuffer.hpp>
+
+#include <ff/Console.hpp>
+
+#include <algorithm>
+
+namespace ff {
+    namespace {
+        std::atomic<uint64_t> nextCommandBufferID(1);
+    }
+
+    void* ActorCommandBuffer::Lane::allocate(const size_t& size, const size_t& alignment) {
+        if(size > FF_ACTOR_COMMAND_BUFFER_PAGE_SIZE) {
+            largeAllocations.emplace_back(new unsigned char[size]);
+            return largeAllocations.back().get();
+        }
+
+        size_t offset = (pageOffset + alignment - 1) / alignment * alignment;
+        if(usedPageCount == 0 || offset + size > FF_ACTOR_COMMAND_BUFFER_PAGE_SIZE) {
+            if(usedPageCount == pages.size()) {
+                pages.emplace_back(new unsigned char[FF_ACTOR_COMMAND_BUFFER_PAGE_SIZE]);
+            }
+            usedPageCount++;
+            offset = 0;
+        }
+        pageOffset = offset + size;
+        return pages[usedPageCount - 1].get() + offset;
+    }
+
+    ActorCommandBuffer::ActorCommandBuffer()
+        :_id(nextCommandBufferID++),
+        _nextSequence(0),
+        _createdActorCount(0) {
+    }
+    ActorCommandBuffer::~ActorCommandBuffer() {
+        clear();
+    }
+
+    Actor_t ActorCommandBuffer::createActor() {
+        uint32_t index = _createdActorCount++;
+        FF_ASSERT(index < FF_ACTOR_INVALID, "Too many actors created in one command buffer.");
+        return convertActorIDAndVersionToActor(index, FF_ACTOR_MAX_VERSION);
+    }
+    void ActorCommandBuffer::destroyActor(const Actor_t& actor) {
+        record(getLane(), actor, CommandType::DESTROY, nullptr, nullptr, nullptr);
+    }
+
+    bool ActorCommandBuffer::isEmpty() {
+        if(_createdActorCount > 0) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(_lanesMutex);
+        for(auto const& lane : _lanes) {
+            if(!lane->commands.empty()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void ActorCommandBuffer::playback(ActorManager& actorManager) {
+        // Placeholders are swapped for real actors first, so their commands sort
+        // and apply like any other actor's
+        std::vector<Actor_t> createdActors(_createdActorCount);
+        for(Actor_t& actor : createdActors) {
+            actor = actorManager.allocateActor();
+        }
+
+        std::vector<Command*> commands;
+        for(auto& lane : _lanes) {
+            for(Command& command : lane->commands) {
+                if(isPlaceholder(command.actor)) {
+                    FF_ASSERT(convertActorToID(command.actor) < createdActors.size(),
+                        "Placeholder actor %s is not from this command buffer.", convertActorToID(command.actor));
+                    command.actor = createdActors[convertActorToID(command.actor)];
+                }
+                commands.push_back(&command);
+            }
+        }
+        std::sort(commands.begin(), commands.end(), [](Command const* const& a, Command const* const& b) {
+            return a->actor != b->actor ? a->actor < b->actor : a->sequence < b->sequence;
+        });
+
+        std::vector<Actor_t> sortedCreatedActors = createdActors;
+        std::sort(sortedCreatedActors.begin(), sortedCreatedActors.end());
+
+        std::vector<Actor_t> destroyedActors;
+        for(size_t begin = 0, end = 0; begin < commands.size(); begin = end) {
+            Actor_t const actor = commands[begin]->actor;
+            bool destroyed = false;
+            for(end = begin; end < commands.size() && commands[end]->actor == actor; ++end) {
+                destroyed = destroyed || commands[end]->type == CommandType::DESTROY;
+            }
+            if(!actorManager.isActorAlive(actor)) {
+                continue;
+            }
+            if(destroyed) {
+                destroyedActors.push_back(actor);
+                continue;
+            }
+
+            ComponentMask prevMask = actorManager.getComponentMask(actor);
+            for(size_t i = begin; i < end; ++i) {
+                commands[i]->apply(actorManager, actor, commands[i]->data);
+            }
+            // Created actors aren't in any family yet; they're added below
+            if(!std::binary_search(sortedCreatedActors.begin(), sortedCreatedActors.end(), actor)) {
+                actorManager.updateFamilyActorMapsForActor(actor, prevMask);
+            }
+        }
+
+        actorManager.destroyActors(destroyedActors);
+        for(Actor_t const& actor : createdActors) {
+            if(actorManager.isActorAlive(actor)) {
+                actorManager.addActorToFamilies(actor);
+            }
+        }
+
+        clear();
+    }
+    void ActorCommandBuffer::clear() {
+        std::lock_guard<std::mutex> lock(_lanesMutex);
+        for(auto& lane : _lanes) {
+            for(Command const& command : lane->commands) {
+                if(command.destruct != nullptr) {
+                    command.destruct(command.data);
+                }
+            }
+            lane->commands.clear();
+            lane->usedPageCount = 0;
+            lane->pageOffset = 0;
+            lane->largeAllocations.clear();
+        }
+        _nextSequence = 0;
+        _createdActorCount = 0;
+    }
+
+    ActorCommandBuffer::Lane& ActorCommandBuffer::getLane() {
+        // Each thread records into its own lane, so the lock is only taken when a
+        // thread switches buffers
+        thread_local uint64_t cachedBufferID = 0;
+        thread_local Lane* cachedLanePtr = nullptr;
+        if(cachedBufferID == _id) {
+            return *cachedLanePtr;
+        }
+
+        std::lock_guard<std::mutex> lock(_lanesMutex);
+        std::thread::id const threadID = std::this_thread::get_id();
+        Lane* lanePtr = nullptr;
+        for(auto& lane : _lanes) {
+            if(lane->threadID == threadID) {
+                lanePtr = lane.get();
+                break;
+            }
+        }
+        if(lanePtr == nullptr) {
+            _lanes.push_back(std::make_unique<Lane>());
+            lanePtr = _lanes.back().get();
+            lanePtr->threadID = threadID;
+        }
+        cachedBufferID = _id;
+        cachedLanePtr = lanePtr;
+        return *lanePtr;
+    }
+    void ActorCommandBuffer::record(Lane& lane, const Actor_t& actor, const CommandType& type, void* const& data,
+        void (*apply)(ActorManager&, const Actor_t&, void* const&),
+        void (*destruct)(void* const&)) {
+        lane.commands.push_back({ actor, _nextSequence++, type, data, apply, destruct });
+    }
+
+    bool ActorCommandBuffer::isPlaceholder(const Actor_t& actor) {
+        return convertActorToVersion(actor) == FF_ACTOR_MAX_VERSION && !isActorNull(actor);
+    }
+}
@@ -8,41 +8,27 @@
 
 #include <ff/Console.hpp>
 
+#include <algorithm>
+
 namespace ff {
-    ActorManager::ActorManager()
-        :_nextFreeActor(FF_ACTOR_INVALID),
+    ActorManager::ActorManager(ActorStorage const& storage)
+        :_storage(storage),
+        _ownerThread(std::this_thread::get_id()),
+        _nextFreeActor(FF_ACTOR_INVALID),
         _freeActorCount(0),
-        _actorsSet(this, &_actors, &_freeActorCount) {
+        _actorsSet(this, &_actors, &_freeActorCount),
+        _componentMaps(FF_MAX_COMPONENTS) {
     }
     ActorManager::~ActorManager() {
     }
 
-    Actor_t ActorManager::createActor() {
-        Actor_t actor;
-        if(_freeActorCount == 0) {
-            FF_ASSERT(_actors.size() < FF_ACTOR_INVALID, "Maximum number of simultaneous actors reached (%s).", FF_ACTOR_INVALID);
-            for(auto& pair : _componentMaps) {
-                pair.second->addEmptyActor();
-            }
-            _componentMaskSet.addEmptyActor();
-            _actors.push_back(convertActorIDAndVersionToActor(_actors.size(), 0));
-            actor = _actors.back();
-        } else {
-            ActorID actorID = _nextFreeActor;
-            _nextFreeActor = convertActorToID(_actors[actorID]);
-            --_freeActorCount;
-
-            ActorVersion version = convertActorToVersion(_actors[actorID]);
-            FF_ASSERT(version < FF_ACTOR_MAX_VERSION, "Maximum number of actor versions reached (%s).", FF_ACTOR_MAX_VERSION);
-            ++version;
-            actor = _actors[actorID] = convertActorIDAndVersionToActor(actorID, version);
-        }
+    ActorStorage ActorManager::getStorage() const {
+        return _storage;
+    }
 
-        for(auto& pair : _familyActorSets) {
-            if(pair.first.matches(FF_ACTOR_COMPONENT_MASK_EMPTY)) {
-                pair.second->addActor(actor);
-            }
-        }
+    Actor_t ActorManager::createActor() {
+        Actor_t actor = allocateActor();
+        addActorToFamilies(actor);
         return actor;
     }
     bool ActorManager::isActorAlive(const Actor_t& actor) const {
@@ -54,55 +40,78 @@ namespace ff {
             return;
         }
 
-        ComponentType prevMask = getComponentMask(actor);
-
-        for(auto& pair : _componentMaps) {
-            pair.second->removeComponent(actor);
+        if(_storage == ActorStorage::ARCHETYPES) {
+            _archetypeStorage.removeAllComponents(actor);
+        } else {
+            for(auto& componentMap : _componentMaps) {
+                if(componentMap != nullptr) {
+                    componentMap->removeComponent(actor);
+                }
+            }
         }
         _componentMaskSet.clearMask(actor);
 
-        updateFamilyActorMapsForActor(actor, prevMask);
+        removeActorFromFamilies(actor);
+        releaseActor(actor);
+    }
+    void ActorManager::destroyActors(Actor_t const* const& actors, size_t const& count) {
+        std::vector<Actor_t> aliveActors;
+        aliveActors.reserve(count);
+        for(size_t i = 0; i < count; ++i) {
+            if(isActorAlive(actors[i])) {
+                aliveActors.push_back(actors[i]);
+            }
+        }
+        std::sort(aliveActors.begin(), aliveActors.end());
+        aliveActors.erase(std::unique(aliveActors.begin(), aliveActors.end()), aliveActors.end());
+        if(aliveActors.empty()) {
+            return;
+        }
 
-        if(_freeActorCount == 0) {
-            _nextFreeActor = convertActorToID(actor);
-            _actors[convertActorToID(actor)] = convertActorIDAndVersionToActor(FF_ACTOR_INVALID, convertActorToVersion(actor));
+        if(_storage == ActorStorage::ARCHETYPES) {
+            _archetypeStorage.removeAllComponents(aliveActors.data(), aliveActors.size());
         } else {
-            ActorID lastDeletedActor = _nextFreeActor;
-            while(convertActorToID(_actors[lastDeletedActor]) != FF_ACTOR_INVALID) {
-                lastDeletedActor = convertActorToID(_actors[lastDeletedActor]);
+            for(auto& componentMap : _componentMaps) {
+                if(componentMap != nullptr) {
+                    componentMap->removeComponents(aliveActors.data(), aliveActors.size());
+                }
             }
-            _actors[lastDeletedActor] = convertActorIDAndVersionToActor(convertActorToID(actor),
-                convertActorToVersion(_actors[lastDeletedActor]));
-            _actors[convertActorToID(actor)] = convertActorIDAndVersionToActor(FF_ACTOR_INVALID, convertActorToVersion(actor));
         }
 
-        _freeActorCount++;
+        for(Actor_t const& actor : aliveActors) {
+            _componentMaskSet.clearMask(actor);
+            removeActorFromFamilies(actor);
+            releaseActor(actor);
+        }
+    }
+    void ActorManager::destroyActors(std::vector<Actor_t> const& actors) {
+        destroyActors(actors.data(), actors.size());
     }
     void ActorManager::destroyAllActors() {
         if(_freeActorCount == _actors.size()) {
             return;
         }
 
-        for(auto& pair : _componentMaps) {
-            pair.second->removeAllActors();
+        std::vector<Actor_t> aliveActors;
+        aliveActors.reserve(_actors.size() - _freeActorCount);
+        for(ActorID i = 0; i < _actors.size(); ++i) {
+            if(convertActorToID(_actors[i]) == i) {
+                aliveActors.push_back(_actors[i]);
+            }
         }
+        destroyActors(aliveActors);
+
         for(auto& pair : _familyActorSets) {
             pair.second->removeAllActors();
         }
-        _freeActorCount = _actors.size();
-        _nextFreeActor = 0;
-
-        _actors[_actors.size() - 1] = convertActorIDAndVersionToActor(FF_ACTOR_INVALID,
-            convertActorToVersion(_actors[_actors.size() - 1]));
-        for(int i = _actors.size() - 2; i >= 0; --i) {
-            _actors[i] = convertActorIDAndVersionToActor(i + 1,
-                convertActorToVersion(_actors[i]));
-        }
     }
     void ActorManager::destroyAllActorsFor(Family const& family) {
-        getActorsFor(family).each([this](Actor_t actor) -> void {
-            destroyActor(actor);
+        std::vector<Actor_t> familyActors;
+        familyActors.reserve(getActorsFor(family).count());
+        getActorsFor(family).each([&familyActors](Actor_t actor) -> void {
+            familyActors.push_back(actor);
         });
+        destroyActors(familyActors);
     }
 
     const IterableActorSet& ActorManager::getActors() {
@@ -121,11 +130,11 @@ namespace ff {
         return _familyActorSets.at(family)->getActors();
     }
 
-    ComponentType ActorManager::getComponentMask(const Actor_t& actor) const {
+    const ComponentMask& ActorManager::getComponentMask(const Actor_t& actor) const {
         return _componentMaskSet.getComponentMask(actor);
     }
 
-    void ActorManager::updateFamilyActorMapsForActor(const Actor_t& actor, const ComponentType& prevMask) {
+    void ActorManager::updateFamilyActorMapsForActor(const Actor_t& actor, const ComponentMask& prevMask) {
         for(auto& pair : _familyActorSets) {
             if(!pair.first.matches(prevMask)
                 && pair.first.matches(this, actor)) {
@@ -137,15 +146,60 @@ namespace ff {
                 pair.second->removeActor(actor);
                 continue;
             }
-            if(!isActorAlive(actor)
-                && pair.first.matches(prevMask)
-                && pair.second->hasActor(actor)) {
+        }
+    }
+    void ActorManager::addActorToFamilies(const Actor_t& actor) {
+        for(auto& pair : _familyActorSets) {
+            if(pair.first.matches(this, actor)) {
+                pair.second->addActor(actor);
+            }
+        }
+    }
+    void ActorManager::removeActorFromFamilies(const Actor_t& actor) {
+        // Destroyed actors can match families that only exclude components, so
+        // rather than diffing masks, drop the actor from every set holding it
+        for(auto& pair : _familyActorSets) {
+            if(pair.second->hasActor(actor)) {
                 pair.second->removeActor(actor);
-                continue;
             }
         }
     }
 
+    Actor_t ActorManager::allocateActor() {
+        if(_freeActorCount == 0) {
+            FF_ASSERT(_actors.size() < FF_ACTOR_INVALID, "Maximum number of simultaneous actors reached (%s).", FF_ACTOR_INVALID);
+            for(auto& componentMap : _componentMaps) {
+                if(componentMap != nullptr) {
+                    componentMap->addEmptyActor();
+                }
+            }
+            _componentMaskSet.addEmptyActor();
+            if(_storage == ActorStorage::ARCHETYPES) {
+                _archetypeStorage.addEmptyActor();
+            }
+            _actors.push_back(convertActorIDAndVersionToActor(_actors.size(), 0));
+            return _actors.back();
+        }
+
+        ActorID actorID = _nextFreeActor;
+        _nextFreeActor = convertActorToID(_actors[actorID]);
+        --_freeActorCount;
+
+        // The last version is reserved for ActorCommandBuffer placeholders
+        ActorVersion version = convertActorToVersion(_actors[actorID]);
+        FF_ASSERT(version < FF_ACTOR_MAX_VERSION - 1, "Maximum number of actor versions reached (%s).", FF_ACTOR_MAX_VERSION - 1);
+        ++version;
+        return _actors[actorID] = convertActorIDAndVersionToActor(actorID, version);
+    }
+    void ActorManager::releaseActor(const Actor_t& actor) {
+        // Freed IDs form a LIFO list threaded through `_actors`, so releasing is constant time
+        ActorID actorID = convertActorToID(actor);
+        _actors[actorID] = convertActorIDAndVersionToActor(_freeActorCount > 0 ? _nextFreeActor : FF_ACTOR_INVALID,
+            convertActorToVersion(actor));
+        _nextFreeActor = actorID;
+        _freeActorCount++;
+    }
+
     bool ActorManager::isActorValid(Actor_t const& actor) {
         ff::ActorID id = convertActorToID(actor);
         if(id > _actors.size() - 1) {
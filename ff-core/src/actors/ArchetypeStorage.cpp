@@ -0,0 +1,237 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <ff/actors/ArchetypeStorage.hpp>
+
+#include <algorithm>
+
+namespace ff {
+    ArchetypeChunk::ArchetypeChunk(size_t const& size, size_t const& alignment, uint32_t const& capacity)
+        :data(static_cast<unsigned char*>(::operator new(size, std::align_val_t(alignment)))),
+        alignment(alignment) {
+        actors.reserve(capacity);
+    }
+    ArchetypeChunk::~ArchetypeChunk() {
+        ::operator delete(data, std::align_val_t(alignment));
+    }
+
+    Archetype::Archetype(ComponentMask const& mask, std::vector<_internal::ComponentColumnInfo const*> const& columns)
+        :_mask(mask),
+        _columns(columns),
+        _chunkAlignment(alignof(std::max_align_t)) {
+        _columnIndices.fill(-1);
+
+        size_t actorSize = 0;
+        for(size_t i = 0; i < _columns.size(); ++i) {
+            _columnIndices[_columns[i]->index] = (int16_t)i;
+            actorSize += _columns[i]->size;
+            _chunkAlignment = std::max(_chunkAlignment, _columns[i]->alignment);
+        }
+        _chunkCapacity = (uint32_t)std::max<size_t>(1, FF_ARCHETYPE_CHUNK_SIZE / actorSize);
+
+        // Columns are laid out back to back, each padded to the alignment of its type
+        size_t offset = 0;
+        for(auto const& column : _columns) {
+            offset = (offset + column->alignment - 1) / column->alignment * column->alignment;
+            _columnOffsets.push_back(offset);
+            offset += column->size * _chunkCapacity;
+        }
+        _chunkSize = std::max<size_t>(offset, 1);
+    }
+
+    const ComponentMask& Archetype::getMask() const {
+        return _mask;
+    }
+    uint32_t Archetype::getChunkCapacity() const {
+        return _chunkCapacity;
+    }
+    size_t Archetype::getChunkCount() const {
+        return _chunks.size();
+    }
+    size_t Archetype::getActorCount() const {
+        if(_chunks.empty()) {
+            return 0;
+        }
+        return (_chunks.size() - 1) * _chunkCapacity + _chunks.back()->actors.size();
+    }
+
+    uint32_t Archetype::getActorCount(size_t const& chunk) const {
+        return (uint32_t)_chunks[chunk]->actors.size();
+    }
+    Actor_t const* Archetype::getActors(size_t const& chunk) const {
+        return _chunks[chunk]->actors.data();
+    }
+    bool Archetype::hasColumn(ComponentIndex const& index) const {
+        return _columnIndices[index] >= 0;
+    }
+
+    void* Archetype::getComponent(uint32_t const& chunk, uint32_t const& row, size_t const& column) {
+        return _chunks[chunk]->data + _columnOffsets[column] + row * _columns[column]->size;
+    }
+
+    ArchetypeStorage::ArchetypeStorage()
+        :_iterationDepth(0) {
+        _columnInfos.fill(nullptr);
+    }
+    ArchetypeStorage::~ArchetypeStorage() {
+        for(auto& archetype : _archetypes) {
+            for(uint32_t chunk = 0; chunk < archetype->_chunks.size(); ++chunk) {
+                for(uint32_t row = 0; row < archetype->getActorCount(chunk); ++row) {
+                    for(size_t column = 0; column < archetype->_columns.size(); ++column) {
+                        archetype->_columns[column]->destruct(archetype->getComponent(chunk, row, column));
+                    }
+                }
+            }
+        }
+    }
+
+    void ArchetypeStorage::addEmptyActor() {
+        _locations.push_back({ NO_ARCHETYPE, 0, 0 });
+    }
+    void ArchetypeStorage::addEmptyActors(const int& count) {
+        _locations.resize(_locations.size() + count, { NO_ARCHETYPE, 0, 0 });
+    }
+
+    void ArchetypeStorage::removeAllComponents(const Actor_t& actor) {
+        Location const& location = _locations[convertActorToID(actor)];
+        if(location.archetype == NO_ARCHETYPE) {
+            return;
+        }
+
+        // Like ComponentMap, listeners are notified while the components are still readable
+        for(auto const& column : _archetypes[location.archetype]->_columns) {
+            column->dispatchRemoved(actor);
+        }
+        moveActor(actor, FF_ACTOR_COMPONENT_MASK_EMPTY);
+    }
+    void ArchetypeStorage::removeAllComponents(Actor_t const* const& actors, const size_t& count) {
+        std::array<std::vector<Actor_t>, FF_MAX_COMPONENTS> actorsPerColumn;
+        for(size_t i = 0; i < count; ++i) {
+            Location const& location = _locations[convertActorToID(actors[i])];
+            if(location.archetype == NO_ARCHETYPE) {
+                continue;
+            }
+            for(auto const& column : _archetypes[location.archetype]->_columns) {
+                actorsPerColumn[column->index].push_back(actors[i]);
+            }
+        }
+
+        for(ComponentIndex index = 0; index < FF_MAX_COMPONENTS; ++index) {
+            if(!actorsPerColumn[index].empty()) {
+                _columnInfos[index]->dispatchRemovedBulk(actorsPerColumn[index].data(), actorsPerColumn[index].size());
+            }
+        }
+        for(size_t i = 0; i < count; ++i) {
+            moveActor(actors[i], FF_ACTOR_COMPONENT_MASK_EMPTY);
+        }
+    }
+
+    const std::vector<std::unique_ptr<Archetype>>& ArchetypeStorage::getArchetypes() const {
+        return _archetypes;
+    }
+
+    void ArchetypeStorage::beginIteration() {
+        _iterationDepth++;
+    }
+    void ArchetypeStorage::endIteration() {
+        FF_ASSERT(_iterationDepth > 0, "Unbalanced archetype iteration.");
+        _iterationDepth--;
+    }
+
+    void ArchetypeStorage::registerColumn(_internal::ComponentColumnInfo const& info) {
+        _columnInfos[info.index] = &info;
+    }
+    uint32_t ArchetypeStorage::getOrCreateArchetype(const ComponentMask& mask) {
+        auto it = _archetypeIndices.find(mask);
+        if(it != _archetypeIndices.end()) {
+            return it->second;
+        }
+
+        std::vector<_internal::ComponentColumnInfo const*> columns;
+        mask.eachIndex([this, &columns](ComponentIndex index) {
+            FF_ASSERT(_columnInfos[index] != nullptr, "Component %s was never registered.", index);
+            columns.push_back(_columnInfos[index]);
+        });
+
+        uint32_t index = (uint32_t)_archetypes.size();
+        _archetypes.emplace_back(std::make_unique<Archetype>(mask, columns));
+        _archetypeIndices.emplace(mask, index);
+        return index;
+    }
+    void* ArchetypeStorage::getComponent(const Actor_t& actor, const ComponentIndex& index) const {
+        Location const& location = _locations[convertActorToID(actor)];
+        FF_ASSERT(location.archetype != NO_ARCHETYPE && _archetypes[location.archetype]->hasColumn(index),
+            "Actor %s does not have component.", convertActorToID(actor));
+        Archetype& archetype = *_archetypes[location.archetype];
+        return archetype.getComponent(location.chunk, location.row, archetype._columnIndices[index]);
+    }
+
+    void ArchetypeStorage::moveActor(const Actor_t& actor, const ComponentMask& mask) {
+        FF_ASSERT(_iterationDepth == 0, "Actors cannot gain or lose components while archetype chunks are being iterated.");
+
+        ActorID actorID = convertActorToID(actor);
+        Location const prevLocation = _locations[actorID];
+        Location location = { NO_ARCHETYPE, 0, 0 };
+
+        if(mask != FF_ACTOR_COMPONENT_MASK_EMPTY) {
+            location.archetype = getOrCreateArchetype(mask);
+            Archetype& archetype = *_archetypes[location.archetype];
+            if(archetype._chunks.empty()
+                || archetype._chunks.back()->actors.size() == archetype._chunkCapacity) {
+                if(archetype._spareChunk != nullptr) {
+                    archetype._chunks.push_back(std::move(archetype._spareChunk));
+                } else {
+                    archetype._chunks.emplace_back(std::make_unique<ArchetypeChunk>(archetype._chunkSize,
+                        archetype._chunkAlignment,
+                        archetype._chunkCapacity));
+                }
+            }
+            location.chunk = (uint32_t)archetype._chunks.size() - 1;
+            location.row = (uint32_t)archetype._chunks.back()->actors.size();
+            archetype._chunks.back()->actors.push_back(actor);
+        }
+
+        if(prevLocation.archetype != NO_ARCHETYPE) {
+            Archetype& prevArchetype = *_archetypes[prevLocation.archetype];
+            for(size_t column = 0; column < prevArchetype._columns.size(); ++column) {
+                _internal::ComponentColumnInfo const& info = *prevArchetype._columns[column];
+                void* src = prevArchetype.getComponent(prevLocation.chunk, prevLocation.row, column);
+                if(location.archetype != NO_ARCHETYPE && _archetypes[location.archetype]->hasColumn(info.index)) {
+                    Archetype& archetype = *_archetypes[location.archetype];
+                    info.moveConstruct(archetype.getComponent(location.chunk, location.row, archetype._columnIndices[info.index]), src);
+                }
+                info.destruct(src);
+            }
+            removeRow(prevLocation.archetype, prevLocation.chunk, prevLocation.row);
+        }
+
+        _locations[actorID] = location;
+    }
+    void ArchetypeStorage::removeRow(const uint32_t& archetypeIndex, const uint32_t& chunk, const uint32_t& row) {
+        // The row's components must already be destructed. The last actor of the
+        // archetype is moved into the hole to keep the chunks packed.
+        Archetype& archetype = *_archetypes[archetypeIndex];
+        uint32_t lastChunk = (uint32_t)archetype._chunks.size() - 1;
+        uint32_t lastRow = (uint32_t)archetype._chunks[lastChunk]->actors.size() - 1;
+
+        if(chunk != lastChunk || row != lastRow) {
+            for(size_t column = 0; column < archetype._columns.size(); ++column) {
+                void* last = archetype.getComponent(lastChunk, lastRow, column);
+                archetype._columns[column]->moveConstruct(archetype.getComponent(chunk, row, column), last);
+                archetype._columns[column]->destruct(last);
+            }
+            Actor_t movedActor = archetype._chunks[lastChunk]->actors[lastRow];
+            archetype._chunks[chunk]->actors[row] = movedActor;
+            _locations[convertActorToID(movedActor)] = { archetypeIndex, chunk, row };
+        }
+
+        archetype._chunks[lastChunk]->actors.pop_back();
+        if(archetype._chunks[lastChunk]->actors.empty()) {
+            archetype._spareChunk = std::move(archetype._chunks[lastChunk]);
+            archetype._chunks.pop_back();
+        }
+    }
+}
@@ -12,19 +12,22 @@
 
 namespace ff {
     namespace _internal {
-        ComponentType getNextComponentType() {
-            static ComponentType nextType = 1;
-            FF_ASSERT(nextType != 0, "Max components reached (can only register up to %i).", FF_MAX_COMPONENTS);
-            ComponentType type = nextType;
-            nextType <<= 1;
-            return type;
+        namespace {
+            ComponentIndex componentCount = 0;
         }
-        ComponentType getComponentType(const std::type_index& type) {
-            static std::unordered_map<std::type_index, ComponentType> typeMap;
-            if (typeMap.find(type) == typeMap.end()) {
-                typeMap.emplace(type, getNextComponentType());
+
+        ComponentIndex getComponentIndex(const std::type_index& type) {
+            static std::unordered_map<std::type_index, ComponentIndex> indexMap;
+            auto it = indexMap.find(type);
+            if(it != indexMap.end()) {
+                return it->second;
             }
-            return typeMap[type];
+            FF_ASSERT(componentCount < FF_MAX_COMPONENTS, "Max components reached (can only register up to %i, see FF_MAX_COMPONENTS).", FF_MAX_COMPONENTS);
+            indexMap.emplace(type, componentCount);
+            return componentCount++;
+        }
+        ComponentIndex getComponentCount() {
+            return componentCount;
         }
     }
 }
@@ -13,28 +13,28 @@ namespace ff {
     }
 
     void ComponentMaskSet::addEmptyActor() {
-        _componentMasks.push_back(0);
+        _componentMasks.push_back(FF_ACTOR_COMPONENT_MASK_EMPTY);
     }
     void ComponentMaskSet::addEmptyActors(const int& count) {
         for(int i = 0; i < count; ++i) {
-            _componentMasks.push_back(0);
+            _componentMasks.push_back(FF_ACTOR_COMPONENT_MASK_EMPTY);
         }
     }
 
-    void ComponentMaskSet::addComponent(const Actor_t& actor, const ComponentType& type) {
-        _componentMasks[convertActorToID(actor)] |= type;
+    void ComponentMaskSet::addComponent(const Actor_t& actor, const ComponentIndex& index) {
+        _componentMasks[convertActorToID(actor)].set(index);
     }
-    void ComponentMaskSet::removeComponent(const Actor_t& actor, const ComponentType& type) {
-        _componentMasks[convertActorToID(actor)] &= ~type;
+    void ComponentMaskSet::removeComponent(const Actor_t& actor, const ComponentIndex& index) {
+        _componentMasks[convertActorToID(actor)].reset(index);
     }
-    bool ComponentMaskSet::hasComponent(const Actor_t& actor, const ComponentType& type) const {
-        return (_componentMasks[convertActorToID(actor)] & type) != 0;
+    bool ComponentMaskSet::hasComponent(const Actor_t& actor, const ComponentIndex& index) const {
+        return _componentMasks[convertActorToID(actor)].test(index);
     }
-    const ComponentType& ComponentMaskSet::getComponentMask(const Actor_t& actor) const {
+    const ComponentMask& ComponentMaskSet::getComponentMask(const Actor_t& actor) const {
         return _componentMasks[convertActorToID(actor)];
     }
 
     void ComponentMaskSet::clearMask(Actor_t const& actor) {
-        _componentMasks[convertActorToID(actor)] = 0;
+        _componentMasks[convertActorToID(actor)] = FF_ACTOR_COMPONENT_MASK_EMPTY;
     }
 }
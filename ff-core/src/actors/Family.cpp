@@ -9,8 +9,7 @@
 #include <ff/actors/Actor.hpp>
 
 namespace ff {
-    Family::Family()
-        :_allMask(0),_oneMask(0),_excludeMask(0) {
+    Family::Family() {
     }
     Family::Family(const Family& other)
         :_allMask(other._allMask),_oneMask(other._oneMask),
@@ -35,10 +34,19 @@ namespace ff {
         return !equals(rhs);
     }
 
-    bool Family::matches(const ComponentType& mask) const {
-        return (mask & _allMask) == _allMask
-            && (_oneMask != 0 ? (mask & _oneMask) != 0 : true)
-            && (mask & _excludeMask) == 0;
+    bool Family::matches(const ComponentMask& mask) const {
+        // One pass over the words without early outs, so it vectorizes
+        uint64_t missingAll = 0, matchingOne = 0, anyOne = 0, matchingExclude = 0;
+        for(size_t i = 0; i < FF_COMPONENT_MASK_WORD_COUNT; ++i) {
+            uint64_t const word = mask.getWord(i);
+            missingAll |= _allMask.getWord(i) & ~word;
+            matchingOne |= _oneMask.getWord(i) & word;
+            anyOne |= _oneMask.getWord(i);
+            matchingExclude |= _excludeMask.getWord(i) & word;
+        }
+        return missingAll == 0
+            && (anyOne == 0 || matchingOne != 0)
+            && matchingExclude == 0;
     }
 
     FamilyBuilder::FamilyBuilder() {
@@ -13,9 +13,9 @@ namespace ff {
         const Family& family)
         :_actorManagerPtr(actorManagerPtr),
         _family(family),
-        _iterableActors(_actorManagerPtr, &_actors, &_emptySpots),
-        _nextOpenIndex(0),
-        _emptySpots(0) {
+        _iterableActors(this),
+        _iterationDepth(0),
+        _pendingRemovalCount(0) {
     }
 
     const Family& FamilyActorSet::getFamily() const {
@@ -23,45 +23,98 @@ namespace ff {
     }
 
     void FamilyActorSet::addActor(const Actor_t& actor) {
-        if (_emptySpots > 0) {
-            Actor_t index = _nextOpenIndex;
-            _nextOpenIndex = convertActorToID(_actors[_nextOpenIndex]);
-            _actors[index] = actor;
-            _emptySpots--;
-        } else {
-            _actors.push_back(actor);
+        if(hasActor(actor)) {
+            return;
+        }
+        ActorID actorID = convertActorToID(actor);
+        if(actorID >= _actorIndices.size()) {
+            _actorIndices.resize(actorID + 1, FF_ACTOR_INVALID);
         }
+        _actorIndices[actorID] = (uint32_t)_actors.size();
+        _actors.push_back(actor);
     }
     void FamilyActorSet::removeActor(const Actor_t& actor) {
-        auto it = std::find(_actors.begin(), _actors.end(), actor);
-        FF_ASSERT(it != _actors.end(), "Actor not found in family.");
-        int indexOfActor = it - _actors.begin();
-
-        if(_emptySpots > 0) {
-            Actor_t lastOpenIndex = _nextOpenIndex;
-            while(convertActorToID(_actors[lastOpenIndex]) != FF_ACTOR_INVALID) {
-                lastOpenIndex = convertActorToID(_actors[lastOpenIndex]);
-            }
+        FF_ASSERT(hasActor(actor), "Actor not found in family.");
+        ActorID actorID = convertActorToID(actor);
+        uint32_t index = _actorIndices[actorID];
+        _actorIndices[actorID] = FF_ACTOR_INVALID;
 
-            _actors[lastOpenIndex] = convertActorIDAndVersionToActor(indexOfActor, FF_ACTOR_MAX_VERSION);
-            _actors[indexOfActor] = convertActorIDAndVersionToActor(FF_ACTOR_INVALID, FF_ACTOR_MAX_VERSION);
+        if(_iterationDepth > 0) {
+            _actors[index] = NullActor;
+            _pendingRemovalCount++;
         } else {
-            _nextOpenIndex = indexOfActor;
-            _actors[indexOfActor] = convertActorIDAndVersionToActor(FF_ACTOR_INVALID, FF_ACTOR_MAX_VERSION);
+            swapRemove(index);
         }
-        _emptySpots++;
     }
     void FamilyActorSet::removeAllActors() {
-        _actors.back() = convertActorIDAndVersionToActor(FF_ACTOR_INVALID, FF_ACTOR_MAX_VERSION);
-        for(int i = 0; i < _actors.size() - 1; i++) {
-            _actors[i] = convertActorIDAndVersionToActor(i + 1, FF_ACTOR_MAX_VERSION);
+        for(auto& actor : _actors) {
+            if(isActorNull(actor)) {
+                continue;
+            }
+            _actorIndices[convertActorToID(actor)] = FF_ACTOR_INVALID;
+            if(_iterationDepth > 0) {
+                actor = NullActor;
+                _pendingRemovalCount++;
+            }
+        }
+        if(_iterationDepth == 0) {
+            _actors.clear();
         }
     }
     bool FamilyActorSet::hasActor(const Actor_t& actor) const {
-        return std::find(_actors.begin(), _actors.end(), actor) != _actors.end();
+        ActorID actorID = convertActorToID(actor);
+        return actorID < _actorIndices.size()
+            && _actorIndices[actorID] != FF_ACTOR_INVALID
+            && _actors[_actorIndices[actorID]] == actor;
+    }
+
+    void FamilyActorSet::each(const std::function<void(Actor_t)>& iterFn) {
+        // Only actors present at the start are visited; anything added during
+        // iteration is appended past `size`.
+        _iterationDepth++;
+        for(size_t i = _actors.size(); i-- > 0;) {
+            if(isActorNull(_actors[i])) {
+                continue;
+            }
+            iterFn(_actors[i]);
+        }
+        _iterationDepth--;
+
+        if(_iterationDepth == 0 && _pendingRemovalCount > 0) {
+            compact();
+        }
+    }
+    size_t FamilyActorSet::getPartitionCount() const {
+        return _actors.size();
+    }
+    void FamilyActorSet::eachInPartitions(const size_t& begin, const size_t& end, const std::function<void(Actor_t)>& iterFn) const {
+        for(size_t i = begin; i < end; ++i) {
+            if(!isActorNull(_actors[i])) {
+                iterFn(_actors[i]);
+            }
+        }
+    }
+    int FamilyActorSet::count() const {
+        return (int)(_actors.size() - _pendingRemovalCount);
     }
 
     const IterableActorSet& FamilyActorSet::getActors() const {
         return _iterableActors;
     }
+
+    void FamilyActorSet::swapRemove(const uint32_t& index) {
+        if(index != _actors.size() - 1) {
+            _actors[index] = _actors.back();
+            _actorIndices[convertActorToID(_actors[index])] = index;
+        }
+        _actors.pop_back();
+    }
+    void FamilyActorSet::compact() {
+        for(size_t i = _actors.size(); i-- > 0;) {
+            if(isActorNull(_actors[i])) {
+                swapRemove((uint32_t)i);
+            }
+        }
+        _pendingRemovalCount = 0;
+    }
 }
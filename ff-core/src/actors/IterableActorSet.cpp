@@ -7,6 +7,7 @@
 #include <ff/actors/IterableActorSet.hpp>
 
 #include <ff/actors/ActorManager.hpp>
+#include <ff/actors/FamilyActorSet.hpp>
 
 namespace ff {
     IterableActorSet::IterableActorSet(ActorManager* const& actorManagerPtr,
@@ -14,12 +15,24 @@ namespace ff {
         uint32_t* const& deletedActorCount)
         :_actorManagerPtr(actorManagerPtr),
         _actors(actorListPtr),
-        _deletedActorCount(deletedActorCount) {
+        _deletedActorCount(deletedActorCount),
+        _familyActorSetPtr(nullptr) {
+    }
+    IterableActorSet::IterableActorSet(FamilyActorSet* const& familyActorSetPtr)
+        :_actorManagerPtr(nullptr),
+        _actors(nullptr),
+        _deletedActorCount(nullptr),
+        _familyActorSetPtr(familyActorSetPtr) {
     }
     IterableActorSet::~IterableActorSet() {
     }
 
     void IterableActorSet::each(const std::function<void(Actor_t)>& iterFn) const {
+        if(_familyActorSetPtr != nullptr) {
+            _familyActorSetPtr->each(iterFn);
+            return;
+        }
+
         // Cases we need to consider which may invalidate iterators or component addresses:
         // 1) Actor created
         // - ActorManager _actors will could be reallocated, but since we are looping with indices we are okay,
@@ -43,10 +56,34 @@ namespace ff {
             iterFn((*_actors)[i]);
         }
     }
+    size_t IterableActorSet::getPartitionCount() const {
+        if(_familyActorSetPtr != nullptr) {
+            return _familyActorSetPtr->getPartitionCount();
+        }
+        return _actors->size();
+    }
+    void IterableActorSet::eachInPartitions(const size_t& begin, const size_t& end, const std::function<void(Actor_t)>& iterFn) const {
+        if(_familyActorSetPtr != nullptr) {
+            _familyActorSetPtr->eachInPartitions(begin, end, iterFn);
+            return;
+        }
+
+        for(size_t i = begin; i < end; ++i) {
+            if(_actorManagerPtr->isActorValid((*_actors)[i])) {
+                iterFn((*_actors)[i]);
+            }
+        }
+    }
     bool IterableActorSet::contains(const Actor_t& actor) const {
-        return std::find(_actors->begin(), _actors->end(), actor) != _actors->end();
+        if(_familyActorSetPtr != nullptr) {
+            return _familyActorSetPtr->hasActor(actor);
+        }
+        return _actorManagerPtr->isActorAlive(actor);
     }
     int IterableActorSet::count() const {
+        if(_familyActorSetPtr != nullptr) {
+            return _familyActorSetPtr->count();
+        }
         return (int)(_actors->size() - (_deletedActorCount == nullptr ? 0 : *_deletedActorCount));
     }
 }
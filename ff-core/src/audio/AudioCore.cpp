@@ -12,6 +12,7 @@
 #include <ff/Locator.hpp>
 
 #include <cstring>
+#include <algorithm>
 
 #include <glm/glm.hpp>
 
@@ -20,15 +21,24 @@
 #include <ff/events/audio/AudioSourceInactiveEvent.hpp>
 
 namespace ff {
-    AudioCore::AudioCore() {
+    AudioCore::AudioCore()
+        :_masterVolumeCVar("audio_master_volume") {
     }
     AudioCore::~AudioCore() {
     }
 
+    AudioCore::PlayingSource::PlayingSource(std::shared_ptr<AudioSource> const& source)
+        :source(source)
+        ,inactiveEventState(InactiveEventState::NOT_SENT) {
+    }
+
     std::unique_ptr<typename PlayAudioSourceCmd::Ret> AudioCore::handleCmd(PlayAudioSourceCmd const& cmd) {
         _sourcesMutex.lock();
-        if(std::find(_sources.begin(), _sources.end(), cmd.audioSource) == _sources.end()) {
-            _sources.push_back(cmd.audioSource);
+        auto it = std::find_if(_sources.begin(), _sources.end(), [&cmd](std::shared_ptr<PlayingSource> const& playing) -> bool {
+            return playing->source == cmd.audioSource;
+        });
+        if(it == _sources.end()) {
+            _sources.push_back(std::make_shared<PlayingSource>(cmd.audioSource));
         }
         _sourcesMutex.unlock();
 
@@ -36,7 +46,9 @@ namespace ff {
     }
     std::unique_ptr<typename StopAudioSourceCmd::Ret> AudioCore::handleCmd(StopAudioSourceCmd const& cmd) {
         _sourcesMutex.lock();
-        auto it = std::find(_sources.begin(), _sources.end(), cmd.audioSource);
+        auto it = std::find_if(_sources.begin(), _sources.end(), [&cmd](std::shared_ptr<PlayingSource> const& playing) -> bool {
+            return playing->source == cmd.audioSource;
+        });
         if(it != _sources.end()) {
             _sources.erase(it);
         }
@@ -62,13 +74,15 @@ namespace ff {
 
         _sourcesMutex.lock();
         // @todo Not ideal vvvvvv
-        std::vector<std::shared_ptr<AudioSource>> sources = _sources; // Make copy so we can release the unlock the mutex ASAP (not actually ideal :-/)
+        std::vector<std::shared_ptr<PlayingSource>> sources = _sources; // Make copy so we can release the unlock the mutex ASAP (not actually ideal :-/)
         _sourcesMutex.unlock();
         if(sources.size() > 0) {
             for(auto it = sources.begin();
                 it != sources.end();
                 it++) {
-                std::shared_ptr<AudioSource> source = *it;
+                PlayingSource& playing = **it;
+                std::shared_ptr<AudioSource> const& source = playing.source;
+                bool const wasActive = source->getStatus() != AudioSourceStatus::INACTIVE;
 
                 int start = 0;
                 unsigned long sourceFrames = 0;
@@ -89,15 +103,30 @@ namespace ff {
                         break;
                     }
                 }
+
+                // Fast path: post the event as soon as the source finishes. If the
+                // post is dropped, hand the event back to `onUpdate`.
+                InactiveEventState notSent = InactiveEventState::NOT_SENT;
+                if(wasActive
+                    && source->getStatus() == AudioSourceStatus::INACTIVE
+                    && playing.inactiveEventState.compare_exchange_strong(notSent, InactiveEventState::POSTING)) {
+                    bool const posted = Locator::getMessageBus().post<AudioSourceInactiveEvent>(source);
+                    playing.inactiveEventState.store(posted ? InactiveEventState::SENT : InactiveEventState::NOT_SENT);
+                }
             }
         }
 
+        float const masterVolume = _masterVolumeCVar.get();
         for(int i = 0; i < samplesPerChannel * AUDIO_CORE_CHANNELS; i++) {
-            buffer[i] *= ff::CVars::get<float>("audio_master_volume");
+            buffer[i] *= masterVolume;
         }
     }
 
     void AudioCore::onInitialize() {
+        // Resolve the handle before the backend starts calling `bufferFrames`
+        // from the audio thread.
+        _masterVolumeCVar.get();
+
         Locator::getMessageBus().addHandler<PlayAudioSourceCmd>(this);
         Locator::getMessageBus().addHandler<StopAudioSourceCmd>(this);
         //Locator::getMessageBus().addListener<EnvPrepareForSuspendCommand>(this);
@@ -109,17 +138,26 @@ namespace ff {
     }
     void AudioCore::onUpdate(const float& dt) {
         _sourcesMutex.lock();
-        for(size_t i = 0; i < _sources.size(); i++) {
-            if(_sources[i] == nullptr) {
-                auto it = _sources.begin() + i--;
-                _sources.erase(it);
+        _sources.erase(std::remove_if(_sources.begin(),
+            _sources.end(),
+            [](std::shared_ptr<PlayingSource> const& playing) -> bool {
+            if(playing->source == nullptr) {
+                return true;
             }
-            if(_sources[i]->getStatus() == AudioSourceStatus::INACTIVE) {
-                auto it = _sources.begin() + i--;
-                Locator::getMessageBus().dispatch<AudioSourceInactiveEvent>(*it);
-                _sources.erase(it);
+            if(playing->source->getStatus() != AudioSourceStatus::INACTIVE) {
+                return false;
             }
-        }
+
+            // Send the event for sources `bufferFrames` didn't post for (e.g.
+            // already inactive when played, or the post was dropped). Sources
+            // the audio thread is still posting for are kept until next update.
+            InactiveEventState notSent = InactiveEventState::NOT_SENT;
+            if(playing->inactiveEventState.compare_exchange_strong(notSent, InactiveEventState::SENT)) {
+                Locator::getMessageBus().enqueue<AudioSourceInactiveEvent>(playing->source);
+                return true;
+            }
+            return notSent == InactiveEventState::SENT;
+        }), _sources.end());
         _sourcesMutex.unlock();
 
         ff::Locator::getAudioBackend().update(dt);
@@ -0,0 +1,132 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <ff/collision/Collision2DBatch.hpp>
+
+#include <algorithm>
+
+// SSE2 and AArch64 NEON are always available on the platforms they exist on,
+// so neither needs a runtime check
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FF_COLLISION_2D_BATCH_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define FF_COLLISION_2D_BATCH_NEON
+#include <arm_neon.h>
+#endif
+
+namespace ff {
+    namespace {
+        inline void setBits(uint32_t* const& masks, const size_t& index, const uint32_t& bits) {
+            masks[index / FF_COLLISION_2D_BATCH_MASK_BITS] |= bits << (index % FF_COLLISION_2D_BATCH_MASK_BITS);
+        }
+
+#if defined(FF_COLLISION_2D_BATCH_NEON)
+        inline uint32_t getLaneBits(const uint32x4_t& lanes) {
+            static uint32_t const laneBits[4] = { 1, 2, 4, 8 };
+            return vaddvq_u32(vandq_u32(lanes, vld1q_u32(laneBits)));
+        }
+#endif
+    }
+
+    namespace Collision2DBatch {
+        void overlapAABBs(const glm::vec2& min, const glm::vec2& max,
+            const float* const& minX, const float* const& minY, const float* const& maxX, const float* const& maxY, const size_t& count,
+            uint32_t* const& masks) {
+            std::fill(masks, masks + getMaskWordCount(count), 0);
+
+            size_t i = 0;
+#if defined(FF_COLLISION_2D_BATCH_SSE2)
+            __m128 const queryMinX = _mm_set1_ps(min.x), queryMinY = _mm_set1_ps(min.y);
+            __m128 const queryMaxX = _mm_set1_ps(max.x), queryMaxY = _mm_set1_ps(max.y);
+            for(; i + 4 <= count; i += 4) {
+                __m128 const overlapX = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minX + i), queryMaxX), _mm_cmpge_ps(_mm_loadu_ps(maxX + i), queryMinX));
+                __m128 const overlapY = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minY + i), queryMaxY), _mm_cmpge_ps(_mm_loadu_ps(maxY + i), queryMinY));
+                setBits(masks, i, (uint32_t)_mm_movemask_ps(_mm_and_ps(overlapX, overlapY)));
+            }
+#elif defined(FF_COLLISION_2D_BATCH_NEON)
+            float32x4_t const queryMinX = vdupq_n_f32(min.x), queryMinY = vdupq_n_f32(min.y);
+            float32x4_t const queryMaxX = vdupq_n_f32(max.x), queryMaxY = vdupq_n_f32(max.y);
+            for(; i + 4 <= count; i += 4) {
+                uint32x4_t const overlapX = vandq_u32(vcleq_f32(vld1q_f32(minX + i), queryMaxX), vcgeq_f32(vld1q_f32(maxX + i), queryMinX));
+                uint32x4_t const overlapY = vandq_u32(vcleq_f32(vld1q_f32(minY + i), queryMaxY), vcgeq_f32(vld1q_f32(maxY + i), queryMinY));
+                setBits(masks, i, getLaneBits(vandq_u32(overlapX, overlapY)));
+            }
+#endif
+            for(; i < count; ++i) {
+                bool const overlaps = minX[i] <= max.x && maxX[i] >= min.x
+                    && minY[i] <= max.y && maxY[i] >= min.y;
+                setBits(masks, i, overlaps ? 1 : 0);
+            }
+        }
+
+        void overlapCircles(const glm::vec2& center, const float& radius,
+            const float* const& centerX, const float* const& centerY, const float* const& radii, const size_t& count,
+            uint32_t* const& masks) {
+            std::fill(masks, masks + getMaskWordCount(count), 0);
+
+            size_t i = 0;
+#if defined(FF_COLLISION_2D_BATCH_SSE2)
+            __m128 const queryX = _mm_set1_ps(center.x), queryY = _mm_set1_ps(center.y), queryRadius = _mm_set1_ps(radius);
+            for(; i + 4 <= count; i += 4) {
+                __m128 const deltaX = _mm_sub_ps(_mm_loadu_ps(centerX + i), queryX);
+                __m128 const deltaY = _mm_sub_ps(_mm_loadu_ps(centerY + i), queryY);
+                __m128 const distanceSquared = _mm_add_ps(_mm_mul_ps(deltaX, deltaX), _mm_mul_ps(deltaY, deltaY));
+                __m128 const radiusSum = _mm_add_ps(_mm_loadu_ps(radii + i), queryRadius);
+                setBits(masks, i, (uint32_t)_mm_movemask_ps(_mm_cmplt_ps(distanceSquared, _mm_mul_ps(radiusSum, radiusSum))));
+            }
+#elif defined(FF_COLLISION_2D_BATCH_NEON)
+            float32x4_t const queryX = vdupq_n_f32(center.x), queryY = vdupq_n_f32(center.y), queryRadius = vdupq_n_f32(radius);
+            for(; i + 4 <= count; i += 4) {
+                float32x4_t const deltaX = vsubq_f32(vld1q_f32(centerX + i), queryX);
+                float32x4_t const deltaY = vsubq_f32(vld1q_f32(centerY + i), queryY);
+                float32x4_t const distanceSquared = vaddq_f32(vmulq_f32(deltaX, deltaX), vmulq_f32(deltaY, deltaY));
+                float32x4_t const radiusSum = vaddq_f32(vld1q_f32(radii + i), queryRadius);
+                setBits(masks, i, getLaneBits(vcltq_f32(distanceSquared, vmulq_f32(radiusSum, radiusSum))));
+            }
+#endif
+            for(; i < count; ++i) {
+                float const deltaX = centerX[i] - center.x;
+                float const deltaY = centerY[i] - center.y;
+                float const radiusSum = radii[i] + radius;
+                setBits(masks, i, deltaX * deltaX + deltaY * deltaY < radiusSum * radiusSum ? 1 : 0);
+            }
+        }
+    }
+
+    void Collision2DBounds::push_back(const glm::vec2& min, const glm::vec2& max) {
+        _minX.push_back(min.x);
+        _minY.push_back(min.y);
+        _maxX.push_back(max.x);
+        _maxY.push_back(max.y);
+    }
+    void Collision2DBounds::set(const size_t& index, const glm::vec2& min, const glm::vec2& max) {
+        _minX[index] = min.x;
+        _minY[index] = min.y;
+        _maxX[index] = max.x;
+        _maxY[index] = max.y;
+    }
+    void Collision2DBounds::swapRemove(const size_t& index) {
+        for(std::vector<float>* coordinates : { &_minX, &_minY, &_maxX, &_maxY }) {
+            (*coordinates)[index] = coordinates->back();
+            coordinates->pop_back();
+        }
+    }
+    void Collision2DBounds::clear() {
+        _minX.clear();
+        _minY.clear();
+        _maxX.clear();
+        _maxY.clear();
+    }
+    size_t Collision2DBounds::size() const {
+        return _minX.size();
+    }
+
+    void Collision2DBounds::overlap(const glm::vec2& min, const glm::vec2& max, const size_t& begin, const size_t& count, uint32_t* const& masks) const {
+        Collision2DBatch::overlapAABBs(min, max,
+            _minX.data() + begin, _minY.data() + begin, _maxX.data() + begin, _maxY.data() + begin, count, masks);
+    }
+}
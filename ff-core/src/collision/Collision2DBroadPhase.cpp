@@ -0,0 +1,68 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <ff/collision/Collision2DBroadPhase.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace ff {
+    Collision2DBroadPhase::~Collision2DBroadPhase() {
+    }
+
+    void Collision2DBroadPhase::queryRay(const glm::vec2& from, const glm::vec2& to, std::vector<Collision2DProxy>& proxies) const {
+        size_t const begin = proxies.size();
+        queryRayCandidates(from, to, proxies);
+
+        std::vector<std::pair<float, Collision2DProxy>> hits;
+        hits.reserve(proxies.size() - begin);
+        for(size_t i = begin; i < proxies.size(); ++i) {
+            Rectangle const aabb = getAABB(proxies[i]);
+            float fraction;
+            if(intersectsSegment(aabb.getBottomLeft(), aabb.getTopRight(), from, to, fraction)) {
+                hits.emplace_back(fraction, proxies[i]);
+            }
+        }
+        std::sort(hits.begin(), hits.end());
+
+        proxies.resize(begin);
+        for(auto const& hit : hits) {
+            proxies.push_back(hit.second);
+        }
+    }
+
+    bool Collision2DBroadPhase::intersectsSegment(const glm::vec2& min, const glm::vec2& max,
+        const glm::vec2& from, const glm::vec2& to, float& fraction) {
+        glm::vec2 const delta = to - from;
+        float enter = 0.0f;
+        float exit = 1.0f;
+        for(int axis = 0; axis < 2; ++axis) {
+            if(delta[axis] == 0.0f) {
+                if(from[axis] < min[axis] || from[axis] > max[axis]) {
+                    return false;
+                }
+                continue;
+            }
+
+            float slabEnter = (min[axis] - from[axis]) / delta[axis];
+            float slabExit = (max[axis] - from[axis]) / delta[axis];
+            if(slabEnter > slabExit) {
+                std::swap(slabEnter, slabExit);
+            }
+            enter = std::max(enter, slabEnter);
+            exit = std::min(exit, slabExit);
+            if(enter > exit) {
+                return false;
+            }
+        }
+        fraction = enter;
+        return true;
+    }
+
+    void Collision2DBroadPhase::queryRayCandidates(const glm::vec2& from, const glm::vec2& to, std::vector<Collision2DProxy>& proxies) const {
+        query(Rectangle(glm::min(from, to), glm::max(from, to)), proxies);
+    }
+}
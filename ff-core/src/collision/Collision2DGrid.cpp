@@ -0,0 +1,221 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <ff/collision/Collision2DGrid.hpp>
+
+#include <ff/Console.hpp>
+
+#include <algorithm>
+
+namespace ff {
+    Collision2DGrid::Collision2DGrid(const float& cellSize)
+        :_cellSize(cellSize) {
+        FF_ASSERT(cellSize > 0, "Collision grid cell size must be positive.");
+    }
+    Collision2DGrid::~Collision2DGrid() {
+    }
+
+    Collision2DProxy Collision2DGrid::createProxy(const Rectangle& aabb, const Actor_t& actor) {
+        Collision2DProxy proxy;
+        if(!_freeProxies.empty()) {
+            proxy = _freeProxies.back();
+            _freeProxies.pop_back();
+        } else {
+            proxy = (Collision2DProxy)_proxies.size();
+            _proxies.emplace_back();
+        }
+
+        Proxy& proxyData = _proxies[proxy];
+        proxyData.min = aabb.getBottomLeft();
+        proxyData.max = aabb.getTopRight();
+        proxyData.actor = actor;
+        insertIntoCells(proxy);
+        return proxy;
+    }
+    void Collision2DGrid::moveProxy(const Collision2DProxy& proxy, const Rectangle& aabb) {
+        FF_ASSERT(proxy < _proxies.size() && _proxies[proxy].actor != NullActor, "Invalid collision proxy %s.", proxy);
+
+        Proxy& proxyData = _proxies[proxy];
+        proxyData.min = aabb.getBottomLeft();
+        proxyData.max = aabb.getTopRight();
+
+        glm::ivec2 cellMin, cellMax;
+        computeCellRange(proxyData.min, proxyData.max, cellMin, cellMax);
+        if(cellMin != proxyData.cellMin || cellMax != proxyData.cellMax) {
+            removeFromCells(proxy);
+            insertIntoCells(proxy);
+            return;
+        }
+
+        // Still in the same cells, but their copies of the bounds are stale
+        if(proxyData.oversized) {
+            _oversizedCell.bounds.set(findProxy(_oversizedCell, proxy), proxyData.min, proxyData.max);
+            return;
+        }
+        for(int y = cellMin.y; y <= cellMax.y; ++y) {
+            for(int x = cellMin.x; x <= cellMax.x; ++x) {
+                Cell& cell = _cells.at(getCellKey(x, y));
+                cell.bounds.set(findProxy(cell, proxy), proxyData.min, proxyData.max);
+            }
+        }
+    }
+    void Collision2DGrid::destroyProxy(const Collision2DProxy& proxy) {
+        FF_ASSERT(proxy < _proxies.size() && _proxies[proxy].actor != NullActor, "Invalid collision proxy %s.", proxy);
+
+        removeFromCells(proxy);
+        _proxies[proxy].actor = NullActor;
+        _freeProxies.push_back(proxy);
+    }
+    void Collision2DGrid::clear() {
+        _proxies.clear();
+        _freeProxies.clear();
+        _cells.clear();
+        _oversizedCell.proxies.clear();
+        _oversizedCell.bounds.clear();
+    }
+
+    Rectangle Collision2DGrid::getAABB(const Collision2DProxy& proxy) const {
+        return Rectangle(_proxies[proxy].min, _proxies[proxy].max);
+    }
+    const Actor_t& Collision2DGrid::getActor(const Collision2DProxy& proxy) const {
+        return _proxies[proxy].actor;
+    }
+    size_t Collision2DGrid::getProxyCapacity() const {
+        return _proxies.size();
+    }
+    size_t Collision2DGrid::getProxyCount() const {
+        return _proxies.size() - _freeProxies.size();
+    }
+
+    void Collision2DGrid::query(const Rectangle& aabb, std::vector<Collision2DProxy>& proxies) const {
+        glm::vec2 const& min = aabb.getBottomLeft();
+        glm::vec2 const& max = aabb.getTopRight();
+
+        size_t const begin = proxies.size();
+        queryCell(_oversizedCell, min, max, proxies);
+
+        glm::ivec2 cellMin, cellMax;
+        computeCellRange(min, max, cellMin, cellMax);
+        if(isOversized(cellMin, cellMax)) {
+            // Scanning every proxy is cheaper than visiting this many cells
+            for(Collision2DProxy proxy = 0; proxy < _proxies.size(); ++proxy) {
+                Proxy const& proxyData = _proxies[proxy];
+                if(proxyData.actor != NullActor && !proxyData.oversized
+                    && proxyData.min.x <= max.x && proxyData.max.x >= min.x
+                    && proxyData.min.y <= max.y && proxyData.max.y >= min.y) {
+                    proxies.push_back(proxy);
+                }
+            }
+        } else {
+            for(int y = cellMin.y; y <= cellMax.y; ++y) {
+                for(int x = cellMin.x; x <= cellMax.x; ++x) {
+                    auto it = _cells.find(getCellKey(x, y));
+                    if(it != _cells.end()) {
+                        queryCell(it->second, min, max, proxies);
+                    }
+                }
+            }
+        }
+
+        // Proxies covering several of the queried cells were added once per cell
+        std::sort(proxies.begin() + begin, proxies.end());
+        proxies.erase(std::unique(proxies.begin() + begin, proxies.end()), proxies.end());
+    }
+
+    const float& Collision2DGrid::getCellSize() const {
+        return _cellSize;
+    }
+    void Collision2DGrid::setCellSize(const float& cellSize) {
+        FF_ASSERT(cellSize > 0, "Collision grid cell size must be positive.");
+        if(cellSize == _cellSize) {
+            return;
+        }
+
+        _cellSize = cellSize;
+        _cells.clear();
+        _oversizedCell.proxies.clear();
+        _oversizedCell.bounds.clear();
+        for(Collision2DProxy proxy = 0; proxy < _proxies.size(); ++proxy) {
+            if(_proxies[proxy].actor != NullActor) {
+                insertIntoCells(proxy);
+            }
+        }
+    }
+
+    void Collision2DGrid::insertIntoCells(const Collision2DProxy& proxy) {
+        Proxy& proxyData = _proxies[proxy];
+        computeCellRange(proxyData.min, proxyData.max, proxyData.cellMin, proxyData.cellMax);
+        proxyData.oversized = isOversized(proxyData.cellMin, proxyData.cellMax);
+        if(proxyData.oversized) {
+            _oversizedCell.proxies.push_back(proxy);
+            _oversizedCell.bounds.push_back(proxyData.min, proxyData.max);
+            return;
+        }
+
+        for(int y = proxyData.cellMin.y; y <= proxyData.cellMax.y; ++y) {
+            for(int x = proxyData.cellMin.x; x <= proxyData.cellMax.x; ++x) {
+                Cell& cell = _cells[getCellKey(x, y)];
+                cell.proxies.push_back(proxy);
+                cell.bounds.push_back(proxyData.min, proxyData.max);
+            }
+        }
+    }
+    void Collision2DGrid::removeFromCells(const Collision2DProxy& proxy) {
+        Proxy const& proxyData = _proxies[proxy];
+        auto const erase = [&proxy](Cell& cell) {
+            size_t const index = findProxy(cell, proxy);
+            cell.proxies[index] = cell.proxies.back();
+            cell.proxies.pop_back();
+            cell.bounds.swapRemove(index);
+        };
+        if(proxyData.oversized) {
+            erase(_oversizedCell);
+            return;
+        }
+
+        for(int y = proxyData.cellMin.y; y <= proxyData.cellMax.y; ++y) {
+            for(int x = proxyData.cellMin.x; x <= proxyData.cellMax.x; ++x) {
+                auto it = _cells.find(getCellKey(x, y));
+                FF_ASSERT(it != _cells.end(), "Collision proxy %s missing from its cell.", proxy);
+                erase(it->second);
+                if(it->second.proxies.empty()) {
+                    _cells.erase(it);
+                }
+            }
+        }
+    }
+    void Collision2DGrid::computeCellRange(const glm::vec2& min, const glm::vec2& max, glm::ivec2& cellMin, glm::ivec2& cellMax) const {
+        // Clamped so that far away (or infinite) bounds can't overflow the cell coordinates
+        glm::vec2 const limit(1 << 30);
+        cellMin = glm::ivec2(glm::clamp(glm::floor(min / _cellSize), -limit, limit));
+        cellMax = glm::ivec2(glm::clamp(glm::floor(max / _cellSize), -limit, limit));
+    }
+    bool Collision2DGrid::isOversized(const glm::ivec2& cellMin, const glm::ivec2& cellMax) const {
+        int64_t const cellCount = ((int64_t)cellMax.x - cellMin.x + 1) * ((int64_t)cellMax.y - cellMin.y + 1);
+        return cellCount > FF_COLLISION_2D_GRID_MAX_CELLS_PER_PROXY;
+    }
+
+    uint64_t Collision2DGrid::getCellKey(const int& x, const int& y) {
+        return ((uint64_t)(uint32_t)x << 32) | (uint64_t)(uint32_t)y;
+    }
+    size_t Collision2DGrid::findProxy(const Cell& cell, const Collision2DProxy& proxy) {
+        auto it = std::find(cell.proxies.begin(), cell.proxies.end(), proxy);
+        FF_ASSERT(it != cell.proxies.end(), "Collision proxy %s not found.", proxy);
+        return it - cell.proxies.begin();
+    }
+    void Collision2DGrid::queryCell(const Cell& cell, const glm::vec2& min, const glm::vec2& max, std::vector<Collision2DProxy>& proxies) {
+        // Tested in chunks so the masks fit on the stack
+        constexpr size_t chunkSize = 8 * FF_COLLISION_2D_BATCH_MASK_BITS;
+        uint32_t masks[chunkSize / FF_COLLISION_2D_BATCH_MASK_BITS];
+        for(size_t begin = 0; begin < cell.proxies.size(); begin += chunkSize) {
+            size_t const count = std::min(chunkSize, cell.proxies.size() - begin);
+            cell.bounds.overlap(min, max, begin, count, masks);
+            Collision2DBatch::forEachSetBit(masks, Collision2DBatch::getMaskWordCount(count), [&](const size_t& index) {
+                proxies.push_back(cell.proxies[begin + index]);
+            });
+        }
+    }
+}
@@ -0,0 +1,404 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <ff/collision/Collision2DNarrowPhase.hpp>
+
+#include <ff/Console.hpp>
+#include <ff/math/VectorHelper.hpp>
+#include <ff/math/Circle.hpp>
+
+#include <limits>
+#include <utility>
+
+namespace ff {
+    namespace {
+        typedef bool (*ShapeTest)(const Collision2DWorldShape& shapeA, glm::vec2& normA,
+            const Collision2DWorldShape& shapeB, glm::vec2& normB, float& penetration);
+        typedef bool (*ShapeSweep)(const Collision2DWorldShape& shapeA, const glm::vec2& displacement,
+            const Collision2DWorldShape& shapeB, float& fraction, glm::vec2& normA);
+
+        glm::vec2 computeSupport(const glm::vec2* const& verts, const size_t& vertCount, const glm::vec2& dir) {
+            float bestProjection = -std::numeric_limits<float>::max();
+            glm::vec2 bestVertex;
+
+            for(size_t i = 0; i < vertCount; i++) {
+                const glm::vec2& v = verts[i];
+                float projection = glm::dot(v, dir);
+
+                if(projection > bestProjection) {
+                    bestProjection = projection;
+                    bestVertex = v;
+                }
+            }
+
+            return bestVertex;
+        }
+        float findAxisOfLeastPenetration(size_t& faceIndex, const Collision2DWorldShape& polygonA, const Collision2DWorldShape& polygonB) {
+            float bestDistance = -std::numeric_limits<float>::max();
+            size_t bestIndex = 0;
+
+            for(size_t i = 0; i < polygonA.vertexCount; i++) {
+                const glm::vec2& n = polygonA.normals[i];
+
+                // Support point from B along -n
+                glm::vec2 sB = computeSupport(polygonB.vertices, polygonB.vertexCount, -n);
+
+                glm::vec2 vA = polygonA.vertices[i];
+
+                // Compute penetration distance
+                float d = glm::dot(n, sB - vA);
+
+                // Find greatest distance
+                if(d > bestDistance) {
+                    bestDistance = d;
+                    bestIndex = i;
+                }
+            }
+
+            faceIndex = bestIndex;
+            return bestDistance;
+        }
+
+        bool testCircleCircle(const Collision2DWorldShape& circleA, glm::vec2& normA,
+            const Collision2DWorldShape& circleB, glm::vec2& normB, float& penetration) {
+            glm::vec2 const& posA = circleA.position;
+            glm::vec2 const& posB = circleB.position;
+            float const distance = glm::distance(posB, posA);
+            bool colliding = distance < circleB.radius + circleA.radius;
+            if(colliding) {
+                if(distance > 0) {
+                    normA = glm::normalize(posB - posA);
+                    normB = -normA;
+                } else {
+                    normA = normB = glm::vec2(0, 0);
+                }
+                penetration = (circleA.radius + circleB.radius) - distance;
+            }
+            return colliding;
+        }
+        bool testPolygonCircle(const Collision2DWorldShape& polygonA, glm::vec2& normA,
+            const Collision2DWorldShape& circleB, glm::vec2& normB, float& penetration) {
+            glm::vec2 const* const worldPolyA = polygonA.vertices;
+            size_t const worldPolyASize = polygonA.vertexCount;
+            glm::vec2 const& posB = circleB.position;
+
+            Circle worldCircleB(posB, circleB.radius);
+
+            glm::vec2 closestV1, closestV2;
+            size_t closestFace = 0;
+            float closestDistanceToCircle = -1;
+            // Whether the circle's center is behind every face
+            bool centerInside = true;
+            glm::vec2 closestVert;
+            float closestVertDistance = -1;
+            for(size_t i = 0; i < worldPolyASize; i++) {
+                glm::vec2 const& v2 = worldPolyA[i];
+
+                // Closest vertex
+                float vertDistanceToCircle = glm::distance(worldCircleB.getPosition(), v2);
+                if(closestVertDistance < 0
+                    || vertDistanceToCircle < closestVertDistance) {
+                    closestVertDistance = vertDistanceToCircle;
+                    closestVert = v2;
+                }
+
+                if(glm::dot(polygonA.normals[i], posB - v2) > 0) {
+                    centerInside = false;
+                }
+
+                // Closest segment
+                size_t j = (i + 1) % worldPolyASize;
+
+                glm::vec2 const& v1 = worldPolyA[j];
+
+                // Distance from circle center to segment
+                float circleOnSegment = glm::dot(worldCircleB.getPosition() - v1, glm::normalize(v2 - v1));
+                float hyp = glm::distance(worldCircleB.getPosition(), v1);
+                float circleToSegment = glm::sqrt(hyp * hyp - circleOnSegment * circleOnSegment);
+
+                if(circleOnSegment > 0 && circleOnSegment < glm::distance(v2, v1)) { // If distance is on segment
+                    if(closestDistanceToCircle < 0 // First loop
+                        || circleToSegment < closestDistanceToCircle) {
+                        closestV1 = v1;
+                        closestV2 = v2;
+                        closestFace = i;
+                        closestDistanceToCircle = circleToSegment;
+                    }
+                }
+            }
+            FF_ASSERT(closestDistanceToCircle >= 0 || closestVertDistance >= 0, "Circle-polygon closest distance to segment/vertex algorithm failed.");
+            if(closestDistanceToCircle >= 0) {
+                // We have the closest segment of the polygon.
+                // Next, find which Voronoi region the circle is in.
+
+                // Cast circle position onto segment
+                glm::vec2 segment = closestV2 - closestV1;
+                glm::vec2 segmentNormalized = glm::normalize(segment);
+                float circleOnSegment = glm::dot(segmentNormalized, worldCircleB.getPosition() - closestV1);
+
+                // If the circle is along the segment, it's on the face
+                // region and we can get the normal.
+                if(circleOnSegment > 0
+                    && circleOnSegment < glm::length(segment)
+                    && (closestDistanceToCircle <= worldCircleB.getRadius() || centerInside)) {
+                    // Find point along segment closest to the circle (perpendicular from segment to circle center)
+                    glm::vec2 intersectionPoint = segmentNormalized * circleOnSegment + closestV1;
+                    // Pointing out of the polygon, even when the circle is inside it
+                    normA = centerInside ? polygonA.normals[closestFace] : glm::normalize(posB - intersectionPoint);
+                    normB = -normA;
+                    penetration = glm::distance(posB, intersectionPoint);
+                    return true;
+                }
+            }
+
+            // Otherwise the closest point of the polygon is its closest vertex
+            if(worldCircleB.contains(closestVert)) {
+                penetration = glm::distance(posB, closestVert);
+                if(penetration > 0) {
+                    normA = glm::normalize(posB - closestVert);
+                    normB = -normA;
+                } else {
+                    normA = normB = glm::vec2(0, 0);
+                }
+                return true;
+            }
+
+            return false;
+        }
+        bool testCirclePolygon(const Collision2DWorldShape& circleA, glm::vec2& normA,
+            const Collision2DWorldShape& polygonB, glm::vec2& normB, float& penetration) {
+            return testPolygonCircle(polygonB, normB, circleA, normA, penetration);
+        }
+        bool testPolygonPolygon(const Collision2DWorldShape& polygonA, glm::vec2& normA,
+            const Collision2DWorldShape& polygonB, glm::vec2& normB, float& penetration) {
+            // A face with no part of the other polygon behind it separates them
+            size_t indexA;
+            float penetrationBA = findAxisOfLeastPenetration(indexA, polygonA, polygonB);
+            if(penetrationBA >= 0) {
+                return false;
+            }
+
+            size_t indexB;
+            float penetrationAB = findAxisOfLeastPenetration(indexB, polygonB, polygonA);
+            if(penetrationAB >= 0) {
+                return false;
+            }
+
+            // The shallowest overlap is the one to resolve along
+            if(penetrationBA > penetrationAB) {
+                penetration = -penetrationBA;
+
+                // Face is on A
+                normA = polygonA.normals[indexA];
+                normB = -normA;
+            } else {
+                penetration = -penetrationAB;
+
+                // Face is on B
+                normB = polygonB.normals[indexB];
+                normA = -normB;
+            }
+            return true;
+        }
+
+        void projectPolygon(const Collision2DWorldShape& polygon, const glm::vec2& axis, float& min, float& max) {
+            min = max = glm::dot(polygon.vertices[0], axis);
+            for(size_t i = 1; i < polygon.vertexCount; i++) {
+                float const projection = glm::dot(polygon.vertices[i], axis);
+                min = glm::min(min, projection);
+                max = glm::max(max, projection);
+            }
+        }
+        float computeSegmentDistanceSquared(const glm::vec2& point, const glm::vec2& v1, const glm::vec2& v2) {
+            glm::vec2 const segment = v2 - v1;
+            float const lengthSquared = glm::dot(segment, segment);
+            float const along = lengthSquared > 0 ? glm::clamp(glm::dot(point - v1, segment) / lengthSquared, 0.0f, 1.0f) : 0.0f;
+            glm::vec2 const delta = point - (v1 + segment * along);
+            return glm::dot(delta, delta);
+        }
+        // The first time in [0, 1] a point moving from `start` enters the circle
+        bool sweepPointCircle(const glm::vec2& start, const glm::vec2& displacement, const glm::vec2& center, const float& radius, float& fraction) {
+            glm::vec2 const offset = start - center;
+            float const a = glm::dot(displacement, displacement);
+            float const b = glm::dot(offset, displacement);
+            float const c = glm::dot(offset, offset) - radius * radius;
+            // Inside already, not moving, or moving away
+            if(c <= 0 || a <= 0 || b >= 0) {
+                return false;
+            }
+            float const discriminant = b * b - a * c;
+            if(discriminant < 0) {
+                return false;
+            }
+            fraction = (-b - glm::sqrt(discriminant)) / a;
+            return fraction <= 1;
+        }
+
+        bool sweepCircleCircle(const Collision2DWorldShape& circleA, const glm::vec2& displacement,
+            const Collision2DWorldShape& circleB, float& fraction, glm::vec2& normA) {
+            if(!sweepPointCircle(circleA.position, displacement, circleB.position, circleA.radius + circleB.radius, fraction)) {
+                return false;
+            }
+            normA = glm::normalize(circleB.position - (circleA.position + displacement * fraction));
+            return true;
+        }
+        bool sweepCirclePolygon(const Collision2DWorldShape& circleA, const glm::vec2& displacement,
+            const Collision2DWorldShape& polygonB, float& fraction, glm::vec2& normA) {
+            // The circle's center against the polygon grown by the radius: its
+            // edges pushed out along their normals, and circles at its vertices
+            glm::vec2 const& center = circleA.position;
+            float const radius = circleA.radius;
+
+            bool inside = true;
+            float distanceSquared = std::numeric_limits<float>::max();
+            for(size_t i = 0; i < polygonB.vertexCount; i++) {
+                glm::vec2 const& v1 = polygonB.vertices[i];
+                glm::vec2 const& v2 = polygonB.vertices[(i + 1) % polygonB.vertexCount];
+                inside = inside && glm::dot(center - v1, polygonB.normals[i]) <= 0;
+                distanceSquared = glm::min(distanceSquared, computeSegmentDistanceSquared(center, v1, v2));
+            }
+            if(inside || distanceSquared < radius * radius) {
+                return false;
+            }
+
+            float bestFraction = std::numeric_limits<float>::max();
+            for(size_t i = 0; i < polygonB.vertexCount; i++) {
+                glm::vec2 const& v1 = polygonB.vertices[i];
+                glm::vec2 const& normal = polygonB.normals[i];
+                float const speed = glm::dot(displacement, normal);
+                if(speed < 0) {
+                    float const edgeFraction = glm::dot(v1 + normal * radius - center, normal) / speed;
+                    glm::vec2 const edge = polygonB.vertices[(i + 1) % polygonB.vertexCount] - v1;
+                    float const along = glm::dot(center + displacement * edgeFraction - v1, edge);
+                    if(edgeFraction >= 0 && edgeFraction < bestFraction
+                        && along >= 0 && along <= glm::dot(edge, edge)) {
+                        bestFraction = edgeFraction;
+                        normA = -normal;
+                    }
+                }
+
+                float vertexFraction;
+                if(sweepPointCircle(center, displacement, v1, radius, vertexFraction) && vertexFraction < bestFraction) {
+                    bestFraction = vertexFraction;
+                    normA = glm::normalize(v1 - (center + displacement * vertexFraction));
+                }
+            }
+            if(bestFraction > 1) {
+                return false;
+            }
+            fraction = bestFraction;
+            return true;
+        }
+        bool sweepPolygonCircle(const Collision2DWorldShape& polygonA, const glm::vec2& displacement,
+            const Collision2DWorldShape& circleB, float& fraction, glm::vec2& normA) {
+            // The circle moving the other way meets the polygon at the same time
+            if(!sweepCirclePolygon(circleB, -displacement, polygonA, fraction, normA)) {
+                return false;
+            }
+            normA = -normA;
+            return true;
+        }
+        bool sweepPolygonPolygon(const Collision2DWorldShape& polygonA, const glm::vec2& displacement,
+            const Collision2DWorldShape& polygonB, float& fraction, glm::vec2& normA) {
+            // The polygons touch once they overlap on every face axis, so the last
+            // axis to start overlapping gives the time and normal
+            float enter = -std::numeric_limits<float>::max();
+            float exit = std::numeric_limits<float>::max();
+            auto sweepAxis = [&](const glm::vec2& axis) {
+                float minA, maxA, minB, maxB;
+                projectPolygon(polygonA, axis, minA, maxA);
+                projectPolygon(polygonB, axis, minB, maxB);
+                float const speed = glm::dot(displacement, axis);
+                if(speed == 0) {
+                    return maxA >= minB && maxB >= minA;
+                }
+                float axisEnter = (minB - maxA) / speed;
+                float axisExit = (maxB - minA) / speed;
+                if(axisEnter > axisExit) {
+                    std::swap(axisEnter, axisExit);
+                }
+                if(axisEnter > enter) {
+                    enter = axisEnter;
+                    normA = speed > 0 ? axis : -axis;
+                }
+                exit = glm::min(exit, axisExit);
+                return enter <= exit;
+            };
+            for(size_t i = 0; i < polygonA.vertexCount; i++) {
+                if(!sweepAxis(polygonA.normals[i])) {
+                    return false;
+                }
+            }
+            for(size_t i = 0; i < polygonB.vertexCount; i++) {
+                if(!sweepAxis(polygonB.normals[i])) {
+                    return false;
+                }
+            }
+            if(enter <= 0 || enter > 1) {
+                return false;
+            }
+            fraction = enter;
+            return true;
+        }
+
+        // Indexed by the types of shape A and shape B
+        constexpr ShapeTest shapeTests[(size_t)Collision2DShapeType::COUNT][(size_t)Collision2DShapeType::COUNT] = {
+            { testCircleCircle, testCirclePolygon },
+            { testPolygonCircle, testPolygonPolygon }
+        };
+        constexpr ShapeSweep shapeSweeps[(size_t)Collision2DShapeType::COUNT][(size_t)Collision2DShapeType::COUNT] = {
+            { sweepCircleCircle, sweepCirclePolygon },
+            { sweepPolygonCircle, sweepPolygonPolygon }
+        };
+    }
+
+    namespace Collision2DNarrowPhase {
+        void computeWorldShape(const Collision2DShape& shape, const float& cos, const float& sin, const float& scale, const glm::vec2& position,
+            Collision2DWorldShape& worldShape) {
+            worldShape.type = shape.getType();
+            worldShape.position = position + VectorHelper::rotate(shape.getOffset(), cos, sin) * scale;
+            worldShape.radius = 0;
+            worldShape.vertexCount = 0;
+            worldShape.min = worldShape.max = worldShape.position;
+
+            switch(shape.getType()) {
+            case Collision2DShapeType::CIRCLE: {
+                CircleCollision2DShape const& circle = static_cast<CircleCollision2DShape const&>(shape);
+                worldShape.radius = circle.getRadius() * scale;
+                worldShape.min = worldShape.position - glm::vec2(worldShape.radius);
+                worldShape.max = worldShape.position + glm::vec2(worldShape.radius);
+                break;
+            }
+            case Collision2DShapeType::POLYGON: {
+                PolygonCollision2DShape const& polygon = static_cast<PolygonCollision2DShape const&>(shape);
+                std::vector<glm::vec2> const& vertices = polygon.getVertices();
+                worldShape.vertexCount = vertices.size();
+                for(size_t i = 0; i < vertices.size(); i++) {
+                    worldShape.vertices[i] = VectorHelper::rotate(vertices[i], cos, sin) * scale + worldShape.position;
+                    worldShape.min = i == 0 ? worldShape.vertices[i] : glm::min(worldShape.min, worldShape.vertices[i]);
+                    worldShape.max = i == 0 ? worldShape.vertices[i] : glm::max(worldShape.max, worldShape.vertices[i]);
+                }
+                for(size_t i = 0; i < vertices.size(); i++) {
+                    worldShape.normals[i] = glm::normalize(VectorHelper::rotate(polygon.getNormals()[i], cos, sin));
+                }
+                break;
+            }
+            default:
+                FF_CONSOLE_ERROR("Unknown 2D collision shape type.");
+                break;
+            }
+        }
+
+        bool testShapes(const Collision2DWorldShape& shapeA, glm::vec2& normA,
+            const Collision2DWorldShape& shapeB, glm::vec2& normB, float& penetration) {
+            return shapeTests[(size_t)shapeA.type][(size_t)shapeB.type](shapeA, normA, shapeB, normB, penetration);
+        }
+        bool sweepShapes(const Collision2DWorldShape& shapeA, const glm::vec2& displacement,
+            const Collision2DWorldShape& shapeB, float& fraction, glm::vec2& normA) {
+            return shapeSweeps[(size_t)shapeA.type][(size_t)shapeB.type](shapeA, displacement, shapeB, fraction, normA);
+        }
+    }
+}
@@ -0,0 +1,338 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <ff/collision/Collision2DTree.hpp>
+
+#include <ff/Console.hpp>
+
+#include <algorithm>
+
+namespace ff {
+    namespace {
+        // Perimeter rather than area, so that thin boxes don't look free to grow
+        float getPerimeter(const glm::vec2& min, const glm::vec2& max) {
+            glm::vec2 const size = max - min;
+            return 2.0f * (size.x + size.y);
+        }
+        float getUnionPerimeter(const glm::vec2& minA, const glm::vec2& maxA, const glm::vec2& minB, const glm::vec2& maxB) {
+            return getPerimeter(glm::min(minA, minB), glm::max(maxA, maxB));
+        }
+        bool overlaps(const glm::vec2& minA, const glm::vec2& maxA, const glm::vec2& minB, const glm::vec2& maxB) {
+            return minA.x <= maxB.x && maxA.x >= minB.x
+                && minA.y <= maxB.y && maxA.y >= minB.y;
+        }
+        bool contains(const glm::vec2& outerMin, const glm::vec2& outerMax, const glm::vec2& innerMin, const glm::vec2& innerMax) {
+            return outerMin.x <= innerMin.x && outerMin.y <= innerMin.y
+                && outerMax.x >= innerMax.x && outerMax.y >= innerMax.y;
+        }
+    }
+
+    Collision2DTree::Collision2DTree(const float& aabbMargin)
+        :_aabbMargin(aabbMargin),
+        _root(FF_COLLISION_2D_NULL_PROXY),
+        _freeNodes(FF_COLLISION_2D_NULL_PROXY),
+        _proxyCount(0) {
+        FF_ASSERT(aabbMargin >= 0, "Collision tree AABB margin must not be negative.");
+    }
+    Collision2DTree::~Collision2DTree() {
+    }
+
+    Collision2DProxy Collision2DTree::createProxy(const Rectangle& aabb, const Actor_t& actor) {
+        Collision2DProxy const proxy = allocateNode();
+        Node& node = _nodes[proxy];
+        node.tightMin = aabb.getBottomLeft();
+        node.tightMax = aabb.getTopRight();
+        node.min = node.tightMin - glm::vec2(_aabbMargin);
+        node.max = node.tightMax + glm::vec2(_aabbMargin);
+        node.actor = actor;
+        node.height = 0;
+        insertLeaf(proxy);
+        _proxyCount++;
+        return proxy;
+    }
+    void Collision2DTree::moveProxy(const Collision2DProxy& proxy, const Rectangle& aabb) {
+        FF_ASSERT(proxy < _nodes.size() && isLeaf(proxy), "Invalid collision proxy %s.", proxy);
+
+        Node& node = _nodes[proxy];
+        node.tightMin = aabb.getBottomLeft();
+        node.tightMax = aabb.getTopRight();
+        if(contains(node.min, node.max, node.tightMin, node.tightMax)) {
+            return;
+        }
+
+        removeLeaf(proxy);
+        _nodes[proxy].min = _nodes[proxy].tightMin - glm::vec2(_aabbMargin);
+        _nodes[proxy].max = _nodes[proxy].tightMax + glm::vec2(_aabbMargin);
+        insertLeaf(proxy);
+    }
+    void Collision2DTree::destroyProxy(const Collision2DProxy& proxy) {
+        FF_ASSERT(proxy < _nodes.size() && isLeaf(proxy), "Invalid collision proxy %s.", proxy);
+
+        removeLeaf(proxy);
+        freeNode(proxy);
+        _proxyCount--;
+    }
+    void Collision2DTree::clear() {
+        _nodes.clear();
+        _root = FF_COLLISION_2D_NULL_PROXY;
+        _freeNodes = FF_COLLISION_2D_NULL_PROXY;
+        _proxyCount = 0;
+    }
+
+    Rectangle Collision2DTree::getAABB(const Collision2DProxy& proxy) const {
+        return Rectangle(_nodes[proxy].tightMin, _nodes[proxy].tightMax);
+    }
+    Rectangle Collision2DTree::getFatAABB(const Collision2DProxy& proxy) const {
+        return Rectangle(_nodes[proxy].min, _nodes[proxy].max);
+    }
+    const Actor_t& Collision2DTree::getActor(const Collision2DProxy& proxy) const {
+        return _nodes[proxy].actor;
+    }
+    size_t Collision2DTree::getProxyCapacity() const {
+        return _nodes.size();
+    }
+    size_t Collision2DTree::getProxyCount() const {
+        return _proxyCount;
+    }
+
+    void Collision2DTree::query(const Rectangle& aabb, std::vector<Collision2DProxy>& proxies) const {
+        if(_root == FF_COLLISION_2D_NULL_PROXY) {
+            return;
+        }
+        glm::vec2 const& min = aabb.getBottomLeft();
+        glm::vec2 const& max = aabb.getTopRight();
+
+        size_t const begin = proxies.size();
+        Collision2DProxy stack[FF_COLLISION_2D_TREE_MAX_DEPTH + 1];
+        int stackSize = 0;
+        stack[stackSize++] = _root;
+        while(stackSize > 0) {
+            Collision2DProxy const index = stack[--stackSize];
+            Node const& node = _nodes[index];
+            if(!overlaps(node.min, node.max, min, max)) {
+                continue;
+            }
+            if(node.height == 0) {
+                if(overlaps(node.tightMin, node.tightMax, min, max)) {
+                    proxies.push_back(index);
+                }
+                continue;
+            }
+            FF_ASSERT(stackSize + 2 <= FF_COLLISION_2D_TREE_MAX_DEPTH + 1, "Collision tree is too deep.");
+            stack[stackSize++] = node.child1;
+            stack[stackSize++] = node.child2;
+        }
+
+        std::sort(proxies.begin() + begin, proxies.end());
+    }
+
+    const float& Collision2DTree::getAABBMargin() const {
+        return _aabbMargin;
+    }
+    void Collision2DTree::setAABBMargin(const float& aabbMargin) {
+        FF_ASSERT(aabbMargin >= 0, "Collision tree AABB margin must not be negative.");
+        _aabbMargin = aabbMargin;
+    }
+    int Collision2DTree::getHeight() const {
+        return _root == FF_COLLISION_2D_NULL_PROXY ? -1 : _nodes[_root].height;
+    }
+
+    void Collision2DTree::queryRayCandidates(const glm::vec2& from, const glm::vec2& to, std::vector<Collision2DProxy>& proxies) const {
+        if(_root == FF_COLLISION_2D_NULL_PROXY) {
+            return;
+        }
+
+        Collision2DProxy stack[FF_COLLISION_2D_TREE_MAX_DEPTH + 1];
+        int stackSize = 0;
+        stack[stackSize++] = _root;
+        while(stackSize > 0) {
+            Collision2DProxy const index = stack[--stackSize];
+            Node const& node = _nodes[index];
+            float fraction;
+            if(!intersectsSegment(node.min, node.max, from, to, fraction)) {
+                continue;
+            }
+            if(node.height == 0) {
+                proxies.push_back(index);
+                continue;
+            }
+            FF_ASSERT(stackSize + 2 <= FF_COLLISION_2D_TREE_MAX_DEPTH + 1, "Collision tree is too deep.");
+            stack[stackSize++] = node.child1;
+            stack[stackSize++] = node.child2;
+        }
+    }
+
+    Collision2DProxy Collision2DTree::allocateNode() {
+        Collision2DProxy node;
+        if(_freeNodes != FF_COLLISION_2D_NULL_PROXY) {
+            node = _freeNodes;
+            _freeNodes = _nodes[node].parent;
+        } else {
+            node = (Collision2DProxy)_nodes.size();
+            _nodes.emplace_back();
+        }
+
+        Node& nodeData = _nodes[node];
+        nodeData.actor = NullActor;
+        nodeData.parent = FF_COLLISION_2D_NULL_PROXY;
+        nodeData.child1 = FF_COLLISION_2D_NULL_PROXY;
+        nodeData.child2 = FF_COLLISION_2D_NULL_PROXY;
+        nodeData.height = 0;
+        return node;
+    }
+    void Collision2DTree::freeNode(const Collision2DProxy& node) {
+        _nodes[node].actor = NullActor;
+        _nodes[node].height = -1;
+        _nodes[node].parent = _freeNodes;
+        _freeNodes = node;
+    }
+
+    void Collision2DTree::insertLeaf(const Collision2DProxy& leaf) {
+        if(_root == FF_COLLISION_2D_NULL_PROXY) {
+            _root = leaf;
+            _nodes[leaf].parent = FF_COLLISION_2D_NULL_PROXY;
+            return;
+        }
+
+        // Descend towards the sibling that grows the tree's total perimeter the least
+        glm::vec2 const leafMin = _nodes[leaf].min;
+        glm::vec2 const leafMax = _nodes[leaf].max;
+        Collision2DProxy sibling = _root;
+        while(!isLeaf(sibling)) {
+            Node const& node = _nodes[sibling];
+            float const perimeter = getPerimeter(node.min, node.max);
+            float const combinedPerimeter = getUnionPerimeter(node.min, node.max, leafMin, leafMax);
+            // Pairing with this node directly
+            float const cost = 2.0f * combinedPerimeter;
+            // Every ancestor of a deeper sibling grows by at least this much
+            float const inheritanceCost = 2.0f * (combinedPerimeter - perimeter);
+
+            auto const getChildCost = [this, &leafMin, &leafMax, &inheritanceCost](const Collision2DProxy& child) {
+                Node const& childNode = _nodes[child];
+                float const childCombinedPerimeter = getUnionPerimeter(childNode.min, childNode.max, leafMin, leafMax);
+                if(childNode.height == 0) {
+                    return childCombinedPerimeter + inheritanceCost;
+                }
+                return childCombinedPerimeter - getPerimeter(childNode.min, childNode.max) + inheritanceCost;
+            };
+            float const cost1 = getChildCost(node.child1);
+            float const cost2 = getChildCost(node.child2);
+            if(cost < cost1 && cost < cost2) {
+                break;
+            }
+            sibling = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        Collision2DProxy const oldParent = _nodes[sibling].parent;
+        Collision2DProxy const newParent = allocateNode();
+        _nodes[newParent].parent = oldParent;
+        _nodes[newParent].child1 = sibling;
+        _nodes[newParent].child2 = leaf;
+        _nodes[sibling].parent = newParent;
+        _nodes[leaf].parent = newParent;
+        if(oldParent == FF_COLLISION_2D_NULL_PROXY) {
+            _root = newParent;
+        } else if(_nodes[oldParent].child1 == sibling) {
+            _nodes[oldParent].child1 = newParent;
+        } else {
+            _nodes[oldParent].child2 = newParent;
+        }
+
+        refit(newParent);
+    }
+    void Collision2DTree::removeLeaf(const Collision2DProxy& leaf) {
+        if(leaf == _root) {
+            _root = FF_COLLISION_2D_NULL_PROXY;
+            return;
+        }
+
+        Collision2DProxy const parent = _nodes[leaf].parent;
+        Collision2DProxy const grandParent = _nodes[parent].parent;
+        Collision2DProxy const sibling = _nodes[parent].child1 == leaf ? _nodes[parent].child2 : _nodes[parent].child1;
+        freeNode(parent);
+
+        _nodes[sibling].parent = grandParent;
+        if(grandParent == FF_COLLISION_2D_NULL_PROXY) {
+            _root = sibling;
+            return;
+        }
+        if(_nodes[grandParent].child1 == parent) {
+            _nodes[grandParent].child1 = sibling;
+        } else {
+            _nodes[grandParent].child2 = sibling;
+        }
+        refit(grandParent);
+    }
+    Collision2DProxy Collision2DTree::balance(const Collision2DProxy& indexA) {
+        Node& a = _nodes[indexA];
+        if(a.height < 2) {
+            return indexA;
+        }
+
+        Collision2DProxy const indexB = a.child1;
+        Collision2DProxy const indexC = a.child2;
+        int const heightDifference = _nodes[indexC].height - _nodes[indexB].height;
+        if(heightDifference >= -1 && heightDifference <= 1) {
+            return indexA;
+        }
+
+        // The taller child takes A's place, A takes the taller child's shorter
+        // child's place, and the shorter child is moved under A
+        bool const rotateC = heightDifference > 1;
+        Collision2DProxy const indexUp = rotateC ? indexC : indexB;
+        Node& up = _nodes[indexUp];
+        Collision2DProxy const indexTall = _nodes[up.child1].height > _nodes[up.child2].height ? up.child1 : up.child2;
+        Collision2DProxy const indexShort = indexTall == up.child1 ? up.child2 : up.child1;
+
+        up.parent = a.parent;
+        if(up.parent == FF_COLLISION_2D_NULL_PROXY) {
+            _root = indexUp;
+        } else if(_nodes[up.parent].child1 == indexA) {
+            _nodes[up.parent].child1 = indexUp;
+        } else {
+            _nodes[up.parent].child2 = indexUp;
+        }
+        up.child1 = indexA;
+        up.child2 = indexTall;
+        a.parent = indexUp;
+        if(rotateC) {
+            a.child2 = indexShort;
+        } else {
+            a.child1 = indexShort;
+        }
+        _nodes[indexShort].parent = indexA;
+
+        Node const& child1 = _nodes[a.child1];
+        Node const& child2 = _nodes[a.child2];
+        a.min = glm::min(child1.min, child2.min);
+        a.max = glm::max(child1.max, child2.max);
+        a.height = 1 + std::max(child1.height, child2.height);
+
+        Node const& tall = _nodes[indexTall];
+        up.min = glm::min(a.min, tall.min);
+        up.max = glm::max(a.max, tall.max);
+        up.height = 1 + std::max(a.height, tall.height);
+        return indexUp;
+    }
+    void Collision2DTree::refit(const Collision2DProxy& node) {
+        Collision2DProxy index = node;
+        while(index != FF_COLLISION_2D_NULL_PROXY) {
+            index = balance(index);
+
+            Node& nodeData = _nodes[index];
+            Node const& child1 = _nodes[nodeData.child1];
+            Node const& child2 = _nodes[nodeData.child2];
+            nodeData.min = glm::min(child1.min, child2.min);
+            nodeData.max = glm::max(child1.max, child2.max);
+            nodeData.height = 1 + std::max(child1.height, child2.height);
+
+            index = nodeData.parent;
+        }
+    }
+    bool Collision2DTree::isLeaf(const Collision2DProxy& node) const {
+        return _nodes[node].height == 0;
+    }
+}
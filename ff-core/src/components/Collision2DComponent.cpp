@@ -6,14 +6,19 @@
 
 #include <ff/components/Collision2DComponent.hpp>
 
+#include <ff/Console.hpp>
 #include <ff/math/VectorHelper.hpp>
 #include <limits>
 
 namespace ff {
-    Collision2DShape::Collision2DShape()
-        :_offset(glm::vec2(0)) {}
+    Collision2DShape::Collision2DShape(const Collision2DShapeType& type)
+        :_type(type),_offset(glm::vec2(0)) {}
     Collision2DShape::~Collision2DShape() {}
 
+    const Collision2DShapeType& Collision2DShape::getType() const {
+        return _type;
+    }
+
     const glm::vec2& Collision2DShape::getOffset() const {
         return _offset;
     }
@@ -23,7 +28,7 @@ namespace ff {
 
 
     CircleCollision2DShape::CircleCollision2DShape(const float& radius)
-        :_radius(radius),_radiusSquared(radius * radius) {
+        :Collision2DShape(Collision2DShapeType::CIRCLE),_radius(radius),_radiusSquared(radius * radius) {
     }
     CircleCollision2DShape::~CircleCollision2DShape() {
     }
@@ -55,7 +60,11 @@ namespace ff {
     }
 
 
-    PolygonCollision2DShape::PolygonCollision2DShape(const std::vector<glm::vec2>& vertices) {
+    PolygonCollision2DShape::PolygonCollision2DShape(const std::vector<glm::vec2>& vertices)
+        :Collision2DShape(Collision2DShapeType::POLYGON) {
+        FF_ASSERT(vertices.size() <= FF_COLLISION_2D_MAX_POLYGON_VERTICES,
+            "Collision polygons can have at most %s vertices.", FF_COLLISION_2D_MAX_POLYGON_VERTICES);
+
         // Detect cw/ccw
         // https://stackoverflow.com/questions/1165647/how-to-determine-if-a-list-of-polygon-points-are-in-clockwise-order
         float sum = 0;
@@ -72,15 +81,15 @@ namespace ff {
             // cw: we need to reverse the rotation
             _vertices.resize(vertices.size());
             for(size_t i = 0; i < vertices.size(); i++) {
-                _vertices[i] = vertices[i];
+                _vertices[i] = vertices[vertices.size() - 1 - i];
             }
         }
 
         // Compute normals
         _normals.resize(vertices.size());
         for(size_t i = 0; i < vertices.size(); i++) {
-            glm::vec2 v1 = vertices[i];
-            glm::vec2 v2 = vertices[(i + 1) % vertices.size()];
+            glm::vec2 v1 = _vertices[i];
+            glm::vec2 v2 = _vertices[(i + 1) % _vertices.size()];
 
             _normals[i] = -VectorHelper::normal(v2 - v1); // Normal is right-handed, we need left-handed
         }
@@ -127,10 +136,10 @@ namespace ff {
     Collision2DComponent::Collision2DComponent(const std::initializer_list<Collision2DShape*>& shapes,
             const CollisionGroup& group,
             const CollisionGroup& mask)
-        :shapes(shapes),group(group),mask(mask) {
+        :shapes(shapes),group(group),mask(mask),_collidingCount(0),_broadPhaseProxy(FF_COLLISION_2D_NULL_PROXY) {
     }
     Collision2DComponent::Collision2DComponent(const Collision2DComponent& other)
-        :group(other.group),mask(other.mask) {
+        :group(other.group),mask(other.mask),_collidingCount(other._collidingCount),_broadPhaseProxy(FF_COLLISION_2D_NULL_PROXY) {
         for(auto it = other.shapes.begin();
             it != other.shapes.end();
             it++) {
@@ -147,6 +156,6 @@ namespace ff {
     }
 
     size_t Collision2DComponent::getCollidingCount() const {
-        return _currentlyCollidingWith.size();
+        return _collidingCount;
     }
 }
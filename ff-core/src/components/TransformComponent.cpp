@@ -107,6 +107,9 @@ namespace ff {
     float TransformComponent::get2DRotation() const {
         return glm::roll(_rotation);
     }
+    float TransformComponent::getLast2DRotation() const {
+        return glm::roll(_lastRotation);
+    }
 
 
     void TransformComponent::setRotation(const glm::vec3& eulerAngles, const bool& reset) {
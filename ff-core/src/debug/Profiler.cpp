@@ -0,0 +1,267 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <ff/debug/Profiler.hpp>
+
+#include <timer_lib/timer.h>
+
+#include <memory>
+#include <mutex>
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
+
+namespace ff {
+    namespace {
+        constexpr size_t noNode = SIZE_MAX;
+
+        struct ProfileRecord {
+            char const* name;
+            tick_t tick;
+            bool begin;
+        };
+        struct OpenZone {
+            char const* name;
+            tick_t beginTick;
+            size_t node;
+        };
+        struct ZoneNode {
+            char const* name;
+            size_t firstChild;
+            size_t nextSibling;
+            size_t callCount;
+            double duration;
+        };
+
+        // Written by its thread, read by `endFrame`
+        struct ThreadBuffer {
+            std::unique_ptr<ProfileRecord[]> records = std::make_unique<ProfileRecord[]>(FF_PROFILER_THREAD_BUFFER_SIZE);
+            std::atomic<size_t> head{0};
+            std::atomic<size_t> tail{0};
+
+            // Only touched by `endFrame`
+            std::vector<OpenZone> openZones;
+            size_t firstRoot = noNode;
+            // Set once its thread has exited, under the state's mutex
+            bool exited = false;
+        };
+        struct ProfilerState {
+            // Guards `threads`, `freeThreads`, and the collection in `endFrame`
+            std::mutex mutex;
+            std::vector<std::unique_ptr<ThreadBuffer>> threads;
+            // Buffers of exited threads that have been drained, ready for new threads
+            std::vector<std::unique_ptr<ThreadBuffer>> freeThreads;
+            std::vector<ZoneNode> nodes;
+            std::vector<ProfileZoneStatistic> lastFrame;
+            std::atomic<uint32_t> droppedCount{0};
+        };
+
+        // Never destroyed, since zones may end during static destruction
+        ProfilerState& getState() {
+            static ProfilerState* state = new ProfilerState();
+            return *state;
+        }
+        // Hands its thread's buffer back when the thread exits. The buffer is
+        // recycled by `endFrame` once the zones left in it are collected.
+        struct ThreadBufferOwner {
+            ThreadBuffer* buffer = nullptr;
+
+            ~ThreadBufferOwner() {
+                if(buffer != nullptr) {
+                    ProfilerState& state = getState();
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    buffer->exited = true;
+                }
+            }
+        };
+        ThreadBuffer& getThreadBuffer() {
+            thread_local ThreadBufferOwner owner;
+            if(owner.buffer == nullptr) {
+                ProfilerState& state = getState();
+                std::lock_guard<std::mutex> lock(state.mutex);
+                if(state.freeThreads.empty()) {
+                    state.threads.push_back(std::make_unique<ThreadBuffer>());
+                } else {
+                    state.threads.push_back(std::move(state.freeThreads.back()));
+                    state.freeThreads.pop_back();
+                }
+                owner.buffer = state.threads.back().get();
+            }
+            return *owner.buffer;
+        }
+        void pushRecord(char const* const& name, const bool& begin) {
+            ThreadBuffer& buffer = getThreadBuffer();
+            size_t const head = buffer.head.load(std::memory_order_relaxed);
+            if(head - buffer.tail.load(std::memory_order_acquire) == FF_PROFILER_THREAD_BUFFER_SIZE) {
+                getState().droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            ProfileRecord& record = buffer.records[head & (FF_PROFILER_THREAD_BUFFER_SIZE - 1)];
+            record.name = name;
+            record.tick = timer_current();
+            record.begin = begin;
+            buffer.head.store(head + 1, std::memory_order_release);
+        }
+
+        // The same literal can have a different address in each library
+        bool isSameZone(char const* const& lhs, char const* const& rhs) {
+            return lhs == rhs || std::strcmp(lhs, rhs) == 0;
+        }
+        size_t findOrAddNode(std::vector<ZoneNode>& nodes, size_t& firstChild, char const* const& name) {
+            size_t lastChild = noNode;
+            for(size_t child = firstChild; child != noNode; child = nodes[child].nextSibling) {
+                if(isSameZone(nodes[child].name, name)) {
+                    return child;
+                }
+                lastChild = child;
+            }
+
+            size_t const node = nodes.size();
+            if(lastChild == noNode) {
+                firstChild = node;
+            } else {
+                nodes[lastChild].nextSibling = node;
+            }
+            nodes.push_back(ZoneNode{ name, noNode, noNode, 0, 0 });
+            return node;
+        }
+        size_t findOrAddChild(std::vector<ZoneNode>& nodes, ThreadBuffer& thread, const size_t& parent, char const* const& name) {
+            if(parent == noNode) {
+                return findOrAddNode(nodes, thread.firstRoot, name);
+            }
+            // Copied, since adding a node may move `nodes`
+            size_t firstChild = nodes[parent].firstChild;
+            size_t const node = findOrAddNode(nodes, firstChild, name);
+            nodes[parent].firstChild = firstChild;
+            return node;
+        }
+
+        void appendZones(const std::vector<ZoneNode>& nodes, const size_t& firstNode, const size_t& depth, const size_t& thread,
+            std::vector<ProfileZoneStatistic>& zones) {
+            for(size_t node = firstNode; node != noNode; node = nodes[node].nextSibling) {
+                zones.push_back(ProfileZoneStatistic{ nodes[node].name, depth, thread, nodes[node].callCount, nodes[node].duration });
+                appendZones(nodes, nodes[node].firstChild, depth + 1, thread, zones);
+            }
+        }
+    }
+
+    namespace _internal {
+        std::atomic<bool> profilerEnabled(true);
+    }
+
+    namespace Profiler {
+        void setEnabled(const bool& enabled) {
+            _internal::profilerEnabled.store(enabled, std::memory_order_relaxed);
+        }
+
+        void beginZone(char const* const& name) {
+            pushRecord(name, true);
+        }
+        void endZone(char const* const& name) {
+            pushRecord(name, false);
+        }
+
+        void endFrame() {
+            ProfilerState& state = getState();
+            std::lock_guard<std::mutex> lock(state.mutex);
+            std::vector<ZoneNode>& nodes = state.nodes;
+            nodes.clear();
+            state.lastFrame.clear();
+
+            for(size_t threadIndex = 0; threadIndex < state.threads.size(); threadIndex++) {
+                ThreadBuffer& thread = *state.threads[threadIndex];
+                std::vector<OpenZone>& openZones = thread.openZones;
+
+                // Zones still open from the last frame carry on in this one
+                thread.firstRoot = noNode;
+                for(size_t i = 0; i < openZones.size(); i++) {
+                    openZones[i].node = findOrAddChild(nodes, thread, i == 0 ? noNode : openZones[i - 1].node, openZones[i].name);
+                }
+
+                size_t const head = thread.head.load(std::memory_order_acquire);
+                size_t tail = thread.tail.load(std::memory_order_relaxed);
+                for(; tail != head; tail++) {
+                    ProfileRecord const& record = thread.records[tail & (FF_PROFILER_THREAD_BUFFER_SIZE - 1)];
+                    if(record.begin) {
+                        size_t const parent = openZones.empty() ? noNode : openZones.back().node;
+                        size_t const node = findOrAddChild(nodes, thread, parent, record.name);
+                        openZones.push_back(OpenZone{ record.name, record.tick, node });
+                        continue;
+                    }
+
+                    // If a zone's end was dropped, it's closed without being counted
+                    // by the end of the zone around it. If its beginning was dropped,
+                    // its end matches nothing and is ignored.
+                    size_t match = openZones.size();
+                    while(match > 0 && !isSameZone(openZones[match - 1].name, record.name)) {
+                        match--;
+                    }
+                    if(match == 0) {
+                        continue;
+                    }
+                    OpenZone const& openZone = openZones[match - 1];
+                    ZoneNode& node = nodes[openZone.node];
+                    node.callCount++;
+                    node.duration += timer_ticks_to_seconds(record.tick - openZone.beginTick);
+                    openZones.resize(match - 1);
+                }
+                thread.tail.store(tail, std::memory_order_release);
+
+                appendZones(nodes, thread.firstRoot, 0, threadIndex, state.lastFrame);
+            }
+
+            // Exited threads wrote everything before being marked, so their
+            // buffers are empty now and can be given to new threads
+            size_t kept = 0;
+            for(size_t threadIndex = 0; threadIndex < state.threads.size(); threadIndex++) {
+                std::unique_ptr<ThreadBuffer>& thread = state.threads[threadIndex];
+                if(!thread->exited) {
+                    std::swap(state.threads[kept++], thread);
+                    continue;
+                }
+                thread->openZones.clear();
+                thread->firstRoot = noNode;
+                thread->exited = false;
+                state.freeThreads.push_back(std::move(thread));
+            }
+            state.threads.resize(kept);
+        }
+        const std::vector<ProfileZoneStatistic>& getLastFrame() {
+            return getState().lastFrame;
+        }
+        uint32_t getAndResetDroppedCount() {
+            return getState().droppedCount.exchange(0, std::memory_order_relaxed);
+        }
+
+        char const* getTypeName(const std::type_info& type) {
+            // Never destroyed, like the profiler's state
+            static std::mutex* mutex = new std::mutex();
+            static std::unordered_map<std::type_index, std::string>* names = new std::unordered_map<std::type_index, std::string>();
+
+            std::lock_guard<std::mutex> lock(*mutex);
+            auto it = names->find(type);
+            if(it == names->end()) {
+                std::string name = type.name();
+#ifdef __GNUG__
+                int status = 0;
+                char* demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+                if(status == 0) {
+                    name = demangled;
+                }
+                std::free(demangled);
+#endif
+                it = names->emplace(type, std::move(name)).first;
+            }
+            return it->second.c_str();
+        }
+    }
+}
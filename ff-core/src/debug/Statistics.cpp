@@ -9,6 +9,8 @@
 #include <ff/Console.hpp>
 #include <ff/CVars.hpp>
 
+#include <algorithm>
+
 namespace ff {
     Statistics::Statistics() {
     }
@@ -50,14 +52,18 @@ namespace ff {
         if(it == _lists.end()) {
             _lists.insert(std::make_pair(name, ListStatistic{}));
             it = _lists.find(name);
+            it->second.oldest = 0;
             it->second.maxSize = CVars::get<int>("debug_statistics_list_max_size");
         }
         ListStatistic& list = it->second;
-        list.values.push_back(value);
         if(list.maxSize > 0
-            && list.values.size() > list.maxSize) {
-            list.values.erase(list.values.begin());
+            && list.values.size() >= list.maxSize) {
+            // Overwrite the oldest value rather than shifting the rest down
+            list.values[list.oldest] = value;
+            list.oldest = (list.oldest + 1) % list.values.size();
+            return;
         }
+        list.values.push_back(value);
     }
     bool Statistics::doesListExist(const std::string& name) const {
         return _lists.find(name) != _lists.end();
@@ -66,20 +72,26 @@ namespace ff {
         auto it = _lists.find(name);
         FF_ASSERT(it != _lists.end(), "`%s` is not a valid list.", name);
         it->second.values.clear();
+        it->second.oldest = 0;
     }
     void Statistics::printList(const std::string& name) const {
         auto it = _lists.find(name);
         FF_ASSERT(it != _lists.end(), "`%s` is not a valid list.", name);
         FF_CONSOLE_LOG("Values of list `%s`:", name);
-        for(auto& value : it->second.values) {
-            FF_CONSOLE_LOG("%s", value);
+        std::vector<float> const& values = it->second.values;
+        for(size_t i = 0; i < values.size(); i++) {
+            FF_CONSOLE_LOG("%s", values[(it->second.oldest + i) % values.size()]);
         }
     }
     void Statistics::setListMaxSize(const std::string& name, int const& maxSize) {
         auto it = _lists.find(name);
         FF_ASSERT(it != _lists.end(), "`%s` is not a valid list.", name);
         it->second.maxSize = maxSize;
-        if(it->second.values.size() > it->second.maxSize) {
+        // Back in order, so the list can grow or shrink from its ends
+        std::rotate(it->second.values.begin(), it->second.values.begin() + it->second.oldest, it->second.values.end());
+        it->second.oldest = 0;
+        if(maxSize > 0
+            && it->second.values.size() > it->second.maxSize) {
             it->second.values.erase(it->second.values.begin(),
                 it->second.values.begin() + (it->second.values.size() - it->second.maxSize));
         }
@@ -90,7 +102,8 @@ namespace ff {
         if(it->second.values.size() == 0) {
             return 0;
         }
-        return it->second.values[it->second.values.size() - 1];
+        // The newest value is just before the oldest
+        return it->second.values[(it->second.oldest + it->second.values.size() - 1) % it->second.values.size()];
     }
     float Statistics::getListAverage(const std::string& name) const {
         auto it = _lists.find(name);
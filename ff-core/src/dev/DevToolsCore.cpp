@@ -9,6 +9,7 @@
 #include <ff/Locator.hpp>
 #include <ff/CVars.hpp>
 #include <ff/Console.hpp>
+#include <ff/debug/Profiler.hpp>
 
 #include <imgui.h>
 #include <imgui_stdlib.h>
@@ -38,6 +39,7 @@ void DevToolsCore::onInitialize() {
 bool DevToolsCore::processEvent(PopulateImGuiFrameEvent const& evt) {
     consoleWindow();
     statisticsWindow();
+    profilerWindow();
     cvarsWindow();
 
     return false;
@@ -45,13 +47,16 @@ bool DevToolsCore::processEvent(PopulateImGuiFrameEvent const& evt) {
 bool DevToolsCore::processEvent(KeyboardKeyDownEvent const& evt) {
     switch(evt.key) {
     case KeyboardKey::BACKTICK:
-        CVars::get<bool>("debug_show_console") = !CVars::get<bool>("debug_show_console");
+        CVars::set<bool>("debug_show_console", !CVars::get<bool>("debug_show_console"));
         return true;
     case KeyboardKey::F1:
-        CVars::get<bool>("debug_show_cvars") = !CVars::get<bool>("debug_show_cvars");
+        CVars::set<bool>("debug_show_cvars", !CVars::get<bool>("debug_show_cvars"));
         return true;
     case KeyboardKey::F3:
-        CVars::get<bool>("debug_show_statistics") = !CVars::get<bool>("debug_show_statistics");
+        CVars::set<bool>("debug_show_statistics", !CVars::get<bool>("debug_show_statistics"));
+        return true;
+    case KeyboardKey::F4:
+        CVars::set<bool>("debug_show_profiler", !CVars::get<bool>("debug_show_profiler"));
         return true;
     default:
         return false;
@@ -69,8 +74,9 @@ void DevToolsCore::consoleWindow() {
 
     if(CVars::get<bool>("debug_show_console")) {
         ImGui::SetNextWindowSize(ImVec2(600, 300), ImGuiCond_FirstUseEver);
-        ImGui::Begin("Developer Console",
-            &CVars::get<bool>("debug_show_console"));
+        // Closed through `CVars::set`, so handles see the change
+        bool open = true;
+        ImGui::Begin("Developer Console", &open);
 
         bool const justFocused = ImGui::IsWindowFocused() && !lastFrameWindowFocused;
         lastFrameWindowFocused = ImGui::IsWindowFocused();
@@ -207,18 +213,21 @@ void DevToolsCore::consoleWindow() {
         // Kinda a hack but whatever
         // If the first character is a `, close the console
         if(_consoleCmdEntry.size() > 0 && _consoleCmdEntry[0] == '`') {
-            CVars::get<bool>("debug_show_console") = false;
+            open = false;
             _consoleCmdEntry = "";
         }
 
         ImGui::End();
+        if(!open) {
+            CVars::set<bool>("debug_show_console", false);
+        }
     }
 }
 void DevToolsCore::cvarsWindow() {
     if(CVars::get<bool>("debug_show_cvars")) {
         ImGui::SetNextWindowSize(ImVec2(800, 400), ImGuiCond_FirstUseEver);
-        ImGui::Begin("CVars Viewer",
-            &CVars::get<bool>("debug_show_cvars")); 
+        bool open = true;
+        ImGui::Begin("CVars Viewer", &open);
 
         if(ImGui::Button("Save##Control")) {
             Locator::getMessageBus().dispatch<PreserveCVarsCmd>();
@@ -275,14 +284,17 @@ void DevToolsCore::cvarsWindow() {
         }
 
         ImGui::End();
+        if(!open) {
+            CVars::set<bool>("debug_show_cvars", false);
+        }
     }
 }
 void DevToolsCore::statisticsWindow() {
     if(CVars::get<bool>("debug_show_statistics")) {
         ImGui::SetNextWindowSize(ImVec2(400, 200),
             ImGuiCond_FirstUseEver);
-        ImGui::Begin("Statistics",
-            &CVars::get<bool>("debug_show_statistics"));
+        bool open = true;
+        ImGui::Begin("Statistics", &open);
         if(Locator::getStatistics().getListCount() == 0) {
             ImGui::Text("No statistics.");
         } else {
@@ -293,6 +305,50 @@ void DevToolsCore::statisticsWindow() {
             });
         }
         ImGui::End();
+        if(!open) {
+            CVars::set<bool>("debug_show_statistics", false);
+        }
+    }
+}
+void DevToolsCore::profilerWindow() {
+    if(CVars::get<bool>("debug_show_profiler")) {
+        ImGui::SetNextWindowSize(ImVec2(400, 300),
+            ImGuiCond_FirstUseEver);
+        bool open = true;
+        ImGui::Begin("Profiler", &open);
+#ifdef FF_PROFILER
+        bool enabled = Profiler::getEnabled();
+        if(ImGui::Checkbox("Enabled", &enabled)) {
+            Profiler::setEnabled(enabled);
+        }
+        // Zones that didn't fit in a thread's buffer, since the window opened
+        static uint32_t droppedCount = 0;
+        droppedCount += Profiler::getAndResetDroppedCount();
+        if(droppedCount > 0) {
+            ImGui::SameLine();
+            ImGui::Text("(%u zones dropped)", droppedCount);
+        }
+        // Kept, so the last frame profiled stays up while disabled
+        static std::vector<ProfileZoneStatistic> zones;
+        if(enabled) {
+            zones = Profiler::getLastFrame();
+        }
+        size_t thread = SIZE_MAX;
+        for(auto const& zone : zones) {
+            if(zone.thread != thread) {
+                thread = zone.thread;
+                ImGui::Separator();
+                ImGui::Text("Thread %zu", thread);
+            }
+            ImGui::Text("%*s%s: %.3f ms (x%zu)", (int)zone.depth * 2, "", zone.name, zone.duration * 1000, zone.callCount);
+        }
+#else
+        ImGui::Text("Built without FF_PROFILER.");
+#endif
+        ImGui::End();
+        if(!open) {
+            CVars::set<bool>("debug_show_profiler", false);
+        }
     }
 }
 
@@ -7,6 +7,7 @@
 #include <ff/graphics/RenderCore.hpp>
 
 #include <ff/Locator.hpp>
+#include <ff/debug/Profiler.hpp>
 
 #include <ff/commands/render/RenderSceneForCameraCmd.hpp>
 #include <ff/commands/render/RenderImGuiCmd.hpp>
@@ -21,6 +22,7 @@ RenderCore::RenderCore(ProcessManager* const& processManager)
 }
 
 std::unique_ptr<RenderCmd::Ret> RenderCore::handleCmd(RenderCmd const& cmd) {
+    FF_PROFILE_ZONE("RenderCore::handleCmd");
     Locator::getStatistics().beginStopwatch("game_render_time");
 
     // Render game scene for debug view
@@ -47,19 +47,19 @@ namespace ff {
         return (_topRight - _bottomLeft) / 2.0f + _bottomLeft;
     }
 
-    bool Rectangle::intersects(const Rectangle& other) {
+    bool Rectangle::intersects(const Rectangle& other) const {
         return other._bottomLeft.x <= _topRight.x
             && other._topRight.x >= _bottomLeft.x
             && other._bottomLeft.y <= _topRight.y
             && other._topRight.y >= _bottomLeft.y;
     }
-    bool Rectangle::contains(const Rectangle& other) {
+    bool Rectangle::contains(const Rectangle& other) const {
         return other._bottomLeft.x >= _bottomLeft.x
             && other._topRight.x <= _topRight.x
             && other._bottomLeft.y >= _bottomLeft.y
             && other._topRight.y <= _topRight.y;
     }
-    bool Rectangle::contains(const glm::vec2& point) {
+    bool Rectangle::contains(const glm::vec2& point) const {
         return point.x >= _bottomLeft.x
             && point.x <= _topRight.x
             && point.y >= _bottomLeft.y
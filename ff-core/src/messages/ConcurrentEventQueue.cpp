@@ -0,0 +1,78 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <ff/messages/ConcurrentEventQueue.hpp>
+
+#include <ff/messages/MessageBus.hpp>
+
+namespace ff {
+
+static_assert((CONCURRENT_EVENT_QUEUE_CAPACITY & (CONCURRENT_EVENT_QUEUE_CAPACITY - 1)) == 0,
+    "CONCURRENT_EVENT_QUEUE_CAPACITY must be a power of 2.");
+
+ConcurrentEventQueue::ConcurrentEventQueue()
+    :_slots(new Slot[CONCURRENT_EVENT_QUEUE_CAPACITY]),
+    _enqueuePos(0),
+    _dequeuePos(0),
+    _droppedCount(0) {
+    for(size_t i = 0; i < CONCURRENT_EVENT_QUEUE_CAPACITY; i++) {
+        _slots[i].sequence.store(i, std::memory_order_relaxed);
+        _slots[i].deliver = nullptr;
+    }
+}
+ConcurrentEventQueue::~ConcurrentEventQueue() {
+    // Destroys any events that were never drained
+    implDrain(nullptr);
+}
+
+void ConcurrentEventQueue::drain(MessageBus& bus) {
+    implDrain(&bus);
+}
+
+uint32_t ConcurrentEventQueue::getAndResetDroppedCount() {
+    return _droppedCount.exchange(0, std::memory_order_relaxed);
+}
+
+ConcurrentEventQueue::Slot* ConcurrentEventQueue::acquireSlot() {
+    constexpr size_t mask = CONCURRENT_EVENT_QUEUE_CAPACITY - 1;
+    size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+    while(true) {
+        Slot& slot = _slots[pos & mask];
+        size_t const seq = slot.sequence.load(std::memory_order_acquire);
+        intptr_t const diff = (intptr_t)seq - (intptr_t)pos;
+        if(diff == 0) {
+            // Slot is free for this position; try to claim it
+            if(_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                return &slot;
+            }
+        } else if(diff < 0) {
+            // Consumer hasn't released this slot yet; queue is full
+            return nullptr;
+        } else {
+            // Another producer claimed this position
+            pos = _enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+void ConcurrentEventQueue::implDrain(MessageBus* bus) {
+    constexpr size_t mask = CONCURRENT_EVENT_QUEUE_CAPACITY - 1;
+    while(true) {
+        Slot& slot = _slots[_dequeuePos & mask];
+        if(slot.sequence.load(std::memory_order_acquire) != _dequeuePos + 1) {
+            // Empty, or the producer hasn't finished constructing the event yet
+            break;
+        }
+
+        slot.deliver(bus, slot.storage);
+        slot.deliver = nullptr;
+
+        // Release the slot for the next lap around the buffer
+        slot.sequence.store(_dequeuePos + CONCURRENT_EVENT_QUEUE_CAPACITY, std::memory_order_release);
+        _dequeuePos++;
+    }
+}
+
+}
@@ -19,7 +19,14 @@ IEventListener::~IEventListener() {
     _bus = nullptr;
 }
 
-bool GenericEventListener::implProcessEvent(std::shared_ptr<Event> const& evt) {
+void IEventListener::implProcessEvents(Event* const& evts, size_t const& stride, size_t const& count) {
+    char* evtBytes = reinterpret_cast<char*>(evts);
+    for(size_t i = 0; i < count; i++) {
+        implProcessEvent(*reinterpret_cast<Event*>(evtBytes + i * stride));
+    }
+}
+
+bool GenericEventListener::implProcessEvent(Event const& evt) {
     return processEvent(evt);
 }
 
@@ -0,0 +1,26 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <ff/messages/EventType.hpp>
+
+#include <unordered_map>
+
+namespace ff {
+
+namespace _internal {
+    EventTypeID_t getEventTypeID(const std::type_index& type) {
+        // Not locked, since IDs are only looked up on the main thread, by the
+        // MessageBus's listeners and queues. `MessageBus::post` doesn't use them.
+        static std::unordered_map<std::type_index, EventTypeID_t> typeMap;
+        auto it = typeMap.find(type);
+        if(it == typeMap.end()) {
+            it = typeMap.emplace(type, (EventTypeID_t)typeMap.size()).first;
+        }
+        return it->second;
+    }
+}
+
+}
@@ -12,7 +12,9 @@
 namespace ff {
 
 MessageBus::MessageBus()
-    :_isProcessing(false) {
+    :_wildcardEventListeners(&_eventListeners[MESSAGE_WILDCARD]),
+    _isFlushing(false),
+    _processingDepth(0) {
 }
 MessageBus::~MessageBus() {
     for(auto& pair : _eventListeners) {
@@ -20,6 +22,9 @@ MessageBus::~MessageBus() {
             listener->_bus = nullptr;
         }
     }
+    _eventQueues.clear();
+    _typedEventListeners.clear();
+    _wildcardEventListeners = nullptr;
     _eventListeners.clear();
     _eventListenersPendingAdd.clear();
     _eventListenersPendingRemove.clear();
@@ -33,6 +38,60 @@ MessageBus::~MessageBus() {
     }
 }
 
+void MessageBus::flush() {
+    FF_ASSERT(!_isFlushing, "MessageBus is already flushing.");
+    _isFlushing = true;
+
+    _postedEvents.drain(*this);
+    uint32_t const droppedCount = _postedEvents.getAndResetDroppedCount();
+    if(droppedCount > 0) {
+        FF_CONSOLE_WARN("%s posted events were dropped; the concurrent event queue was full.", droppedCount);
+    }
+
+    // Swap every queue up front, so events enqueued during delivery (of any
+    // type) are left for the next flush.
+    size_t const queueCount = _eventQueues.size();
+    for(size_t i = 0; i < queueCount; i++) {
+        if(_eventQueues[i] != nullptr) {
+            _eventQueues[i]->swapBuffers();
+        }
+    }
+
+    _processingDepth++;
+    for(size_t i = 0; i < queueCount; i++) {
+        IEventQueue* queue = _eventQueues[i].get();
+        if(queue == nullptr
+            || queue->getDeliveryCount() == 0) {
+            continue;
+        }
+
+        size_t const count = queue->getDeliveryCount();
+        Event* const evts = queue->getDeliveryEvents();
+        size_t const stride = queue->getStride();
+
+#ifdef FF_MESSAGE_BUS_LOGGING
+        for(size_t j = 0; j < count; j++) {
+            Event* evt = reinterpret_cast<Event*>(reinterpret_cast<char*>(evts) + j * stride);
+            if(shouldLogMessage(evt->getName())) {
+                FF_CONSOLE_LOG("[%s] (queued) %s", evt->getName(), evt->stringify());
+            }
+        }
+#endif
+
+        processEventListenerBatch(*_wildcardEventListeners, MESSAGE_WILDCARD, evts, stride, count);
+        processEventListenerBatch(*queue->_listeners, queue->getEventName(), evts, stride, count);
+
+        queue->clearDeliveryEvents();
+    }
+    _processingDepth--;
+
+    _isFlushing = false;
+
+    if(_processingDepth == 0) {
+        cleanupListenersAndHandlers();
+    }
+}
+
 void MessageBus::addListener(const std::string& eventName,
     GenericEventListener* const& listenerPtr,
     MessageListenerPriority_t const& priority) { 
@@ -46,7 +105,7 @@ void MessageBus::addListener(const std::string& eventName,
     }
     iListenerPtr->_priority = priority;
     
-    if(_isProcessing) {
+    if(_processingDepth > 0) {
         _eventListenersPendingAdd[eventName].push_back(iListenerPtr);
         return;
     }
@@ -63,7 +122,7 @@ void MessageBus::removeListener(const std::string& eventName, GenericEventListen
     std::vector<IEventListener*>& eventListeners = _eventListeners[eventName];
     IEventListener* iListenerPtr = (IEventListener*)listenerPtr;
 
-    if(_isProcessing) {
+    if(_processingDepth > 0) {
         _eventListenersPendingRemove[eventName].push_back(iListenerPtr);
         return;
     }
@@ -82,8 +141,67 @@ void MessageBus::removeListener(GenericEventListener* const& listenerPtr) {
     implRemoveIEventListener(listenerPtr);
 }
 
+#ifdef FF_MESSAGE_BUS_LOGGING
+bool MessageBus::shouldLogMessage(std::string const& name) {
+    std::string const& filter = CVars::get<std::string>("message_filter");
+    if(filter != _messageFilterSource) {
+        _messageFilterSource = filter;
+        _messageFilter = std::regex(filter);
+    }
+    return !std::regex_match(name, _messageFilter); // Exclusive
+}
+#endif
+
+bool MessageBus::processEventListeners(std::vector<IEventListener*>& listeners,
+    char const* eventName,
+    Event const& evt) {
+    // Listeners added during processing are pending, so `listeners` can't
+    // change size while iterating.
+    for(size_t i = 0; i < listeners.size(); i++) {
+        if(isEventListenerPendingRemoval(eventName, listeners[i])) {
+            continue;
+        }
+        if(listeners[i]->implProcessEvent(evt)) {
+            return true;
+        }
+    }
+    return false;
+}
+void MessageBus::processEventListenerBatch(std::vector<IEventListener*>& listeners,
+    char const* eventName,
+    Event* const& evts,
+    size_t const& stride,
+    size_t const& count) {
+    for(size_t i = 0; i < listeners.size(); i++) {
+        if(isEventListenerPendingRemoval(eventName, listeners[i])) {
+            continue;
+        }
+        listeners[i]->implProcessEvents(evts, stride, count);
+    }
+}
+bool MessageBus::isEventListenerPendingRemoval(char const* eventName, IEventListener* listener) const {
+    if(_eventListenersPendingAllRemove.size() > 0
+        && std::find(_eventListenersPendingAllRemove.begin(),
+            _eventListenersPendingAllRemove.end(),
+            listener)
+            != _eventListenersPendingAllRemove.end()) {
+        return true;
+    }
+    if(_eventListenersPendingRemove.size() == 0) {
+        return false;
+    }
+    auto it = _eventListenersPendingRemove.find(eventName);
+    if(it == _eventListenersPendingRemove.end()) {
+        return false;
+    }
+    return std::find(it->second.begin(),
+        it->second.end(),
+        listener)
+        != it->second.end();
+}
+
 void MessageBus::implRemoveIEventListener(IEventListener* listener) {
-    if(_isProcessing) {
+    if(_processingDepth > 0) {
         _eventListenersPendingAllRemove.push_back(listener);
         return;
     }
@@ -106,7 +224,7 @@ void MessageBus::implRemoveICmdHandler(ICmdHandler* handler) {
 }
 
 void MessageBus::cleanupListenersAndHandlers() {
-    FF_ASSERT(!_isProcessing, "MessageBus is processing; cannot clean up.");
+    FF_ASSERT(_processingDepth == 0, "MessageBus is processing; cannot clean up.");
 
     // Cleanup listeners
     for(auto& pair : _eventListenersPendingRemove) {
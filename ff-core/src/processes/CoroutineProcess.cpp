@@ -0,0 +1,64 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <ff/processes/CoroutineProcess.hpp>
+
+#include <ff/Locator.hpp>
+
+namespace ff {
+    CoroutineProcess::CoroutineProcess(ProcessPriority_t const& priority)
+        :Process(priority),
+        _resumePoint(0),
+        _waitDuration(0),
+        _awaitedEventName(nullptr) {
+    }
+    CoroutineProcess::~CoroutineProcess() {
+        stopListening();
+    }
+
+    bool CoroutineProcess::processEvent(const Event& evt) {
+        if(_awaitedEventName != nullptr
+            && (!_eventFilter || _eventFilter(evt))) {
+            // Resumed on the next update rather than from inside the dispatch
+            stopListening();
+        }
+        return false;
+    }
+
+    bool CoroutineProcess::getWaiting() const {
+        return _waitDuration > 0 || _awaitedEventName != nullptr;
+    }
+
+    void CoroutineProcess::wait(const float& duration) {
+        _waitDuration = duration;
+    }
+
+    void CoroutineProcess::onKill() {
+        stopListening();
+    }
+
+    void CoroutineProcess::onUpdate(const float& dt) {
+        if(_waitDuration > 0) {
+            _waitDuration -= dt;
+        }
+        if(!getWaiting()) {
+            onResume();
+        }
+    }
+
+    void CoroutineProcess::listenForEvent(char const* const& eventName) {
+        stopListening();
+        _awaitedEventName = eventName;
+        ff::Locator::getMessageBus().addListener(eventName, this);
+    }
+    void CoroutineProcess::stopListening() {
+        if(_awaitedEventName != nullptr) {
+            ff::Locator::getMessageBus().removeListener(_awaitedEventName, this);
+            _awaitedEventName = nullptr;
+            _eventFilter = nullptr;
+        }
+    }
+}
@@ -0,0 +1,142 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <ff/processes/JobSystem.hpp>
+
+#include <algorithm>
+
+namespace ff {
+    namespace {
+        thread_local bool isInJobThreadLocal = false;
+
+        struct InJobScope {
+            InJobScope() : _prev(isInJobThreadLocal) {
+                isInJobThreadLocal = true;
+            }
+            ~InJobScope() {
+                isInJobThreadLocal = _prev;
+            }
+            bool _prev;
+        };
+    }
+
+    JobSystem::JobSystem(size_t const& workerCount)
+        :_currentJob(nullptr),
+        _nextJobID(1),
+        _shuttingDown(false) {
+        _workers.reserve(workerCount);
+        for(size_t i = 0; i < workerCount; ++i) {
+            _workers.emplace_back([this]() {
+                workerLoop();
+            });
+        }
+    }
+    JobSystem::~JobSystem() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _shuttingDown = true;
+        }
+        _jobAvailable.notify_all();
+        for(auto& worker : _workers) {
+            worker.join();
+        }
+    }
+
+    size_t JobSystem::getWorkerCount() const {
+        return _workers.size();
+    }
+
+    void JobSystem::parallelFor(size_t const& count, size_t const& grainSize, std::function<void(size_t, size_t)> const& fn) {
+        if(count == 0) {
+            return;
+        }
+        size_t const grain = std::max<size_t>(grainSize, 1);
+
+        if(_workers.empty()
+            || count <= grain
+            || isInJob()
+            || !_submitMutex.try_lock()) {
+            InJobScope scope;
+            for(size_t begin = 0; begin < count; begin += grain) {
+                fn(begin, std::min(begin + grain, count));
+            }
+            return;
+        }
+
+        Job job;
+        job.fn = &fn;
+        job.count = count;
+        job.grainSize = grain;
+        job.nextRange.store(0, std::memory_order_relaxed);
+        job.activeWorkers = 0;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            job.id = _nextJobID++;
+            _currentJob = &job;
+        }
+        _jobAvailable.notify_all();
+
+        {
+            InJobScope scope;
+            runRanges(job);
+        }
+
+        {
+            // Once `_currentJob` is cleared no worker can pick up `job`, so it's
+            // safe to let it go out of scope as soon as the joined ones finish
+            std::unique_lock<std::mutex> lock(_mutex);
+            _currentJob = nullptr;
+            _jobDone.wait(lock, [&job]() {
+                return job.activeWorkers == 0;
+            });
+        }
+        _submitMutex.unlock();
+    }
+
+    size_t JobSystem::getDefaultWorkerCount() {
+        // The thread calling parallelFor does its share of the work
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+    bool JobSystem::isInJob() {
+        return isInJobThreadLocal;
+    }
+
+    void JobSystem::workerLoop() {
+        isInJobThreadLocal = true;
+        uint64_t lastJobID = 0;
+        std::unique_lock<std::mutex> lock(_mutex);
+        while(true) {
+            _jobAvailable.wait(lock, [this, &lastJobID]() {
+                return _shuttingDown || (_currentJob != nullptr && _currentJob->id != lastJobID);
+            });
+            if(_shuttingDown) {
+                return;
+            }
+
+            Job& job = *_currentJob;
+            lastJobID = job.id;
+            job.activeWorkers++;
+            lock.unlock();
+
+            runRanges(job);
+
+            lock.lock();
+            if(--job.activeWorkers == 0) {
+                _jobDone.notify_all();
+            }
+        }
+    }
+    void JobSystem::runRanges(Job& job) {
+        while(true) {
+            size_t begin = job.nextRange.fetch_add(job.grainSize, std::memory_order_relaxed);
+            if(begin >= job.count) {
+                return;
+            }
+            (*job.fn)(begin, std::min(begin + job.grainSize, job.count));
+        }
+    }
+}
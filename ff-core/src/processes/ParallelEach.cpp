@@ -0,0 +1,15 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <ff/processes/ParallelEach.hpp>
+
+namespace ff {
+    void parallelEach(const IterableActorSet& actors, const std::function<void(Actor_t)>& iterFn, const size_t& grainSize) {
+        Locator::getJobSystem().parallelFor(actors.getPartitionCount(), grainSize, [&actors, &iterFn](size_t begin, size_t end) {
+            actors.eachInPartitions(begin, end, iterFn);
+        });
+    }
+}
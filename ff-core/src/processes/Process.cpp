@@ -8,11 +8,17 @@
 
 #include <ff/util/Macros.hpp>
 #include <ff/Console.hpp>
+#include <ff/debug/Profiler.hpp>
+
+#include <typeinfo>
+
+#include <timer_lib/timer.h>
 
 namespace ff {
     Process::Process(ProcessPriority_t const& priority)
-        :_attached(false),_initialized(false),_alive(true),_paused(false),
-        _softKillTriggered(false),_priority(priority),_flags(0) {
+        :_attached(false),_instant(false),_initialized(false),_alive(true),_paused(false),
+        _softKillTriggered(false),_priority(priority),_flags(0),_pendingDt(0),_budgetDeadline(0),
+        _declaresComponentAccess(false) {
     }
     Process::~Process() {
     }
@@ -28,6 +34,10 @@ namespace ff {
     }
     void Process::update(const float& dt) {
         if(_alive && !_paused) {
+#ifdef FF_PROFILER
+            // Named after the process's type, so each process gets its own zone
+            ProfileZone const zone(Profiler::getTypeName(typeid(*this)));
+#endif
             onUpdate(dt);
             updateModifiers(dt);
         }
@@ -108,9 +118,27 @@ namespace ff {
         return (_flags & flag) != 0;
     }
 
+    bool Process::getDeclaresComponentAccess() const {
+        return _declaresComponentAccess;
+    }
+    const ComponentMask& Process::getReadComponents() const {
+        return _readComponents;
+    }
+    const ComponentMask& Process::getWriteComponents() const {
+        return _writeComponents;
+    }
+    bool Process::conflictsWith(const ComponentMask& reads, const ComponentMask& writes) const {
+        return (_writeComponents & (reads | writes)).any()
+            || (_readComponents & writes).any();
+    }
+
     void Process::setPriority(ProcessPriority_t const& priority) {
         _priority = priority;
     }
+    bool Process::hasBudgetLeft() const {
+        return (_flags & ProcessFlags::BUDGETED) == 0
+            || timer_current() < _budgetDeadline;
+    }
 
     void Process::onInitialize() {
     }
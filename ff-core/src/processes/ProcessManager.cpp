@@ -11,127 +11,146 @@
 
 #include <algorithm>
 
+#include <timer_lib/timer.h>
+
 #include <ff/Console.hpp>
+#include <ff/Locator.hpp>
 
 namespace ff {
+    namespace {
+        bool hasHigherPriority(const std::shared_ptr<Process>& lhs, const std::shared_ptr<Process>& rhs) {
+            return lhs->getPriority() > rhs->getPriority();
+        }
+    }
+
     ProcessManager::ProcessManager()
-        :_isTicking(false) {
+        :_isTicking(false),_budgetedCursor(0),_budget(0.002f),
+        _budgetedBehindCount(0),_budgetedLag(0) {
 
     }
     ProcessManager::~ProcessManager() {
         killAll(true);
         _processes.clear();
+        _budgetedProcesses.clear();
     }
 
     std::shared_ptr<Process> ProcessManager::attachProcess(const std::shared_ptr<Process>& process, const int& flags) {
         process->addFlags(flags);
 
+        if(!prepareProcess(process)) {
+            return process;
+        }
         if(_isTicking) {
             _pendingProcesses.push_back(process);
             return process;
         }
-
-        if(process->getPriority() <= ProcessPriority::INHERITED) {
-            // If a process has inherited priority,
-            // it was not attached to a process.
-            // Change to default.
-            process->setPriority(ProcessPriority::DEFAULT);
-        }
-        _processes.push_back(process);
-        std::sort(_processes.begin(), _processes.end(), [](const std::shared_ptr<Process>& lhs, const std::shared_ptr<Process>& rhs) -> bool {
-            return lhs->getPriority() > rhs->getPriority();
-        });
-        _processes.erase(std::unique(_processes.begin(), _processes.end()), _processes.end());
-
-        if(process->hasFlag(ProcessFlags::INITIALIZE_ON_ATTACH)) {
-            process->initialize();
+        if(process->hasFlag(ProcessFlags::BUDGETED)) {
+            _budgetedProcesses.push_back(process);
+            return process;
         }
 
-        process->_attached = true;
+        // After the rest of its priority, so processes of the same priority
+        // update in the order they were attached
+        _processes.insert(std::upper_bound(_processes.begin(), _processes.end(), process, hasHigherPriority), process);
 
         return process;
     }
     void ProcessManager::tick(const float& dt) { // @todo Rename to `update`, tick doesn't make sense
         _isTicking = true;
 
-        std::vector<std::shared_ptr<Process>> deadProcesses;
-
         for(size_t i = 0; i < _processes.size(); i++) {
-            std::shared_ptr<Process> process = _processes[i];
-            process->preUpdate();
+            _processes[i]->preUpdate();
         }
-        for(size_t i = 0; i < _processes.size(); i++) {
-            std::shared_ptr<Process> process = _processes[i];
-            if (process->getInitialized()) {
-                process->update(dt);
+        for(size_t i = 0; i < _processes.size();) {
+            size_t batchEnd = getConcurrentBatchEnd(i);
+            if(batchEnd - i > 1) {
+                Locator::getJobSystem().parallelFor(batchEnd - i, 1, [this, i, &dt](size_t begin, size_t end) {
+                    for(size_t j = i + begin; j < i + end; j++) {
+                        _processes[j]->update(dt);
+                    }
+                });
+                i = batchEnd;
+                continue;
             }
+
+            Process& process = *_processes[i];
+            if (process.getInitialized()) {
+                process.update(dt);
+            }
+            i++;
         }
 
+        // Dead processes are moved out as the rest are compacted
+        size_t aliveCount = 0;
         for(size_t i = 0; i < _processes.size(); i++) {
-            std::shared_ptr<Process> process = _processes[i];
-            if(process->getInitialized()) {
-                process->postUpdate();
+            Process& process = *_processes[i];
+            if(process.getInitialized()) {
+                process.postUpdate();
 
-                if (!process->getAlive()) {
-                    deadProcesses.push_back(process);
+                if (!process.getAlive()) {
+                    process._attached = false;
+                    _deadProcesses.push_back(std::move(_processes[i]));
+                    continue;
                 }
             }
+            if(aliveCount != i) {
+                _processes[aliveCount] = std::move(_processes[i]);
+            }
+            aliveCount++;
         }
-        
-        _isTicking = false;
+        _processes.erase(_processes.begin() + aliveCount, _processes.end());
 
-        for(size_t i = 0; i < deadProcesses.size(); i++) {
-            auto process = deadProcesses[i];
+        tickBudgeted(dt);
 
-            _processes.erase(std::remove(_processes.begin(), _processes.end(), process), _processes.end());
+        _isTicking = false;
 
-            if (auto nextProcess = process->getNext()) {
-                auto instantProcess = std::dynamic_pointer_cast<InstantProcess>(nextProcess);
-                while(nextProcess && instantProcess) {
-                    // @todo I don't know why this is being called directly instead of through a proxy function
-                    instantProcess->onTrigger();
-                    instantProcess->kill();
-                    nextProcess = instantProcess->getNext();
-                    instantProcess = std::dynamic_pointer_cast<InstantProcess>(nextProcess);
-                }
-                if(nextProcess) {
-                    attachProcess(nextProcess);
+        for(size_t i = 0; i < _deadProcesses.size(); i++) {
+            Process* nextProcess = _deadProcesses[i]->getNext().get();
+            while(nextProcess && nextProcess->_instant) {
+                // @todo I don't know why this is being called directly instead of through a proxy function
+                InstantProcess* const instantProcess = static_cast<InstantProcess*>(nextProcess);
+                instantProcess->onTrigger();
+                instantProcess->kill();
+                nextProcess = instantProcess->getNext().get();
+            }
+            if(nextProcess && prepareProcess(nextProcess->shared_from_this())) {
+                // Budgeted ones wait for their turn in the lane
+                if(!nextProcess->hasFlag(ProcessFlags::BUDGETED)) {
                     nextProcess->preUpdate();
                     nextProcess->update(dt);
                     nextProcess->postUpdate();
                 }
+                _pendingProcesses.push_back(nextProcess->shared_from_this());
             }
         }
+        _deadProcesses.clear();
 
-        if(_pendingProcesses.size() > 0) {
-            for(auto it = _pendingProcesses.begin();
-                it != _pendingProcesses.end();
-                it++) {
-                attachProcess(*it);
-            }
-            _pendingProcesses.clear();
-        }
+        attachPendingProcesses();
     }
     void ProcessManager::killAll(const bool& immediate, const bool& stopChains) {
-        for(auto it = _processes.begin();
-            it != _processes.end();
-            it++) {
-            if(stopChains) {
-                (*it)->setNext(nullptr);
-            }
-            if(immediate) {
-                (*it)->kill();
-            } else {
-                (*it)->softKill();
+        for(auto* processes : { &_processes, &_budgetedProcesses }) {
+            for(auto it = processes->begin();
+                it != processes->end();
+                it++) {
+                if(stopChains) {
+                    (*it)->setNext(nullptr);
+                }
+                if(immediate) {
+                    (*it)->kill();
+                } else {
+                    (*it)->softKill();
+                }
             }
         }
     }
     void ProcessManager::togglePauseAll(){
-        for(auto it = _processes.begin();
-            it != _processes.end();
-            it++) {
-            if(!(*it)->hasFlag(ProcessFlags::REQUEST_NO_PAUSE)) {
-                (*it)->togglePause();
+        for(auto* processes : { &_processes, &_budgetedProcesses }) {
+            for(auto it = processes->begin();
+                it != processes->end();
+                it++) {
+                if(!(*it)->hasFlag(ProcessFlags::REQUEST_NO_PAUSE)) {
+                    (*it)->togglePause();
+                }
             }
         }
     }
@@ -139,4 +158,139 @@ namespace ff {
     const std::vector<std::shared_ptr<Process>>& ProcessManager::getProcesses() const {
         return _processes;
     }
+    const std::vector<std::shared_ptr<Process>>& ProcessManager::getBudgetedProcesses() const {
+        return _budgetedProcesses;
+    }
+
+    void ProcessManager::setBudget(const float& budget) {
+        _budget = budget;
+    }
+    const float& ProcessManager::getBudget() const {
+        return _budget;
+    }
+    const size_t& ProcessManager::getBudgetedBehindCount() const {
+        return _budgetedBehindCount;
+    }
+    const float& ProcessManager::getBudgetedLag() const {
+        return _budgetedLag;
+    }
+
+    bool ProcessManager::prepareProcess(const std::shared_ptr<Process>& process) {
+        if(process->_attached) {
+            return false;
+        }
+        process->_attached = true;
+
+        if(process->getPriority() <= ProcessPriority::INHERITED) {
+            // If a process has inherited priority,
+            // it was not attached to a process.
+            // Change to default.
+            process->setPriority(ProcessPriority::DEFAULT);
+        }
+        if(process->hasFlag(ProcessFlags::INITIALIZE_ON_ATTACH) && !process->getInitialized()) {
+            process->initialize();
+        }
+        return true;
+    }
+    void ProcessManager::attachPendingProcesses() {
+        if(_pendingProcesses.empty()) {
+            return;
+        }
+
+        // Budgeted processes join the end of their lane
+        auto const budgetedBegin = std::stable_partition(_pendingProcesses.begin(), _pendingProcesses.end(),
+            [](const std::shared_ptr<Process>& process) { return !process->hasFlag(ProcessFlags::BUDGETED); });
+        _budgetedProcesses.insert(_budgetedProcesses.end(), budgetedBegin, _pendingProcesses.end());
+        _pendingProcesses.erase(budgetedBegin, _pendingProcesses.end());
+
+        // Sorted on their own, then merged in after the processes of the same
+        // priority, rather than sorting everything again
+        size_t const attachedCount = _processes.size();
+        _processes.insert(_processes.end(), _pendingProcesses.begin(), _pendingProcesses.end());
+        _pendingProcesses.clear();
+        std::stable_sort(_processes.begin() + attachedCount, _processes.end(), hasHigherPriority);
+        std::inplace_merge(_processes.begin(), _processes.begin() + attachedCount, _processes.end(), hasHigherPriority);
+    }
+
+    void ProcessManager::tickBudgeted(const float& dt) {
+        size_t const count = _budgetedProcesses.size();
+        if(count == 0) {
+            return;
+        }
+
+        for(size_t i = 0; i < count; i++) {
+            Process& process = *_budgetedProcesses[i];
+            if(!process.getPaused()) {
+                process._pendingDt += dt;
+            }
+        }
+
+        tick_t const beginTick = timer_current();
+        tick_t const budgetDeadline = beginTick + (tick_t)(_budget * timer_ticks_per_second());
+        bool updatedAny = false;
+        for(size_t i = 0; i < count; i++) {
+            if(updatedAny && timer_current() >= budgetDeadline) {
+                break;
+            }
+            Process& process = *_budgetedProcesses[_budgetedCursor];
+            _budgetedCursor = (_budgetedCursor + 1) % count;
+            if(!process.getAlive() || process.getPaused()) {
+                continue;
+            }
+
+            process._budgetDeadline = budgetDeadline;
+            process.preUpdate();
+            process.update(process._pendingDt);
+            process.postUpdate();
+            process._pendingDt = 0;
+            updatedAny = true;
+        }
+
+        // Dead processes are removed as in `tick`, keeping the cursor on the
+        // same process
+        size_t aliveCount = 0;
+        size_t cursor = _budgetedCursor;
+        _budgetedBehindCount = 0;
+        _budgetedLag = 0;
+        for(size_t i = 0; i < count; i++) {
+            Process& process = *_budgetedProcesses[i];
+            if(!process.getAlive()) {
+                process._attached = false;
+                _deadProcesses.push_back(std::move(_budgetedProcesses[i]));
+                if(i < _budgetedCursor) {
+                    cursor--;
+                }
+                continue;
+            }
+            if(process._pendingDt > 0) {
+                _budgetedBehindCount++;
+                _budgetedLag = std::max(_budgetedLag, process._pendingDt);
+            }
+            if(aliveCount != i) {
+                _budgetedProcesses[aliveCount] = std::move(_budgetedProcesses[i]);
+            }
+            aliveCount++;
+        }
+        _budgetedProcesses.erase(_budgetedProcesses.begin() + aliveCount, _budgetedProcesses.end());
+        _budgetedCursor = aliveCount > 0 ? cursor % aliveCount : 0;
+    }
+
+    size_t ProcessManager::getConcurrentBatchEnd(const size_t& begin) const {
+        // Processes are sorted by priority, so a batch is a run of initialized processes
+        // with the same priority that all declared non-conflicting component accesses
+        ComponentMask reads, writes;
+        size_t end = begin;
+        for(; end < _processes.size(); end++) {
+            Process const& process = *_processes[end];
+            if(!process.getInitialized()
+                || !process.getDeclaresComponentAccess()
+                || process.getPriority() != _processes[begin]->getPriority()
+                || process.conflictsWith(reads, writes)) {
+                break;
+            }
+            reads |= process.getReadComponents();
+            writes |= process.getWriteComponents();
+        }
+        return std::max(end, begin + 1);
+    }
 }
@@ -0,0 +1,84 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <ff/processes/ProcessPool.hpp>
+
+#include <mutex>
+#include <new>
+
+namespace ff {
+    namespace {
+        constexpr size_t sizeClassCount = FF_PROCESS_POOL_MAX_BLOCK_SIZE / FF_PROCESS_POOL_BLOCK_GRANULARITY;
+
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+        struct SizeClass {
+            std::mutex mutex;
+            FreeBlock* freeBlocks = nullptr;
+            size_t freeBlockCount = 0;
+        };
+
+        // Chunks are never given back, since processes may outlive any owner of
+        // the pool (e.g. ones held in statics)
+        SizeClass* getSizeClasses() {
+            static SizeClass* sizeClasses = new SizeClass[sizeClassCount];
+            return sizeClasses;
+        }
+        size_t getSizeClassIndex(const size_t& size) {
+            return (size + FF_PROCESS_POOL_BLOCK_GRANULARITY - 1) / FF_PROCESS_POOL_BLOCK_GRANULARITY - 1;
+        }
+    }
+
+    namespace ProcessPool {
+        void* allocate(const size_t& size) {
+            if(size == 0 || size > FF_PROCESS_POOL_MAX_BLOCK_SIZE) {
+                return ::operator new(size);
+            }
+
+            size_t const index = getSizeClassIndex(size);
+            SizeClass& sizeClass = getSizeClasses()[index];
+            std::lock_guard<std::mutex> lock(sizeClass.mutex);
+            if(sizeClass.freeBlocks == nullptr) {
+                size_t const blockSize = (index + 1) * FF_PROCESS_POOL_BLOCK_GRANULARITY;
+                char* const chunk = static_cast<char*>(::operator new(blockSize * FF_PROCESS_POOL_BLOCKS_PER_CHUNK));
+                for(size_t i = 0; i < FF_PROCESS_POOL_BLOCKS_PER_CHUNK; i++) {
+                    FreeBlock* const block = reinterpret_cast<FreeBlock*>(chunk + i * blockSize);
+                    block->next = sizeClass.freeBlocks;
+                    sizeClass.freeBlocks = block;
+                }
+                sizeClass.freeBlockCount += FF_PROCESS_POOL_BLOCKS_PER_CHUNK;
+            }
+
+            FreeBlock* const block = sizeClass.freeBlocks;
+            sizeClass.freeBlocks = block->next;
+            sizeClass.freeBlockCount--;
+            return block;
+        }
+        void deallocate(void* const& ptr, const size_t& size) {
+            if(size == 0 || size > FF_PROCESS_POOL_MAX_BLOCK_SIZE) {
+                ::operator delete(ptr);
+                return;
+            }
+
+            SizeClass& sizeClass = getSizeClasses()[getSizeClassIndex(size)];
+            std::lock_guard<std::mutex> lock(sizeClass.mutex);
+            FreeBlock* const block = static_cast<FreeBlock*>(ptr);
+            block->next = sizeClass.freeBlocks;
+            sizeClass.freeBlocks = block;
+            sizeClass.freeBlockCount++;
+        }
+
+        size_t getFreeBlockCount(const size_t& size) {
+            if(size == 0 || size > FF_PROCESS_POOL_MAX_BLOCK_SIZE) {
+                return 0;
+            }
+            SizeClass& sizeClass = getSizeClasses()[getSizeClassIndex(size)];
+            std::lock_guard<std::mutex> lock(sizeClass.mutex);
+            return sizeClass.freeBlockCount;
+        }
+    }
+}
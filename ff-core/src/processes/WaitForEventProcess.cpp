@@ -25,11 +25,11 @@ namespace ff {
         ff::Locator::getMessageBus().removeListener(this);
     }
 
-    bool WaitForEventProcess::processEvent(const std::shared_ptr<ff::Event>& message) {
+    bool WaitForEventProcess::processEvent(const ff::Event& message) {
         for (auto it = _messageNames.begin();
             it != _messageNames.end();
             it++) {
-            if ((*it) == message->getName()) {
+            if ((*it) == message.getName()) {
                 kill();
                 return false;
             }
@@ -29,11 +29,11 @@ namespace ff {
         return _timer;
     }
     
-    bool WaitOrKillOnEventProcess::processEvent(const std::shared_ptr<ff::Event>& message) {
+    bool WaitOrKillOnEventProcess::processEvent(const ff::Event& message) {
         for (auto it = _messageNames.begin();
             it != _messageNames.end();
             it++) {
-            if ((*it) == message->getName()) {
+            if ((*it) == message.getName()) {
                 kill();
                 return false;
             }
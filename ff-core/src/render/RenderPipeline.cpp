@@ -41,8 +41,9 @@ bool RenderPipeline::processEvent(PopulateImGuiFrameEvent const& event) {
     if(CVars::get<bool>("debug_show_render_pipeline")) {
         ImGui::SetNextWindowSize(ImVec2(720, 480),
             ImGuiCond_FirstUseEver);
+        bool open = true;
         if(ImGui::Begin("Render Pipeline Editor",
-            &CVars::get<bool>("debug_show_render_pipeline"),
+            &open,
             ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse)) {
             ImNodes::Ez::BeginCanvas();
 
@@ -74,6 +75,9 @@ bool RenderPipeline::processEvent(PopulateImGuiFrameEvent const& event) {
             ImNodes::Ez::EndCanvas();
         }
         ImGui::End();
+        if(!open) {
+            CVars::set<bool>("debug_show_render_pipeline", false);
+        }
     }
 
     return false;
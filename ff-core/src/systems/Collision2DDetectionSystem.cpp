@@ -8,14 +8,10 @@
 
 #include <ff/components/TransformComponent.hpp>
 
-#include <unordered_map>
-#include <unordered_set>
-#include <limits>
 #include <ff/Console.hpp>
-#include <ff/math/VectorHelper.hpp>
 #include <ff/math/Rectangle.hpp>
-#include <ff/math/Circle.hpp>
 
+#include <ff/Locator.hpp>
 #include <ff/messages/MessageBus.hpp>
 #include <ff/events/collision/CollisionStartEvent.hpp>
 #include <ff/events/collision/CollisionEndEvent.hpp>
@@ -26,358 +22,397 @@
 
 #include <chrono>
 #include <algorithm>
+#include <limits>
 
 #include <ff/util/Macros.hpp>
 
 namespace ff {
-    Collision2DDetectionSystem::Collision2DDetectionSystem(ActorManager* const& actorManagerPtr, ProcessPriority_t const& priority)
-        :_actorManagerPtr(actorManagerPtr) {
+    namespace {
+        // Pairs per narrow phase job; several, so that the batch tests have
+        // something to work with
+        constexpr size_t narrowPhaseGrainSize = 32;
+    }
+
+    Collision2DDetectionSystem::Collision2DDetectionSystem(ActorManager* const& actorManagerPtr, ProcessPriority_t const& priority,
+        float const& gridCellSize)
+        :_actorManagerPtr(actorManagerPtr),
+        _staticBroadPhase(std::make_unique<Collision2DGrid>(gridCellSize)),
+        _updateCount(0) {
         FF_UNUSED(priority);
     }
     Collision2DDetectionSystem::~Collision2DDetectionSystem() {
     }
 
+    void Collision2DDetectionSystem::setGridCellSize(float const& gridCellSize) {
+        setStaticBroadPhase(std::make_unique<Collision2DGrid>(gridCellSize));
+    }
+    void Collision2DDetectionSystem::setStaticBroadPhase(std::unique_ptr<Collision2DBroadPhase> broadPhase) {
+        FF_ASSERT(broadPhase != nullptr, "Collision broad phase must not be null.");
+        _staticBroadPhase = std::move(broadPhase);
+        // Every collider's proxy is now invalid, so each is recreated on the next update
+        _staticColliders.clear();
+    }
+    const Collision2DBroadPhase& Collision2DDetectionSystem::getStaticBroadPhase() const {
+        return *_staticBroadPhase;
+    }
+
+    void Collision2DDetectionSystem::queryAABB(const Rectangle& aabb, std::vector<Actor_t>& actors) const {
+        thread_local std::vector<Collision2DProxy> proxies;
+        proxies.clear();
+        _staticBroadPhase->query(aabb, proxies);
+        for(Collision2DProxy const& proxy : proxies) {
+            actors.push_back(_staticBroadPhase->getActor(proxy));
+        }
+    }
+    void Collision2DDetectionSystem::queryRay(const glm::vec2& from, const glm::vec2& to, std::vector<Actor_t>& actors) const {
+        thread_local std::vector<Collision2DProxy> proxies;
+        proxies.clear();
+        _staticBroadPhase->queryRay(from, to, proxies);
+        for(Collision2DProxy const& proxy : proxies) {
+            actors.push_back(_staticBroadPhase->getActor(proxy));
+        }
+    }
+
     void Collision2DDetectionSystem::onUpdate(const float& dt) {
         FF_CONSOLE_WARN("2D collision detection system is not updated to support multi-axis stretch.");
 
         FF_UNUSED(dt);
 
-        std::unordered_map<Actor_t, std::unordered_set<Actor_t>> processedPairs; // TODO: This can be achieved with pairs (or specialized struct), probably will be faster
-        _actorManagerPtr->getActorsFor(Family::all<TransformComponent, Collision2DComponent, DynamicColliderComponent>().get())
-            .each([this, &processedPairs](Actor_t actorA) {
-            auto& transformCompA = _actorManagerPtr->getComponent<TransformComponent>(actorA);
-            auto& collisionCompA = _actorManagerPtr->getComponent<Collision2DComponent>(actorA);
-
-            float cosA = glm::cos(transformCompA.get2DRotation()),
-                sinA = glm::sin(transformCompA.get2DRotation());
-
-            _actorManagerPtr->getActorsFor(Family::all<TransformComponent, Collision2DComponent>().one<StaticColliderComponent, KinematicColliderComponent>().get())
-                .each([this, &processedPairs, actorA, &transformCompA, &collisionCompA, cosA, sinA](Actor_t actorB) {
-                auto& transformCompB = _actorManagerPtr->getComponent<TransformComponent>(actorB);
-                auto& collisionCompB = _actorManagerPtr->getComponent<Collision2DComponent>(actorB);
-
-                if(actorA == actorB) {
-                    return;
-                }
-                if(processedPairs[actorA].find(actorB) != processedPairs[actorA].end()) {
-                    return;
-                }
-                if(processedPairs[actorB].find(actorA) != processedPairs[actorB].end()) {
-                    return;
-                }
-
-                // Add it to entityB's list because A->B won't occur again (B->A might)
-                processedPairs[actorB].insert(actorA);
+        updateStaticBroadPhase();
+
+        _dynamicColliders.clear();
+        size_t dynamicWorldShapeCount = 0;
+        for(auto [actor, transformComp, collisionComp, dynamicComp] : _actorManagerPtr->view<TransformComponent, Collision2DComponent, DynamicColliderComponent>()) {
+            bool const inBothSets = _actorManagerPtr->hasComponent<StaticColliderComponent>(actor)
+                || _actorManagerPtr->hasComponent<KinematicColliderComponent>(actor);
+            glm::vec2 const displacement = transformComp.get2DPosition() - transformComp.getLast2DPosition();
+            bool const swept = dynamicComp.continuous && displacement != glm::vec2(0);
+            _dynamicColliders.push_back({ { actor, &transformComp, &collisionComp, inBothSets }, dynamicWorldShapeCount, swept, displacement });
+            dynamicWorldShapeCount += collisionComp.shapes.size();
+        }
+        if(_dynamicWorldShapes.size() < dynamicWorldShapeCount) {
+            _dynamicWorldShapes.resize(dynamicWorldShapeCount);
+            _dynamicLastWorldShapes.resize(dynamicWorldShapeCount);
+        }
 
-                if((collisionCompA.mask & collisionCompB.group) == 0
-                    && (collisionCompB.mask & collisionCompA.group) == 0) {
-                    return;
+        // The queries and shape tests only read components, so dynamic actors
+        // are queried in parallel, then the pairs found are tested in parallel
+        if(_candidates.size() < _dynamicColliders.size()) {
+            _candidates.resize(_dynamicColliders.size());
+        }
+        ff::Locator::getJobSystem().parallelFor(_dynamicColliders.size(), 1, [this](size_t begin, size_t end) {
+            for(size_t i = begin; i < end; ++i) {
+                DynamicCollider const& collider = _dynamicColliders[i];
+                TransformComponent const& transformComp = *collider.ref.transformCompPtr;
+                computeWorldShapes(*collider.ref.collisionCompPtr, transformComp.get2DRotation(), transformComp.getScale(), transformComp.get2DPosition(),
+                    _dynamicWorldShapes.data() + collider.worldShapesBegin);
+                if(collider.swept) {
+                    computeWorldShapes(*collider.ref.collisionCompPtr, transformComp.getLast2DRotation(), transformComp.getScale(), transformComp.getLast2DPosition(),
+                        _dynamicLastWorldShapes.data() + collider.worldShapesBegin);
                 }
+                findCandidates(collider, _candidates[i]);
+            }
+        });
 
-                float cosB = glm::cos(transformCompB.get2DRotation()),
-                    sinB = glm::sin(transformCompB.get2DRotation());
-
-                bool resolved = false; // If true, _any_ of the shapes have intersected
-                bool intersecting = false;
-                glm::vec2 normA;
-                glm::vec2 normB;
-                float penetration;
-                for(auto shapeItA = collisionCompA.shapes.begin();
-                    shapeItA != collisionCompA.shapes.end();
-                    shapeItA++) {
-                    Rectangle AABB_A = (*shapeItA)->getAABB(cosA, sinA, transformCompA.getScale(), transformCompA.getPosition());
-
-                    for(auto shapeItB = collisionCompB.shapes.begin();
-                    shapeItB != collisionCompB.shapes.end();
-                    shapeItB++) {
-                        Rectangle AABB_B = (*shapeItB)->getAABB(cosB, sinB, transformCompB.getScale(), transformCompB.getPosition());
-
-                        if(AABB_B.intersects(AABB_A)) {
-                            // _May_ be intersecting
-                            glm::vec2 pA = transformCompA.get2DPosition()
-                                + VectorHelper::rotate((*shapeItA)->getOffset(), cosA, sinA) * transformCompA.getScale();
-                            glm::vec2 pB = transformCompB.get2DPosition()
-                                + VectorHelper::rotate((*shapeItB)->getOffset(), cosB, sinB) * transformCompB.getScale();
-                            if(checkShapeIntersection(pA, cosA, sinA, transformCompA.getScale(), **shapeItA, normA,
-                                pB, cosB, sinB, transformCompB.getScale(), **shapeItB, normB, penetration)) {
-                                intersecting = true;
-                                resolved = true;
-                                break;
-                            }
-                        } else {
-                            // Guaranteed to not be intersecting (this shape)
-                            continue;
-                        }
-                    }
-
-                    if(resolved) {
-                        break;
-                    }
+        _pairTests.clear();
+        for(size_t i = 0; i < _dynamicColliders.size(); ++i) {
+            for(Collision2DProxy const& colliderB : _candidates[i]) {
+                PairTest pairTest;
+                pairTest.colliderA = (uint32_t)i;
+                pairTest.colliderB = colliderB;
+                pairTest.actorA = _dynamicColliders[i].ref.actor;
+                pairTest.actorB = _staticColliders[colliderB].ref.actor;
+                pairTest.intersecting = false;
+                pairTest.penetration = 0;
+                _pairTests.push_back(pairTest);
+            }
+        }
+        ff::Locator::getJobSystem().parallelFor(_pairTests.size(), narrowPhaseGrainSize, [this](size_t begin, size_t end) {
+            // Pairs of the same dynamic collider are contiguous, and each run of
+            // them in the range is batched together
+            thread_local CandidateShapes candidateShapes;
+            while(begin < end) {
+                size_t runEnd = begin + 1;
+                while(runEnd < end && _pairTests[runEnd].colliderA == _pairTests[begin].colliderA) {
+                    ++runEnd;
                 }
+                testPairs(begin, runEnd, candidateShapes);
+                begin = runEnd;
+            }
+        });
 
-                bool previouslyIntersecting = collisionCompA._currentlyCollidingWith.find(actorB) != collisionCompA._currentlyCollidingWith.end()
-                    || collisionCompB._currentlyCollidingWith.find(actorA) != collisionCompB._currentlyCollidingWith.end();
-                if(!previouslyIntersecting && intersecting) {
-                    ff::Locator::getMessageBus().dispatch<CollisionStartEvent>(actorA, normA, actorB, normB, penetration);
-                    collisionCompA._currentlyCollidingWith.insert(actorB);
-                    collisionCompB._currentlyCollidingWith.insert(actorA);
-                }
-                if(previouslyIntersecting && !intersecting) {
-                    ff::Locator::getMessageBus().dispatch<CollisionEndEvent>(actorA, actorB);
-                    collisionCompA._currentlyCollidingWith.erase(actorB);
-                    collisionCompB._currentlyCollidingWith.erase(actorA);
-                }
-            });
+        // Only intersecting pairs become contacts, merged in actor pair order
+        // against the previous update's to find those that started or ended
+        _pairTests.erase(std::remove_if(_pairTests.begin(), _pairTests.end(), [](const PairTest& pairTest) {
+            return !pairTest.intersecting;
+        }), _pairTests.end());
+        std::sort(_pairTests.begin(), _pairTests.end(), [](const PairTest& a, const PairTest& b) {
+            return compareActorPairs(a.actorA, a.actorB, b.actorA, b.actorB);
         });
+        _contacts.clear();
+        size_t previousIndex = 0;
+        for(PairTest const& pairTest : _pairTests) {
+            while(previousIndex < _previousContacts.size()
+                && compareActorPairs(_previousContacts[previousIndex].actorA, _previousContacts[previousIndex].actorB, pairTest.actorA, pairTest.actorB)) {
+                endContact(_previousContacts[previousIndex++]);
+            }
+            if(previousIndex < _previousContacts.size()
+                && !compareActorPairs(pairTest.actorA, pairTest.actorB, _previousContacts[previousIndex].actorA, _previousContacts[previousIndex].actorB)) {
+                ++previousIndex;
+            } else {
+                startContact(pairTest);
+            }
+            _contacts.push_back({ pairTest.actorA, pairTest.actorB });
+        }
+        while(previousIndex < _previousContacts.size()) {
+            endContact(_previousContacts[previousIndex++]);
+        }
+        std::swap(_contacts, _previousContacts);
     }
 
-    bool Collision2DDetectionSystem::checkShapeIntersection(const glm::vec2& posA, const float& cosA, const float& sinA, const float& scaleA, const Collision2DShape& shapeA, glm::vec2& normA,
-        const glm::vec2& posB, const float& cosB, const float& sinB, const float& scaleB, const Collision2DShape& shapeB, glm::vec2& normB, float& penetration) {
-        CircleCollision2DShape const* circleA = dynamic_cast<CircleCollision2DShape const*>(&shapeA);
-        PolygonCollision2DShape const* polygonA = dynamic_cast<PolygonCollision2DShape const*>(&shapeA);
-
-        CircleCollision2DShape const* circleB = dynamic_cast<CircleCollision2DShape const*>(&shapeB);
-        PolygonCollision2DShape const* polygonB = dynamic_cast<PolygonCollision2DShape const*>(&shapeB);
+    void Collision2DDetectionSystem::updateStaticBroadPhase() {
+        _updateCount++;
+
+        for(auto [actor, transformComp, collisionComp] : _actorManagerPtr->view<TransformComponent, Collision2DComponent>(
+            Family::all<TransformComponent, Collision2DComponent>().one<StaticColliderComponent, KinematicColliderComponent>().get())) {
+            // Copied components (including ones moved between archetypes) start without a proxy
+            Collision2DProxy proxy = collisionComp._broadPhaseProxy;
+            bool const hasProxy = proxy < _staticColliders.size()
+                && _staticColliders[proxy].ref.actor == actor
+                && _staticColliders[proxy].lastSeenUpdate != _updateCount;
+            bool const moved = !hasProxy
+                || _staticColliders[proxy].position != transformComp.getPosition()
+                || _staticColliders[proxy].rotation != transformComp.getRotation()
+                || _staticColliders[proxy].scale != transformComp.getScale()
+                || _staticColliders[proxy].shapeCount != collisionComp.shapes.size();
+            if(moved) {
+                _movedWorldShapes.resize(collisionComp.shapes.size());
+                computeWorldShapes(collisionComp, transformComp.get2DRotation(), transformComp.getScale(), transformComp.get2DPosition(),
+                    _movedWorldShapes.data());
+                Rectangle const aabb = computeAABB(transformComp, _movedWorldShapes.data(), _movedWorldShapes.size());
+                if(hasProxy) {
+                    _staticBroadPhase->moveProxy(proxy, aabb);
+                } else {
+                    proxy = _staticBroadPhase->createProxy(aabb, actor);
+                    collisionComp._broadPhaseProxy = proxy;
+                    if(proxy >= _staticColliders.size()) {
+                        _staticColliders.resize(proxy + 1, StaticCollider{ { NullActor, nullptr, nullptr, false } });
+                    }
+                }
 
-        // TODO: Get rid of dynamic cast and use enum/int instead
+                StaticCollider& staticCollider = _staticColliders[proxy];
+                // Swapped rather than copied, so both buffers are reused by later moves
+                staticCollider.worldShapes.swap(_movedWorldShapes);
+                staticCollider.position = transformComp.getPosition();
+                staticCollider.rotation = transformComp.getRotation();
+                staticCollider.scale = transformComp.getScale();
+                staticCollider.shapeCount = collisionComp.shapes.size();
+            }
 
-        if(circleA != nullptr && circleB != nullptr) {
-            return checkCircleCircleIntersection(posA, *circleA, scaleA, normA,
-                posB, *circleB, scaleB, normB, penetration);
+            StaticCollider& staticCollider = _staticColliders[proxy];
+            // Component addresses aren't stable with archetype storage, so they're refreshed every update
+            staticCollider.ref = { actor, &transformComp, &collisionComp, _actorManagerPtr->hasComponent<DynamicColliderComponent>(actor) };
+            staticCollider.lastSeenUpdate = _updateCount;
         }
 
-        if(circleB != nullptr && polygonA != nullptr) {
-            return checkPolygonCircleIntersection(posA, cosA, sinA, scaleA, *polygonA, normA,
-                posB, *circleB, scaleB, normB, penetration);
-        }
-        if(circleA != nullptr && polygonB != nullptr) {
-            return checkPolygonCircleIntersection(posB, cosB, sinB, scaleB, *polygonB, normB,
-                posA, *circleA, scaleA, normA, penetration);
+        // Colliders that weren't seen were destroyed or lost a component
+        for(Collision2DProxy proxy = 0; proxy < _staticColliders.size(); ++proxy) {
+            StaticCollider& staticCollider = _staticColliders[proxy];
+            if(staticCollider.ref.actor != NullActor && staticCollider.lastSeenUpdate != _updateCount) {
+                _staticBroadPhase->destroyProxy(proxy);
+                staticCollider.ref.actor = NullActor;
+            }
         }
+    }
 
-        if(polygonA != nullptr && polygonB != nullptr) {
-            return checkPolygonPolygonIntersection(posA, cosA, sinA, scaleA, *polygonA, normA,
-                posB, cosB, sinB, scaleB, *polygonB, normB, penetration);
+    void Collision2DDetectionSystem::findCandidates(const DynamicCollider& colliderA, std::vector<Collision2DProxy>& candidates) {
+        Actor_t const actorA = colliderA.ref.actor;
+        TransformComponent const& transformCompA = *colliderA.ref.transformCompPtr;
+        Collision2DComponent const& collisionCompA = *colliderA.ref.collisionCompPtr;
+        Collision2DWorldShape const* const worldShapesA = _dynamicWorldShapes.data() + colliderA.worldShapesBegin;
+
+        candidates.clear();
+        Rectangle aabb = computeAABB(transformCompA, worldShapesA, collisionCompA.shapes.size());
+        if(colliderA.swept) {
+            // The sweep moves the shapes as they were on the last update, so the
+            // query covers their path as well as where they are now
+            Rectangle const lastAABB = computeAABB(transformCompA, _dynamicLastWorldShapes.data() + colliderA.worldShapesBegin, collisionCompA.shapes.size());
+            aabb = Rectangle(glm::min(aabb.getBottomLeft(), glm::min(lastAABB.getBottomLeft(), lastAABB.getBottomLeft() + colliderA.displacement)),
+                glm::max(aabb.getTopRight(), glm::max(lastAABB.getTopRight(), lastAABB.getTopRight() + colliderA.displacement)));
         }
+        _staticBroadPhase->query(aabb, candidates);
 
-        FF_CONSOLE_ERROR("Unknown 2D collision case.");
-
-        return false;
+        candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [&](const Collision2DProxy& colliderB) {
+            ColliderRef const& refB = _staticColliders[colliderB].ref;
+            if(actorA == refB.actor) {
+                return true;
+            }
+            // An actor in both sets would see each such pair twice (once from each
+            // side), so only the side with the lower actor tests it
+            if(colliderA.ref.inBothSets && refB.inBothSets && refB.actor < actorA) {
+                return true;
+            }
+            Collision2DComponent const& collisionCompB = *refB.collisionCompPtr;
+            return (collisionCompA.mask & collisionCompB.group) == 0
+                && (collisionCompB.mask & collisionCompA.group) == 0;
+        }), candidates.end());
     }
-    bool Collision2DDetectionSystem::checkCircleCircleIntersection(const glm::vec2& posA, const CircleCollision2DShape& circleA, const float& scaleA, glm::vec2& normA,
-        const glm::vec2& posB, const CircleCollision2DShape& circleB, const float& scaleB, glm::vec2& normB, float& penetration) {
-        float const distance = glm::distance(posB, posA);
-        bool colliding = distance < circleB.getRadius() * scaleB + circleA.getRadius() * scaleA;
-        if(colliding) {
-            if(distance > 0) {
-                normA = glm::normalize(posB - posA);
-                normB = -normA;
-            } else {
-                normA = normB = glm::vec2(0, 0);
+
+    void Collision2DDetectionSystem::testPairs(const size_t& begin, const size_t& end, CandidateShapes& candidateShapes) {
+        DynamicCollider const& colliderA = _dynamicColliders[_pairTests[begin].colliderA];
+        Collision2DWorldShape const* const worldShapesA = _dynamicWorldShapes.data() + colliderA.worldShapesBegin;
+        size_t const shapeCountA = colliderA.ref.collisionCompPtr->shapes.size();
+
+        candidateShapes.bounds.clear();
+        candidateShapes.centerX.clear();
+        candidateShapes.centerY.clear();
+        candidateShapes.radii.clear();
+        candidateShapes.shapes.clear();
+        candidateShapes.pairTests.clear();
+        for(size_t i = begin; i < end; i++) {
+            for(Collision2DWorldShape const& shapeB : _staticColliders[_pairTests[i].colliderB].worldShapes) {
+                bool const isCircle = shapeB.type == Collision2DShapeType::CIRCLE;
+                candidateShapes.bounds.push_back(shapeB.min, shapeB.max);
+                candidateShapes.centerX.push_back(shapeB.position.x);
+                candidateShapes.centerY.push_back(shapeB.position.y);
+                candidateShapes.radii.push_back(isCircle ? shapeB.radius : std::numeric_limits<float>::quiet_NaN());
+                candidateShapes.shapes.push_back(&shapeB);
+                candidateShapes.pairTests.push_back((uint32_t)i);
             }
-            penetration = (circleA.getRadius() * scaleA + circleB.getRadius() * scaleB) - distance;
         }
-        return colliding;
-    }
-    bool Collision2DDetectionSystem::checkPolygonCircleIntersection(const glm::vec2& posA, const float& cosA, const float& sinA, const float& scaleA, const PolygonCollision2DShape& polygonA, glm::vec2& normA,
-        const glm::vec2& posB, const CircleCollision2DShape& circleB, const float& scaleB, glm::vec2& normB, float& penetration) {
-        // @todo This case fails if the circle is fully enclosed by the polygon.
-        // Rare, but possible.
-
-        std::vector<glm::vec2> worldPolyA;
-        worldPolyA.resize(polygonA.getVertices().size());
-        for(size_t i = 0; i < polygonA.getVertices().size(); i++) {
-            worldPolyA[i] = VectorHelper::rotate(polygonA.getVertices()[i], cosA, sinA) * scaleA + posA;
+        size_t const shapeCountB = candidateShapes.shapes.size();
+        if(shapeCountB == 0) {
+            return;
         }
-
-        Circle worldCircleB(posB, circleB.getRadius() * scaleB);
-
-        glm::vec2 closestV1, closestV2;
-        float closestDistanceToCircle = -1;
-        glm::vec2 closestVert;
-        float closestVertDistance = -1;
-        for(size_t i = 0; i < worldPolyA.size(); i++) {
-            glm::vec2& v2 = worldPolyA[i];
-
-            // Closest vertex
-            float vertDistanceToCircle = glm::distance(worldCircleB.getPosition(), v2);
-            if(closestVertDistance < 0
-                || vertDistanceToCircle < closestVertDistance) {
-                closestVertDistance = vertDistanceToCircle;
-                closestVert = v2;
+        size_t const wordCount = Collision2DBatch::getMaskWordCount(shapeCountB);
+        candidateShapes.circleMasks.assign(wordCount, 0);
+        candidateShapes.overlapMasks.resize(wordCount);
+        candidateShapes.circleOverlapMasks.resize(wordCount);
+        for(size_t i = 0; i < shapeCountB; i++) {
+            if(candidateShapes.shapes[i]->type == Collision2DShapeType::CIRCLE) {
+                candidateShapes.circleMasks[i / FF_COLLISION_2D_BATCH_MASK_BITS] |= 1u << (i % FF_COLLISION_2D_BATCH_MASK_BITS);
             }
+        }
 
-            // Closest segment
-            size_t j = (i + 1) % worldPolyA.size();
-
-            glm::vec2& v1 = worldPolyA[j];
-
-            // Distance from circle center to segment
-            float circleOnSegment = glm::dot(worldCircleB.getPosition() - v1, glm::normalize(v2 - v1));
-            float hyp = glm::distance(worldCircleB.getPosition(), v1);
-            float circleToSegment = glm::sqrt(hyp * hyp - circleOnSegment * circleOnSegment);
-
-            if(circleOnSegment > 0 && circleOnSegment < glm::distance(v2, v1)) { // If distance is on segment
-                if(closestDistanceToCircle < 0 // First loop
-                    || circleToSegment < closestDistanceToCircle) {
-                    closestV1 = v1;
-                    closestV2 = v2;
-                    closestDistanceToCircle = circleToSegment;
+        for(size_t shapeIndexA = 0; shapeIndexA < shapeCountA; shapeIndexA++) {
+            Collision2DWorldShape const& shapeA = worldShapesA[shapeIndexA];
+            candidateShapes.bounds.overlap(shapeA.min, shapeA.max, 0, shapeCountB, candidateShapes.overlapMasks.data());
+            if(shapeA.type == Collision2DShapeType::CIRCLE) {
+                // Circle pairs that only overlap as boxes can be skipped too
+                Collision2DBatch::overlapCircles(shapeA.position, shapeA.radius,
+                    candidateShapes.centerX.data(), candidateShapes.centerY.data(), candidateShapes.radii.data(), shapeCountB,
+                    candidateShapes.circleOverlapMasks.data());
+                for(size_t word = 0; word < wordCount; word++) {
+                    candidateShapes.overlapMasks[word] = candidateShapes.circleOverlapMasks[word]
+                        | (candidateShapes.overlapMasks[word] & ~candidateShapes.circleMasks[word]);
                 }
             }
-        }
-        FF_ASSERT(closestDistanceToCircle >= 0 || closestVertDistance >= 0, "Circle-polygon closest distance to segment/vertex algorithm failed.");
-        if(closestDistanceToCircle < 0) {
-            if(worldCircleB.contains(closestVert)) {
-                normA = glm::normalize(posB - closestVert);
-                normB = -normA;
-                penetration = glm::distance(posB, closestVert);
-                return true;
-            }
-            // Since we couldn't find a closest segment, we must not be touching the polygon
-            return false;
-        }
 
-        // We have the closest segment of the polygon.
-        // Next, find which Voronoi region the circle is in.
-
-        // Cast circle position onto segment
-        glm::vec2 segment = closestV2 - closestV1;
-        glm::vec2 segmentNormalized = glm::normalize(segment);
-        float circleOnSegment = glm::dot(segmentNormalized, worldCircleB.getPosition() - closestV1);
-
-        // If the circle is along the segment, it's on the face
-        // region and we can get the normal.
-        if(circleOnSegment > 0
-            || circleOnSegment < glm::length(segment)) {
-            // Find point along segment closest to the circle (perpendicular from segment to circle center)
-            glm::vec2 intersectionPoint = segmentNormalized * circleOnSegment + closestV1;
-            normA = glm::normalize(posB - intersectionPoint);
-            normB = -normA;;
-            penetration = glm::distance(posB, intersectionPoint);
-            return true;
+            // _May_ be intersecting
+            Collision2DBatch::forEachSetBit(candidateShapes.overlapMasks.data(), wordCount, [&](const size_t& shapeIndexB) {
+                PairTest& pairTest = _pairTests[candidateShapes.pairTests[shapeIndexB]];
+                if(!pairTest.intersecting
+                    && Collision2DNarrowPhase::testShapes(shapeA, pairTest.normA, *candidateShapes.shapes[shapeIndexB], pairTest.normB, pairTest.penetration)) {
+                    pairTest.intersecting = true;
+                }
+            });
         }
 
-        bool containsEndpoint = false;
-        glm::vec2 endpoint;
-        if(worldCircleB.contains(closestV1)) {
-            FF_ASSERT(!containsEndpoint, "Circle contains two points of the polygon; this is not handled yet.");
-            containsEndpoint = true;
-            endpoint = closestV1;
-        }
-        if(worldCircleB.contains(closestV2)) {
-            FF_ASSERT(!containsEndpoint, "Circle contains two points of the polygon; this is not handled yet.");
-            containsEndpoint = true;
-            endpoint = closestV2;
+        if(colliderA.swept) {
+            sweepPairs(begin, end, candidateShapes);
         }
-        if(containsEndpoint) {
-            penetration = glm::distance(posB, endpoint);
-            if(penetration > 0) {
-                normA = glm::normalize(posB - endpoint);
-                normB = -normA;
-            } else {
-                normA = normB = glm::vec2(0, 0);
-            }
+    }
 
-            return true;
+    void Collision2DDetectionSystem::sweepPairs(const size_t& begin, const size_t& end, CandidateShapes& candidateShapes) {
+        DynamicCollider const& colliderA = _dynamicColliders[_pairTests[begin].colliderA];
+        Collision2DWorldShape const* const lastWorldShapesA = _dynamicLastWorldShapes.data() + colliderA.worldShapesBegin;
+        size_t const shapeCountA = colliderA.ref.collisionCompPtr->shapes.size();
+        size_t const shapeCountB = candidateShapes.shapes.size();
+        size_t const wordCount = Collision2DBatch::getMaskWordCount(shapeCountB);
+        glm::vec2 const& displacement = colliderA.displacement;
+
+        // Pairs not intersecting now may still have met on the way here, and the
+        // earliest meeting of their shapes is the one kept
+        candidateShapes.sweepFractions.assign(end - begin, std::numeric_limits<float>::max());
+        candidateShapes.sweepNormals.resize(end - begin);
+        for(size_t shapeIndexA = 0; shapeIndexA < shapeCountA; shapeIndexA++) {
+            Collision2DWorldShape const& shapeA = lastWorldShapesA[shapeIndexA];
+            candidateShapes.bounds.overlap(glm::min(shapeA.min, shapeA.min + displacement), glm::max(shapeA.max, shapeA.max + displacement),
+                0, shapeCountB, candidateShapes.overlapMasks.data());
+
+            Collision2DBatch::forEachSetBit(candidateShapes.overlapMasks.data(), wordCount, [&](const size_t& shapeIndexB) {
+                size_t const pairIndex = candidateShapes.pairTests[shapeIndexB];
+                float fraction;
+                glm::vec2 normA;
+                if(!_pairTests[pairIndex].intersecting
+                    && Collision2DNarrowPhase::sweepShapes(shapeA, displacement, *candidateShapes.shapes[shapeIndexB], fraction, normA)
+                    && fraction < candidateShapes.sweepFractions[pairIndex - begin]) {
+                    candidateShapes.sweepFractions[pairIndex - begin] = fraction;
+                    candidateShapes.sweepNormals[pairIndex - begin] = normA;
+                }
+            });
         }
 
-        return false;
+        for(size_t i = begin; i < end; i++) {
+            float const fraction = candidateShapes.sweepFractions[i - begin];
+            if(fraction > 1) {
+                continue;
+            }
+            // How far past the point of contact the collider went along the normal
+            PairTest& pairTest = _pairTests[i];
+            pairTest.intersecting = true;
+            pairTest.normA = candidateShapes.sweepNormals[i - begin];
+            pairTest.normB = -pairTest.normA;
+            pairTest.penetration = (1 - fraction) * glm::abs(glm::dot(displacement, pairTest.normA));
+        }
     }
-    bool Collision2DDetectionSystem::checkPolygonPolygonIntersection(const glm::vec2& posA, const float& cosA, const float& sinA, const float& scaleA, const PolygonCollision2DShape& polygonA, glm::vec2& normA,
-        const glm::vec2& posB, const float& cosB, const float& sinB, const float& scaleB, const PolygonCollision2DShape& polygonB, glm::vec2& normB, float& penetration) {
 
-        std::vector<glm::vec2> worldPolyA;
-        worldPolyA.resize(polygonA.getVertices().size());
-        for(size_t i = 0; i < polygonA.getVertices().size(); i++) {
-            worldPolyA[i] = VectorHelper::rotate(polygonA.getVertices()[i], cosA, sinA) * scaleA + posA;
+    void Collision2DDetectionSystem::startContact(const PairTest& pairTest) {
+        ff::Locator::getMessageBus().enqueue<CollisionStartEvent>(pairTest.actorA, pairTest.normA, pairTest.actorB, pairTest.normB, pairTest.penetration);
+        _dynamicColliders[pairTest.colliderA].ref.collisionCompPtr->_collidingCount++;
+        _staticColliders[pairTest.colliderB].ref.collisionCompPtr->_collidingCount++;
+    }
+    void Collision2DDetectionSystem::endContact(const Contact& contact) {
+        if(_actorManagerPtr->isActorAlive(contact.actorA) && _actorManagerPtr->isActorAlive(contact.actorB)) {
+            ff::Locator::getMessageBus().enqueue<CollisionEndEvent>(contact.actorA, contact.actorB);
         }
-
-        std::vector<glm::vec2> worldPolyB;
-        worldPolyB.resize(polygonB.getVertices().size());
-        for(size_t i = 0; i < polygonB.getVertices().size(); i++) {
-            worldPolyB[i] = VectorHelper::rotate(polygonB.getVertices()[i], cosB, sinB) * scaleB + posB;
+        decrementCollidingCount(contact.actorA);
+        decrementCollidingCount(contact.actorB);
+    }
+    void Collision2DDetectionSystem::decrementCollidingCount(const Actor_t& actor) {
+        // The actor may have been destroyed, or lost (and maybe regained) its collider
+        if(!_actorManagerPtr->isActorAlive(actor)
+            || !_actorManagerPtr->hasComponent<Collision2DComponent>(actor)) {
+            return;
         }
-
-        size_t indexA;
-        float penetrationBA = findAxisOfLeastPenetration(indexA, worldPolyA, worldPolyB);
-
-        size_t indexB;
-        float penetrationAB = findAxisOfLeastPenetration(indexB, worldPolyB, worldPolyA);
-
-        if(penetrationBA >= 0 && penetrationAB < 0) {
-            penetration = penetrationBA;
-
-            // Face is on A
-            normA = VectorHelper::normal(worldPolyA[indexA] - worldPolyA[(indexA + 1) % worldPolyA.size()]);
-            normB = -normA;
-            return true;
-        } else if(penetrationBA < 0 && penetrationAB >= 0) {
-            penetration = penetrationAB;
-
-            // Face is on B
-            normB = VectorHelper::normal(worldPolyB[indexB] - worldPolyB[(indexB + 1) % worldPolyB.size()]);
-            normA = -normB;
-            return true;
-        } else if(penetrationBA >= 0 && penetrationAB >= 0) {
-            if(penetrationBA > penetrationAB) {
-                penetration = penetrationBA;
-
-                // Face is on A
-                normA = VectorHelper::normal(worldPolyA[indexA] - worldPolyA[(indexA + 1) % worldPolyA.size()]);
-                normB = -normA;
-            } else {
-                penetration = penetrationAB;
-                
-                // Face is on B
-                normB = VectorHelper::normal(worldPolyB[indexB] - worldPolyB[(indexB + 1) % worldPolyB.size()]);
-                normA = -normB;
-            }
-            return true;
+        Collision2DComponent& collisionComp = _actorManagerPtr->getComponent<Collision2DComponent>(actor);
+        if(collisionComp._collidingCount > 0) {
+            collisionComp._collidingCount--;
         }
-
-        return false;
     }
 
-    glm::vec2 Collision2DDetectionSystem::computeSupport(const std::vector<glm::vec2>& verts, const glm::vec2& dir) {
-        float bestProjection = -std::numeric_limits<float>::max();
-        glm::vec2 bestVertex;
-
-        for(size_t i = 0; i < verts.size(); i++) {
-            const glm::vec2& v = verts[i];
-            float projection = glm::dot(v, dir);
-
-            if(projection > bestProjection) {
-                bestProjection = projection;
-                bestVertex = v;
-            }
+    void Collision2DDetectionSystem::computeWorldShapes(const Collision2DComponent& collisionComp, const float& rotation, const float& scale, const glm::vec2& position,
+        Collision2DWorldShape* const& worldShapes) {
+        float const cos = glm::cos(rotation),
+            sin = glm::sin(rotation);
+        for(size_t i = 0; i < collisionComp.shapes.size(); i++) {
+            Collision2DNarrowPhase::computeWorldShape(*collisionComp.shapes[i], cos, sin, scale, position,
+                worldShapes[i]);
         }
-
-        return bestVertex;
     }
-    float Collision2DDetectionSystem::findAxisOfLeastPenetration(size_t& faceIndex, const std::vector<glm::vec2>& vertsA, const std::vector<glm::vec2>& vertsB) {
-        float bestDistance = -std::numeric_limits<float>::max();
-        size_t bestIndex;
-
-        for(size_t i = 0; i < vertsA.size(); i++) {
-            const glm::vec2& n = VectorHelper::normal(vertsA[i] - vertsA[(i + 1) % vertsA.size()]);
-
-            // Support point from B along -n
-            glm::vec2 sB = computeSupport(vertsB, -n);
-
-            glm::vec2 vA = vertsA[i];
-
-            // Compute penetration distance
-            float d = glm::dot(n, sB - vA);
-
-            // Find greatest distance
-            if(d > bestDistance) {
-                bestDistance = d;
-                bestIndex = i;
-            }
+    bool Collision2DDetectionSystem::compareActorPairs(const Actor_t& actorA1, const Actor_t& actorB1, const Actor_t& actorA2, const Actor_t& actorB2) {
+        Actor_t const low1 = std::min(actorA1, actorB1), low2 = std::min(actorA2, actorB2);
+        return low1 != low2 ? low1 < low2 : std::max(actorA1, actorB1) < std::max(actorA2, actorB2);
+    }
+    Rectangle Collision2DDetectionSystem::computeAABB(const TransformComponent& transformComp, const Collision2DWorldShape* const& worldShapes, const size_t& shapeCount) {
+        if(shapeCount == 0) {
+            return Rectangle(transformComp.get2DPosition(), transformComp.get2DPosition());
         }
-
-        faceIndex = bestIndex;
-        return bestDistance;
+        glm::vec2 bottomLeft(worldShapes[0].min), topRight(worldShapes[0].max);
+        for(size_t i = 1; i < shapeCount; i++) {
+            bottomLeft = glm::min(bottomLeft, worldShapes[i].min);
+            topRight = glm::max(topRight, worldShapes[i].max);
+        }
+        return Rectangle(bottomLeft, topRight);
     }
 }
@@ -9,17 +9,22 @@
 #include <ff/components/TransformComponent.hpp>
 
 #include <ff/Locator.hpp>
+#include <ff/processes/ParallelEach.hpp>
 
 namespace ff {
     TransformResetSystem::TransformResetSystem()
         :Process(ProcessPriority::EXTREMELY_LOW),
         _readyForTransformReset(true) {
+        declareWrites<TransformComponent>();
+    }
+
+    void TransformResetSystem::onInitialize() {
+        ff::Locator::getActorManager().prepareComponentStorage<TransformComponent>();
     }
 
     void TransformResetSystem::onUpdate(const float& dt) {
-        auto& actors = ff::Locator::getActorManager().getActorsFor(Family::all<TransformComponent>().get());
-        actors.each([this](Actor_t actor) {
-            ff::Locator::getActorManager().getComponent<TransformComponent>(actor).resetAll();
+        parallelEach(ff::Locator::getActorManager().view<TransformComponent>(), [](Actor_t actor, TransformComponent& transformComp) {
+            transformComp.resetAll();
         });
     }
 }
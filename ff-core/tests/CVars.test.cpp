@@ -0,0 +1,29 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <ff/CVars.hpp>
+
+FF_CVAR_DEFINE(test_cvar_handle, float, 1.0f, ff::CVarFlags::HOT_MODIFY, "Test CVar for `CVarHandle`.")
+
+TEST_CASE("CVar handles read the current value of the CVar.", "[cvars]") {
+    ff::CVarHandle<float> handle("test_cvar_handle");
+    ff::CVars::set<float>("test_cvar_handle", 2.0f);
+    REQUIRE(handle.get() == 2.0f);
+    REQUIRE(&handle.get() == &ff::CVars::get<float>("test_cvar_handle"));
+}
+
+TEST_CASE("CVar handles are notified when the CVar is modified.", "[cvars]") {
+    ff::CVarHandle<float> handle("test_cvar_handle");
+    REQUIRE(!handle.pollChanged());
+    handle.set(3.0f);
+    REQUIRE(handle.pollChanged());
+    REQUIRE(!handle.pollChanged());
+    ff::CVars::getRawCVar("test_cvar_handle")->resetToDefault();
+    REQUIRE(handle.pollChanged());
+    REQUIRE(handle.get() == 1.0f);
+}
@@ -0,0 +1,125 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <ff/actors/ActorManager.hpp>
+#include <ff/actors/ActorCommandBuffer.hpp>
+#include <ff/actors/Family.hpp>
+#include <ff/processes/JobSystem.hpp>
+
+#include <memory>
+#include <vector>
+
+using namespace ff;
+
+struct CommandPositionComponent : Component<CommandPositionComponent> {
+    CommandPositionComponent(const int& x = 0) : x(x) {}
+    int x;
+};
+struct CommandTagComponent : Component<CommandTagComponent> {
+    std::shared_ptr<int> resource = nullptr;
+};
+
+static void testCommandPlayback(ActorStorage const& storage) {
+    ActorManager manager(storage);
+    const IterableActorSet& tagged = manager.getActorsFor(Family::all<CommandTagComponent>().get());
+    const IterableActorSet& untagged = manager.getActorsFor(Family::exclude<CommandTagComponent>().get());
+
+    std::vector<Actor_t> actors;
+    for(int i = 0; i < 100; i++) {
+        actors.push_back(manager.createActor());
+        manager.addComponent<CommandPositionComponent>(actors.back(), i);
+    }
+
+    ActorCommandBuffer commandBuffer;
+    untagged.each([&commandBuffer, &manager](Actor_t actor) {
+        int x = manager.getComponent<CommandPositionComponent>(actor).x;
+        if(x % 2 == 0) {
+            commandBuffer.addComponent<CommandTagComponent>(actor);
+        }
+        if(x % 10 == 0) {
+            commandBuffer.destroyActor(actor);
+        }
+    });
+    Actor_t created = commandBuffer.createActor();
+    commandBuffer.addComponent<CommandPositionComponent>(created, 1000);
+    commandBuffer.addComponent<CommandTagComponent>(created);
+    commandBuffer.removeComponent<CommandPositionComponent>(actors[1]);
+
+    // Nothing changes until playback
+    REQUIRE(!commandBuffer.isEmpty());
+    REQUIRE(tagged.count() == 0);
+    REQUIRE(untagged.count() == 100);
+
+    commandBuffer.playback(manager);
+    REQUIRE(commandBuffer.isEmpty());
+    REQUIRE(tagged.count() == 41);
+    REQUIRE(untagged.count() == 50);
+    for(int i = 0; i < 100; i++) {
+        REQUIRE(manager.isActorAlive(actors[i]) == (i % 10 != 0));
+    }
+    REQUIRE(!manager.hasComponent<CommandPositionComponent>(actors[1]));
+
+    int createdCount = 0;
+    tagged.each([&manager, &createdCount](Actor_t actor) {
+        if(manager.getComponent<CommandPositionComponent>(actor).x == 1000) {
+            createdCount++;
+        }
+    });
+    REQUIRE(createdCount == 1);
+}
+
+TEST_CASE("Actor command buffers apply recorded commands on playback.", "[actors]") {
+    SECTION("With component maps.") {
+        testCommandPlayback(ActorStorage::COMPONENT_MAPS);
+    }
+    SECTION("With archetypes.") {
+        testCommandPlayback(ActorStorage::ARCHETYPES);
+    }
+}
+
+TEST_CASE("Actor command buffers destruct components that are never added.", "[actors]") {
+    ActorManager manager;
+    std::shared_ptr<int> resource = std::make_shared<int>(10);
+    Actor_t actor = manager.createActor();
+    {
+        ActorCommandBuffer commandBuffer;
+        CommandTagComponent tag;
+        tag.resource = resource;
+        commandBuffer.addComponent<CommandTagComponent>(actor, tag);
+        commandBuffer.destroyActor(actor);
+        REQUIRE(resource.use_count() == 3);
+
+        commandBuffer.playback(manager);
+        REQUIRE(!manager.isActorAlive(actor));
+        REQUIRE(resource.use_count() == 2);
+
+        commandBuffer.addComponent<CommandTagComponent>(manager.createActor(), tag);
+    }
+    REQUIRE(resource.use_count() == 1);
+}
+
+TEST_CASE("Actor command buffers can be recorded from worker threads.", "[actors]") {
+    ActorManager manager;
+    JobSystem jobSystem(3);
+    ActorCommandBuffer commandBuffer;
+    jobSystem.parallelFor(1000, 10, [&commandBuffer](size_t begin, size_t end) {
+        for(size_t i = begin; i < end; i++) {
+            Actor_t actor = commandBuffer.createActor();
+            commandBuffer.addComponent<CommandPositionComponent>(actor, (int)i);
+        }
+    });
+    commandBuffer.playback(manager);
+
+    std::vector<bool> seen(1000, false);
+    manager.getActorsFor(Family::all<CommandPositionComponent>().get()).each([&manager, &seen](Actor_t actor) {
+        seen[manager.getComponent<CommandPositionComponent>(actor).x] = true;
+    });
+    for(bool const& wasSeen : seen) {
+        REQUIRE(wasSeen);
+    }
+}
@@ -129,3 +129,30 @@ TEST_CASE("Sets can report if they contain an actor.", "[actors]") {
     REQUIRE(!manager.getActors().contains(actor2));
     REQUIRE(manager.getActors().contains(actor3));
 }
+
+TEST_CASE("ActorManager can destroy actors in bulk.", "[actors]") {
+    ActorManager manager;
+    std::vector<Actor_t> actors;
+    for(int i = 0; i < 10; i++) {
+        actors.push_back(manager.createActor());
+    }
+    Actor_t survivor = actors[4];
+    actors.erase(actors.begin() + 4);
+    // Duplicates and already destroyed actors are ignored
+    actors.push_back(actors[0]);
+    manager.destroyActor(actors[1]);
+
+    manager.destroyActors(actors);
+    REQUIRE(manager.getActors().count() == 1);
+    REQUIRE(manager.isActorAlive(survivor));
+    for(int i = 0; i < 9; i++) {
+        REQUIRE(!manager.isActorAlive(actors[i]));
+    }
+
+    SECTION("Every destroyed ID is recycled before new IDs are allocated.") {
+        for(int i = 0; i < 9; i++) {
+            REQUIRE(convertActorToID(manager.createActor()) < 10);
+        }
+        REQUIRE(convertActorToID(manager.createActor()) == 10);
+    }
+}
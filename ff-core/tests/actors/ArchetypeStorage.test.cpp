@@ -0,0 +1,113 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <ff/actors/ActorManager.hpp>
+#include <ff/actors/Family.hpp>
+
+#include <memory>
+
+using namespace ff;
+
+struct ArchetypePositionComponent : Component<ArchetypePositionComponent> {
+    ArchetypePositionComponent(const int& x = 0) : x(x) {}
+    int x;
+};
+struct ArchetypeVelocityComponent : Component<ArchetypeVelocityComponent> {
+    ArchetypeVelocityComponent(const int& dx = 0) : dx(dx) {}
+    int dx;
+};
+struct ArchetypeResourceComponent : Component<ArchetypeResourceComponent> {
+    std::shared_ptr<int> resource = nullptr;
+};
+
+TEST_CASE("Components keep their values when an actor moves between archetypes.", "[actors]") {
+    ActorManager manager(ActorStorage::ARCHETYPES);
+    Actor_t actor = manager.createActor();
+    manager.addComponent<ArchetypePositionComponent>(actor, 5);
+    manager.addComponent<ArchetypeVelocityComponent>(actor, 2);
+    REQUIRE(manager.getComponent<ArchetypePositionComponent>(actor).x == 5);
+    REQUIRE(manager.getComponent<ArchetypeVelocityComponent>(actor).dx == 2);
+
+    manager.removeComponent<ArchetypeVelocityComponent>(actor);
+    REQUIRE(!manager.hasComponent<ArchetypeVelocityComponent>(actor));
+    REQUIRE(manager.getComponent<ArchetypePositionComponent>(actor).x == 5);
+}
+
+TEST_CASE("Archetype storage destructs components when removed or destroyed.", "[actors]") {
+    ActorManager manager(ActorStorage::ARCHETYPES);
+    std::shared_ptr<int> resource = std::make_shared<int>(10);
+    Actor_t actor1 = manager.createActor();
+    Actor_t actor2 = manager.createActor();
+    manager.addComponent<ArchetypeResourceComponent>(actor1).resource = resource;
+    manager.addComponent<ArchetypeResourceComponent>(actor2).resource = resource;
+    manager.addComponent<ArchetypePositionComponent>(actor1);
+    REQUIRE(resource.use_count() == 3);
+
+    manager.removeComponent<ArchetypeResourceComponent>(actor1);
+    REQUIRE(resource.use_count() == 2);
+    manager.destroyActor(actor2);
+    REQUIRE(resource.use_count() == 1);
+}
+
+TEST_CASE("Removing an actor from an archetype keeps the other actors' components.", "[actors]") {
+    ActorManager manager(ActorStorage::ARCHETYPES);
+    std::vector<Actor_t> actors;
+    for(int i = 0; i < 1000; i++) {
+        actors.push_back(manager.createActor());
+        manager.addComponent<ArchetypePositionComponent>(actors.back(), i);
+    }
+    for(int i = 0; i < 1000; i += 3) {
+        manager.destroyActor(actors[i]);
+    }
+    for(int i = 0; i < 1000; i++) {
+        if(i % 3 != 0) {
+            REQUIRE(manager.getComponent<ArchetypePositionComponent>(actors[i]).x == i);
+        }
+    }
+}
+
+static void testChunkIteration(ActorStorage const& storage) {
+    ActorManager manager(storage);
+    for(int i = 0; i < 1000; i++) {
+        Actor_t actor = manager.createActor();
+        manager.addComponent<ArchetypePositionComponent>(actor, i);
+        if(i % 2 == 0) {
+            manager.addComponent<ArchetypeVelocityComponent>(actor, 1);
+        }
+    }
+
+    int actorCount = 0;
+    manager.eachChunk<ArchetypePositionComponent, ArchetypeVelocityComponent>(
+        Family::all<ArchetypePositionComponent, ArchetypeVelocityComponent>().get(),
+        [&](size_t count, Actor_t const* actors, ArchetypePositionComponent* positions, ArchetypeVelocityComponent* velocities) {
+        for(size_t i = 0; i < count; i++) {
+            REQUIRE(&positions[i] == &manager.getComponent<ArchetypePositionComponent>(actors[i]));
+            positions[i].x += velocities[i].dx;
+            actorCount++;
+        }
+    });
+    REQUIRE(actorCount == 500);
+
+    int sum = 0;
+    manager.eachChunk<ArchetypePositionComponent>(Family::exclude<ArchetypeVelocityComponent>().get(),
+        [&](size_t count, Actor_t const* actors, ArchetypePositionComponent* positions) {
+        for(size_t i = 0; i < count; i++) {
+            sum += positions[i].x % 2;
+        }
+    });
+    REQUIRE(sum == 500);
+}
+
+TEST_CASE("Actors can be iterated in chunks.", "[actors]") {
+    SECTION("With component maps.") {
+        testChunkIteration(ActorStorage::COMPONENT_MAPS);
+    }
+    SECTION("With archetypes.") {
+        testChunkIteration(ActorStorage::ARCHETYPES);
+    }
+}
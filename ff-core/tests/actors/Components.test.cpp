@@ -7,8 +7,16 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <ff/actors/ActorManager.hpp>
+#include <ff/actors/Family.hpp>
+#include <ff/processes/ParallelEach.hpp>
+#include <ff/Locator.hpp>
+#include <ff/util/Macros.hpp>
+#include <ff/messages/EventListener.hpp>
+#include <ff/events/actors/ComponentRemovedEvent.hpp>
+#include <ff/events/actors/ComponentsRemovedEvent.hpp>
 
 #include <memory>
+#include <vector>
 
 using namespace ff;
 
@@ -68,7 +76,7 @@ TEST_CASE("Actor component masks are updated when a component is removed.", "[ac
     Actor_t actor = actorManager.createActor();
     actorManager.addComponent<Test1Component>(actor);
     actorManager.removeComponent<Test1Component>(actor);
-    REQUIRE(actorManager.getComponentMask(actor) == 0);
+    REQUIRE(actorManager.getComponentMask(actor) == FF_ACTOR_COMPONENT_MASK_EMPTY);
 }
 
 struct Test2Component : Component<Test2Component> {
@@ -123,3 +131,198 @@ TEST_CASE("Components are unique per actor.", "[actors]") {
     REQUIRE(actorManager.getComponent<Test1Component>(actor1).b == true);
     REQUIRE(actorManager.getComponent<Test1Component>(actor2).b == false);
 }
+
+TEST_CASE("Actors with a set of components can be iterated with a view.", "[actors]") {
+    ActorStorage storage = ActorStorage::COMPONENT_MAPS;
+    SECTION("With component maps.") {
+        storage = ActorStorage::COMPONENT_MAPS;
+    }
+    SECTION("With archetypes.") {
+        storage = ActorStorage::ARCHETYPES;
+    }
+
+    ActorManager actorManager(storage);
+    for(int i = 0; i < 300; i++) {
+        Actor_t actor = actorManager.createActor();
+        actorManager.addComponent<Test1Component>(actor, false, i);
+        if(i % 3 == 0) {
+            actorManager.addComponent<Test2Component>(actor);
+        }
+    }
+
+    int count = 0;
+    for(auto [actor, test1, test2] : actorManager.view<Test1Component, Test2Component>()) {
+        REQUIRE(&test1 == &actorManager.getComponent<Test1Component>(actor));
+        REQUIRE(&test2 == &actorManager.getComponent<Test2Component>(actor));
+        REQUIRE(test1.i % 3 == 0);
+        test1.b = true;
+        count++;
+    }
+    REQUIRE(count == 100);
+
+    count = 0;
+    actorManager.view<Test1Component>(Family::all<Test1Component>().exclude<Test2Component>().get())
+        .each([&count](Actor_t actor, Test1Component& test1) {
+        REQUIRE(!test1.b);
+        count++;
+    });
+    REQUIRE(count == 200);
+}
+
+TEST_CASE("Actors in a view can be iterated in parallel.", "[actors]") {
+    ActorStorage storage = ActorStorage::COMPONENT_MAPS;
+    SECTION("With component maps.") {
+        storage = ActorStorage::COMPONENT_MAPS;
+    }
+    SECTION("With archetypes.") {
+        storage = ActorStorage::ARCHETYPES;
+    }
+
+    ActorManager actorManager(storage);
+    std::vector<Actor_t> actors;
+    for(int i = 0; i < 3000; i++) {
+        actors.push_back(actorManager.createActor());
+        actorManager.addComponent<Test1Component>(actors.back(), false, i);
+        if(i % 3 == 0) {
+            actorManager.addComponent<Test2Component>(actors.back());
+        }
+    }
+
+    parallelEach(actorManager.view<Test1Component, Test2Component>(), [](Actor_t actor, Test1Component& test1, Test2Component&) {
+        test1.i++;
+    }, 16);
+    for(int i = 0; i < 3000; i++) {
+        REQUIRE(actorManager.getComponent<Test1Component>(actors[i]).i == (i % 3 == 0 ? i + 1 : i));
+    }
+}
+
+// Components must be movable when built for archetype storage
+#ifndef FF_ACTOR_ARCHETYPE_STORAGE
+struct CountedTestComponent : Component<CountedTestComponent> {
+    // No default constructor, and neither copyable nor movable
+    CountedTestComponent(const int& value) : value(value) {
+        constructions++;
+    }
+    ~CountedTestComponent() {
+        destructions++;
+    }
+    CountedTestComponent(const CountedTestComponent&) = delete;
+    CountedTestComponent& operator=(const CountedTestComponent&) = delete;
+
+    int value;
+
+    static int constructions;
+    static int destructions;
+};
+int CountedTestComponent::constructions = 0;
+int CountedTestComponent::destructions = 0;
+
+TEST_CASE("Components are constructed once when added and destructed once when removed.", "[actors]") {
+    CountedTestComponent::constructions = 0;
+    CountedTestComponent::destructions = 0;
+    {
+        ActorManager actorManager;
+        Actor_t actor1 = actorManager.createActor();
+        Actor_t actor2 = actorManager.createActor();
+        actorManager.addComponent<CountedTestComponent>(actor1, 1);
+        actorManager.addComponent<CountedTestComponent>(actor2, 2);
+        REQUIRE(CountedTestComponent::constructions == 2);
+        REQUIRE(CountedTestComponent::destructions == 0);
+
+        actorManager.removeComponent<CountedTestComponent>(actor1);
+        REQUIRE(CountedTestComponent::destructions == 1);
+        REQUIRE(actorManager.getComponent<CountedTestComponent>(actor2).value == 2);
+
+        actorManager.addComponent<CountedTestComponent>(actor1, 3);
+        REQUIRE(CountedTestComponent::constructions == 3);
+        REQUIRE(actorManager.getComponent<CountedTestComponent>(actor1).value == 3);
+    }
+    // Components still attached are destructed with the ActorManager
+    REQUIRE(CountedTestComponent::destructions == 3);
+}
+#endif
+
+struct SilentTestComponent : Component<SilentTestComponent> {
+    static constexpr bool dispatchesRemovedEvents = false;
+};
+
+class RemovedEventsListener
+    : public EventListener<ComponentRemovedEvent<Test1Component>>,
+    public EventListener<ComponentsRemovedEvent<Test1Component>>,
+    public EventListener<ComponentRemovedEvent<SilentTestComponent>>,
+    public EventListener<ComponentsRemovedEvent<SilentTestComponent>> {
+public:
+    RemovedEventsListener() {
+        Locator::getMessageBus().addListener<ComponentRemovedEvent<Test1Component>>(this);
+        Locator::getMessageBus().addListener<ComponentsRemovedEvent<Test1Component>>(this);
+        Locator::getMessageBus().addListener<ComponentRemovedEvent<SilentTestComponent>>(this);
+        Locator::getMessageBus().addListener<ComponentsRemovedEvent<SilentTestComponent>>(this);
+    }
+    ~RemovedEventsListener() {
+        Locator::getMessageBus().removeListener<ComponentRemovedEvent<Test1Component>>(this);
+        Locator::getMessageBus().removeListener<ComponentsRemovedEvent<Test1Component>>(this);
+        Locator::getMessageBus().removeListener<ComponentRemovedEvent<SilentTestComponent>>(this);
+        Locator::getMessageBus().removeListener<ComponentsRemovedEvent<SilentTestComponent>>(this);
+    }
+
+    int removedEvents = 0;
+    int bulkRemovedEvents = 0;
+    size_t bulkRemovedActors = 0;
+    int silentEvents = 0;
+
+    bool processEvent(ComponentRemovedEvent<Test1Component> const& evt) override {
+        FF_UNUSED(evt);
+        removedEvents++;
+        return false;
+    }
+    bool processEvent(ComponentsRemovedEvent<Test1Component> const& evt) override {
+        bulkRemovedEvents++;
+        bulkRemovedActors += evt.count;
+        return false;
+    }
+    bool processEvent(ComponentRemovedEvent<SilentTestComponent> const& evt) override {
+        FF_UNUSED(evt);
+        silentEvents++;
+        return false;
+    }
+    bool processEvent(ComponentsRemovedEvent<SilentTestComponent> const& evt) override {
+        FF_UNUSED(evt);
+        silentEvents++;
+        return false;
+    }
+};
+
+static void testRemovedEvents(ActorStorage const& storage) {
+    ActorManager actorManager(storage);
+    RemovedEventsListener listener;
+
+    std::vector<Actor_t> actors;
+    for(int i = 0; i < 10; i++) {
+        Actor_t actor = actorManager.createActor();
+        actorManager.addComponent<Test1Component>(actor);
+        actorManager.addComponent<SilentTestComponent>(actor);
+        actors.push_back(actor);
+    }
+
+    actorManager.removeComponent<SilentTestComponent>(actors[0]);
+    actorManager.destroyActor(actors[0]);
+    REQUIRE(listener.removedEvents == 1);
+
+    // Duplicates and dead actors are skipped. Since ComponentRemovedEvent is
+    // listened for, it's still sent per actor.
+    actors.push_back(actors[1]);
+    actorManager.destroyActors(actors);
+    REQUIRE(listener.removedEvents == 10);
+    REQUIRE(listener.bulkRemovedEvents == 1);
+    REQUIRE(listener.bulkRemovedActors == 9);
+    REQUIRE(listener.silentEvents == 0);
+}
+
+TEST_CASE("Bulk destruction sends one removal event per component type, unless the type opts out.", "[actors]") {
+    SECTION("With component maps.") {
+        testRemovedEvents(ActorStorage::COMPONENT_MAPS);
+    }
+    SECTION("With archetypes.") {
+        testRemovedEvents(ActorStorage::ARCHETYPES);
+    }
+}
@@ -9,6 +9,10 @@
 #include <ff/actors/ActorManager.hpp>
 #include <ff/actors/Family.hpp>
 
+#include <ff/util/Macros.hpp>
+
+#include <utility>
+
 using namespace ff;
 
 struct Test1Component : Component<Test1Component> {
@@ -138,3 +142,82 @@ TEST_CASE("ActorManager can remove all actors in a family.", "[actors]") {
     REQUIRE(manager.getActorsFor(Family::all<Test1Component>().get()).count() == 0);
     REQUIRE(manager.getActors().count() == 3);
 }
+TEST_CASE("Actors removed from a family while iterating it are neither skipped nor visited twice.", "[actors]") {
+    ActorManager manager;
+    std::vector<Actor_t> actors;
+    for(int i = 0; i < 6; i++) {
+        actors.push_back(manager.createActor());
+        manager.addComponent<Test1Component>(actors.back());
+    }
+    Family family = Family::all<Test1Component>().get();
+
+    std::vector<Actor_t> visited;
+    Actor_t first = NullActor;
+    Actor_t victim = NullActor;
+    manager.getActorsFor(family).each([&](Actor_t actor) -> void {
+        visited.push_back(actor);
+        // On the first visit, remove the current actor and one that has not been visited yet
+        if(visited.size() == 1) {
+            first = actor;
+            victim = actor == actors[0] ? actors[1] : actors[0];
+            manager.destroyActor(victim);
+            manager.removeComponent<Test1Component>(actor);
+        }
+    });
+    REQUIRE(visited.size() == 5);
+    for(size_t i = 0; i < visited.size(); i++) {
+        REQUIRE(visited[i] != victim);
+        for(size_t j = i + 1; j < visited.size(); j++) {
+            REQUIRE(visited[i] != visited[j]);
+        }
+    }
+    REQUIRE(manager.getActorsFor(family).count() == 4);
+    REQUIRE(!manager.getActorsFor(family).contains(victim));
+    REQUIRE(!manager.getActorsFor(family).contains(first));
+}
+TEST_CASE("Destroyed actors are removed from families that only exclude components.", "[actors]") {
+    ActorManager manager;
+    Family family = Family::exclude<Test1Component>().get();
+    Actor_t actor = manager.createActor();
+    REQUIRE(manager.getActorsFor(family).count() == 1);
+    manager.destroyActor(actor);
+    REQUIRE(manager.getActorsFor(family).count() == 0);
+
+    // The recycled ID must not be mistaken for the destroyed actor
+    Actor_t recycled = manager.createActor();
+    REQUIRE(convertActorToID(recycled) == convertActorToID(actor));
+    REQUIRE(manager.getActorsFor(family).contains(recycled));
+    REQUIRE(!manager.getActorsFor(family).contains(actor));
+}
+
+template<int N>
+struct IndexedTestComponent : Component<IndexedTestComponent<N>> {
+};
+
+template<int... Ns>
+static void registerIndexedTestComponents(std::integer_sequence<int, Ns...>) {
+    for(ComponentIndex const& index : { IndexedTestComponent<Ns>::getIndex()... }) {
+        FF_UNUSED(index);
+    }
+}
+
+TEST_CASE("Families match components past the first 64 component types.", "[actors]") {
+    registerIndexedTestComponents(std::make_integer_sequence<int, 70>());
+    REQUIRE(Component<IndexedTestComponent<69>>::getIndex() >= 64);
+
+    ActorManager manager;
+    Actor_t actor1 = manager.createActor();
+    Actor_t actor2 = manager.createActor();
+    manager.addComponent<IndexedTestComponent<0>>(actor1);
+    manager.addComponent<IndexedTestComponent<69>>(actor1);
+    manager.addComponent<IndexedTestComponent<69>>(actor2);
+    REQUIRE(manager.hasComponent<IndexedTestComponent<69>>(actor2));
+    REQUIRE(!manager.hasComponent<IndexedTestComponent<0>>(actor2));
+
+    REQUIRE(manager.getActorsFor(Family::all<IndexedTestComponent<69>>().get()).count() == 2);
+    REQUIRE(manager.getActorsFor(Family::all<IndexedTestComponent<69>>().exclude<IndexedTestComponent<0>>().get()).count() == 1);
+    REQUIRE(manager.getActorsFor(Family::one<IndexedTestComponent<0>, IndexedTestComponent<68>>().get()).count() == 1);
+
+    manager.removeComponent<IndexedTestComponent<69>>(actor1);
+    REQUIRE(manager.getComponentMask(actor1) == Component<IndexedTestComponent<0>>::getType());
+}
@@ -0,0 +1,81 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <ff/collision/Collision2DBatch.hpp>
+
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace ff;
+
+static std::vector<size_t> getSetBits(const std::vector<uint32_t>& masks) {
+    std::vector<size_t> bits;
+    Collision2DBatch::forEachSetBit(masks.data(), masks.size(), [&bits](const size_t& bit) {
+        bits.push_back(bit);
+    });
+    return bits;
+}
+
+TEST_CASE("Batched AABB tests match testing one at a time.", "[collision]") {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> size(0.0f, 4.0f);
+
+    // Not a multiple of the lane count, so the remainder is covered too
+    const size_t count = 103;
+    std::vector<float> minX, minY, maxX, maxY;
+    for(size_t i = 0; i < count; ++i) {
+        minX.push_back(position(random));
+        minY.push_back(position(random));
+        maxX.push_back(minX.back() + size(random));
+        maxY.push_back(minY.back() + size(random));
+    }
+    // Touching edges count as overlapping
+    minX[0] = 2.0f;
+    maxX[0] = 3.0f;
+    minY[0] = 0.0f;
+    maxY[0] = 1.0f;
+
+    glm::vec2 const min(-2, -2), max(2, 2);
+    std::vector<size_t> expected;
+    for(size_t i = 0; i < count; ++i) {
+        if(minX[i] <= max.x && maxX[i] >= min.x && minY[i] <= max.y && maxY[i] >= min.y) {
+            expected.push_back(i);
+        }
+    }
+    REQUIRE(expected.front() == 0);
+
+    std::vector<uint32_t> masks(Collision2DBatch::getMaskWordCount(count), 0xFFFFFFFF);
+    Collision2DBatch::overlapAABBs(min, max, minX.data(), minY.data(), maxX.data(), maxY.data(), count, masks.data());
+    REQUIRE(getSetBits(masks) == expected);
+
+    Collision2DBounds bounds;
+    for(size_t i = 0; i < count; ++i) {
+        bounds.push_back(glm::vec2(minX[i], minY[i]), glm::vec2(maxX[i], maxY[i]));
+    }
+    bounds.overlap(min, max, 0, count, masks.data());
+    REQUIRE(getSetBits(masks) == expected);
+
+    // Moving the last box into the first's place
+    bounds.swapRemove(0);
+    REQUIRE(bounds.size() == count - 1);
+    std::vector<uint32_t> firstMask(1);
+    bounds.overlap(glm::vec2(minX.back(), minY.back()), glm::vec2(minX.back(), minY.back()), 0, 1, firstMask.data());
+    REQUIRE(firstMask[0] == 1);
+}
+
+TEST_CASE("Batched circle tests skip circles with a NaN radius.", "[collision]") {
+    std::vector<float> centerX = { 0, 3, 10, 0, 1.5f, -2.9f };
+    std::vector<float> centerY = { 0, 0, 10, 0, 0, 0 };
+    std::vector<float> radii = { 1, 1.5f, 1, std::numeric_limits<float>::quiet_NaN(), 0.1f, 1 };
+
+    std::vector<uint32_t> masks(1);
+    Collision2DBatch::overlapCircles(glm::vec2(0, 0), 2.0f, centerX.data(), centerY.data(), radii.data(), centerX.size(), masks.data());
+    REQUIRE(getSetBits(masks) == std::vector<size_t>({ 0, 1, 4, 5 }));
+}
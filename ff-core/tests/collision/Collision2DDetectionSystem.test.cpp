@@ -0,0 +1,270 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <ff/systems/Collision2DDetectionSystem.hpp>
+#include <ff/processes/ProcessManager.hpp>
+#include <ff/components/StaticColliderComponent.hpp>
+#include <ff/components/DynamicColliderComponent.hpp>
+#include <ff/events/collision/CollisionStartEvent.hpp>
+#include <ff/events/collision/CollisionEndEvent.hpp>
+#include <ff/messages/EventListener.hpp>
+#include <ff/Locator.hpp>
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+using namespace ff;
+
+typedef std::pair<Actor_t, Actor_t> ActorPair;
+
+class CollisionEventRecorder
+    : public EventListener<CollisionStartEvent>,
+    public EventListener<CollisionEndEvent> {
+public:
+    CollisionEventRecorder() {
+        Locator::getMessageBus().addListener<CollisionStartEvent>(this);
+        Locator::getMessageBus().addListener<CollisionEndEvent>(this);
+    }
+    ~CollisionEventRecorder() {
+        Locator::getMessageBus().removeListener<CollisionStartEvent>(this);
+        Locator::getMessageBus().removeListener<CollisionEndEvent>(this);
+    }
+
+    std::vector<ActorPair> starts;
+    std::vector<ActorPair> ends;
+
+    bool processEvent(CollisionStartEvent const& evt) override {
+        starts.emplace_back(evt.actorA, evt.actorB);
+        return false;
+    }
+    bool processEvent(CollisionEndEvent const& evt) override {
+        ends.emplace_back(evt.actorA, evt.actorB);
+        return false;
+    }
+
+    void clear() {
+        starts.clear();
+        ends.clear();
+    }
+};
+
+static Collision2DShape* createBoxShape(const float& halfSize) {
+    return new PolygonCollision2DShape({ glm::vec2(-halfSize, -halfSize), glm::vec2(halfSize, -halfSize),
+        glm::vec2(halfSize, halfSize), glm::vec2(-halfSize, halfSize) });
+}
+static void addStaticBox(ActorManager& actorManager, const Actor_t& actor, const glm::vec2& position, const float& halfSize) {
+    actorManager.addComponent<TransformComponent>(actor, glm::vec3(position, 0));
+    actorManager.addComponent<Collision2DComponent>(actor, std::initializer_list<Collision2DShape*>{ createBoxShape(halfSize) });
+    actorManager.addComponent<StaticColliderComponent>(actor);
+}
+static void addDynamicCircle(ActorManager& actorManager, const Actor_t& actor, const glm::vec2& position, const float& radius,
+    const bool& continuous = false) {
+    actorManager.addComponent<TransformComponent>(actor, glm::vec3(position, 0));
+    actorManager.addComponent<Collision2DComponent>(actor, std::initializer_list<Collision2DShape*>{ new CircleCollision2DShape(radius) });
+    actorManager.addComponent<DynamicColliderComponent>(actor, continuous);
+}
+
+// Updates the system and delivers the events it queued
+static void update(ProcessManager& processManager) {
+    processManager.tick(1 / 60.0f);
+    Locator::getMessageBus().flush();
+}
+
+TEST_CASE("Collisions start once and end once.", "[collision]") {
+    ActorStorage storage = ActorStorage::COMPONENT_MAPS;
+    SECTION("With component maps.") {
+        storage = ActorStorage::COMPONENT_MAPS;
+    }
+    SECTION("With archetypes.") {
+        storage = ActorStorage::ARCHETYPES;
+    }
+
+    ActorManager actorManager(storage);
+    CollisionEventRecorder recorder;
+    Actor_t const wall = actorManager.createActor();
+    addStaticBox(actorManager, wall, glm::vec2(0, 0), 1.0f);
+    Actor_t const ball = actorManager.createActor();
+    addDynamicCircle(actorManager, ball, glm::vec2(5, 0), 0.5f);
+
+    ProcessManager processManager;
+    processManager.attachProcess<Collision2DDetectionSystem>(&actorManager);
+    update(processManager);
+    REQUIRE(recorder.starts.empty());
+
+    actorManager.getComponent<TransformComponent>(ball).setPosition(1.2f, 0);
+    update(processManager);
+    REQUIRE(recorder.starts == std::vector<ActorPair>({ { ball, wall } }));
+    REQUIRE(recorder.ends.empty());
+    REQUIRE(actorManager.getComponent<Collision2DComponent>(ball).getCollidingCount() == 1);
+    REQUIRE(actorManager.getComponent<Collision2DComponent>(wall).getCollidingCount() == 1);
+
+    SECTION("Staying in contact doesn't start the collision again.") {
+        actorManager.getComponent<TransformComponent>(ball).setPosition(1.1f, 0);
+        update(processManager);
+        update(processManager);
+        REQUIRE(recorder.starts.size() == 1);
+        REQUIRE(recorder.ends.empty());
+    }
+    SECTION("Moving apart ends the collision.") {
+        actorManager.getComponent<TransformComponent>(ball).setPosition(5, 0);
+        update(processManager);
+        REQUIRE(recorder.ends == std::vector<ActorPair>({ { ball, wall } }));
+        REQUIRE(actorManager.getComponent<Collision2DComponent>(ball).getCollidingCount() == 0);
+        REQUIRE(actorManager.getComponent<Collision2DComponent>(wall).getCollidingCount() == 0);
+
+        update(processManager);
+        REQUIRE(recorder.starts.size() == 1);
+        REQUIRE(recorder.ends.size() == 1);
+    }
+    SECTION("Destroying an actor mid-contact ends the collision without an event.") {
+        actorManager.destroyActor(ball);
+        update(processManager);
+        REQUIRE(recorder.ends.empty());
+        REQUIRE(actorManager.getComponent<Collision2DComponent>(wall).getCollidingCount() == 0);
+    }
+
+    processManager.killAll(true);
+}
+
+// Returns the collisions started in a row of walls with balls between them.
+// Actors are always created in the same order, so they get the same IDs, but
+// adding their components in reverse changes where they're stored.
+static std::vector<ActorPair> recordCollisionStarts(const ActorStorage& storage, const bool& reverseComponentOrder) {
+    ActorManager actorManager(storage);
+    CollisionEventRecorder recorder;
+
+    std::vector<Actor_t> actors;
+    for(int i = 0; i < 20; i++) {
+        actors.push_back(actorManager.createActor());
+    }
+    for(int i = 0; i < 20; i++) {
+        int const index = reverseComponentOrder ? 19 - i : i;
+        if(index < 10) {
+            addStaticBox(actorManager, actors[index], glm::vec2(index, 0), 0.45f);
+        } else {
+            addDynamicCircle(actorManager, actors[index], glm::vec2((index - 10) + 0.5f, 0.5f), 0.3f);
+        }
+    }
+
+    ProcessManager processManager;
+    processManager.attachProcess<Collision2DDetectionSystem>(&actorManager);
+    update(processManager);
+    processManager.killAll(true);
+    return recorder.starts;
+}
+
+TEST_CASE("Collision events are in the same order however actors are stored.", "[collision]") {
+    std::vector<ActorPair> const starts = recordCollisionStarts(ActorStorage::COMPONENT_MAPS, false);
+    // Each ball but the last sits between two walls
+    REQUIRE(starts.size() == 19);
+    REQUIRE(recordCollisionStarts(ActorStorage::COMPONENT_MAPS, true) == starts);
+    REQUIRE(recordCollisionStarts(ActorStorage::ARCHETYPES, false) == starts);
+    REQUIRE(recordCollisionStarts(ActorStorage::ARCHETYPES, true) == starts);
+}
+
+TEST_CASE("Collisions in a crowded scene match testing every pair.", "[collision]") {
+    ActorStorage storage = ActorStorage::COMPONENT_MAPS;
+    SECTION("With component maps.") {
+        storage = ActorStorage::COMPONENT_MAPS;
+    }
+    SECTION("With archetypes.") {
+        storage = ActorStorage::ARCHETYPES;
+    }
+
+    ActorManager actorManager(storage);
+    CollisionEventRecorder recorder;
+
+    // A field of tiles, crowded with balls that each touch up to four of them
+    std::vector<std::pair<Actor_t, glm::vec2>> tiles;
+    for(int i = 0; i < 400; i++) {
+        glm::vec2 const position(i % 20, i / 20);
+        tiles.emplace_back(actorManager.createActor(), position);
+        addStaticBox(actorManager, tiles.back().first, position, 0.45f);
+    }
+    std::vector<std::pair<Actor_t, glm::vec2>> balls;
+    for(int i = 0; i < 300; i++) {
+        glm::vec2 const position(std::fmod(i * 7.3f, 19.0f), std::fmod(i * 4.1f, 19.0f));
+        balls.emplace_back(actorManager.createActor(), position);
+        addDynamicCircle(actorManager, balls.back().first, position, 0.3f);
+    }
+
+    std::vector<ActorPair> expectedStarts;
+    CircleCollision2DShape const ballShape(0.3f);
+    PolygonCollision2DShape const tileShape({ glm::vec2(-0.45f, -0.45f), glm::vec2(0.45f, -0.45f),
+        glm::vec2(0.45f, 0.45f), glm::vec2(-0.45f, 0.45f) });
+    // Tiles were created first, so ordering by the lower actor orders by tile
+    for(auto const& tile : tiles) {
+        Collision2DWorldShape worldTile;
+        Collision2DNarrowPhase::computeWorldShape(tileShape, 1.0f, 0.0f, 1.0f, tile.second, worldTile);
+        for(auto const& ball : balls) {
+            Collision2DWorldShape worldBall;
+            Collision2DNarrowPhase::computeWorldShape(ballShape, 1.0f, 0.0f, 1.0f, ball.second, worldBall);
+            glm::vec2 normA, normB;
+            float penetration;
+            if(Collision2DNarrowPhase::testShapes(worldBall, normA, worldTile, normB, penetration)) {
+                expectedStarts.emplace_back(ball.first, tile.first);
+            }
+        }
+    }
+    REQUIRE(expectedStarts.size() > balls.size());
+
+    ProcessManager processManager;
+    processManager.attachProcess<Collision2DDetectionSystem>(&actorManager);
+    update(processManager);
+    REQUIRE(recorder.starts == expectedStarts);
+
+    size_t collidingCount = 0;
+    for(auto const& ball : balls) {
+        collidingCount += actorManager.getComponent<Collision2DComponent>(ball.first).getCollidingCount();
+    }
+    REQUIRE(collidingCount == expectedStarts.size());
+
+    processManager.killAll(true);
+}
+
+TEST_CASE("Continuous colliders collide with thin colliders they pass through in one update.", "[collision]") {
+    ActorStorage storage = ActorStorage::COMPONENT_MAPS;
+    SECTION("With component maps.") {
+        storage = ActorStorage::COMPONENT_MAPS;
+    }
+    SECTION("With archetypes.") {
+        storage = ActorStorage::ARCHETYPES;
+    }
+
+    ActorManager actorManager(storage);
+    CollisionEventRecorder recorder;
+    Actor_t const wall = actorManager.createActor();
+    actorManager.addComponent<TransformComponent>(wall, glm::vec3(5, 0, 0));
+    actorManager.addComponent<Collision2DComponent>(wall, std::initializer_list<Collision2DShape*>{
+        new PolygonCollision2DShape({ glm::vec2(-0.1f, -5), glm::vec2(0.1f, -5), glm::vec2(0.1f, 5), glm::vec2(-0.1f, 5) }) });
+    actorManager.addComponent<StaticColliderComponent>(wall);
+    Actor_t const continuousBall = actorManager.createActor();
+    addDynamicCircle(actorManager, continuousBall, glm::vec2(0, 0), 0.2f, true);
+    Actor_t const ball = actorManager.createActor();
+    addDynamicCircle(actorManager, ball, glm::vec2(0, 1), 0.2f);
+
+    ProcessManager processManager;
+    processManager.attachProcess<Collision2DDetectionSystem>(&actorManager);
+    update(processManager);
+
+    // Both end up past the wall, without touching it where they stop
+    actorManager.getComponent<TransformComponent>(continuousBall).setPosition(10, 0);
+    actorManager.getComponent<TransformComponent>(ball).setPosition(10, 1);
+    update(processManager);
+    REQUIRE(recorder.starts == std::vector<ActorPair>({ { continuousBall, wall } }));
+    REQUIRE(actorManager.getComponent<Collision2DComponent>(wall).getCollidingCount() == 1);
+    recorder.clear();
+
+    // Once the transform is reset (e.g. by TransformResetSystem), it no longer sweeps
+    actorManager.getComponent<TransformComponent>(continuousBall).setPosition(10, 0, true);
+    update(processManager);
+    REQUIRE(recorder.ends == std::vector<ActorPair>({ { continuousBall, wall } }));
+
+    processManager.killAll(true);
+}
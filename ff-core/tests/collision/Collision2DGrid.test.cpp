@@ -0,0 +1,72 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <ff/collision/Collision2DGrid.hpp>
+
+#include <vector>
+
+using namespace ff;
+
+TEST_CASE("Grid queries return overlapping proxies once, in order.", "[collision]") {
+    Collision2DGrid grid(10.0f);
+    // Spans four cells
+    Collision2DProxy large = grid.createProxy(Rectangle(glm::vec2(-5, -5), glm::vec2(5, 5)), 1);
+    Collision2DProxy small = grid.createProxy(Rectangle(glm::vec2(1, 1), glm::vec2(2, 2)), 2);
+    Collision2DProxy far = grid.createProxy(Rectangle(glm::vec2(100, 100), glm::vec2(101, 101)), 3);
+
+    std::vector<Collision2DProxy> proxies;
+    grid.query(Rectangle(glm::vec2(-20, -20), glm::vec2(20, 20)), proxies);
+    REQUIRE(proxies == std::vector<Collision2DProxy>({ large, small }));
+
+    proxies.clear();
+    grid.query(Rectangle(glm::vec2(-4, -4), glm::vec2(-3, -3)), proxies);
+    REQUIRE(proxies == std::vector<Collision2DProxy>({ large }));
+
+    proxies.clear();
+    grid.query(Rectangle(glm::vec2(99, 99), glm::vec2(100, 100)), proxies);
+    REQUIRE(proxies == std::vector<Collision2DProxy>({ far }));
+    REQUIRE(grid.getActor(far) == 3);
+}
+
+TEST_CASE("Moved and destroyed grid proxies are re-bucketed.", "[collision]") {
+    Collision2DGrid grid(10.0f);
+    Collision2DProxy proxy = grid.createProxy(Rectangle(glm::vec2(0, 0), glm::vec2(1, 1)), 1);
+
+    std::vector<Collision2DProxy> proxies;
+    grid.moveProxy(proxy, Rectangle(glm::vec2(50, 50), glm::vec2(51, 51)));
+    grid.query(Rectangle(glm::vec2(0, 0), glm::vec2(1, 1)), proxies);
+    REQUIRE(proxies.empty());
+    grid.query(Rectangle(glm::vec2(50, 50), glm::vec2(60, 60)), proxies);
+    REQUIRE(proxies == std::vector<Collision2DProxy>({ proxy }));
+
+    grid.setCellSize(3.0f);
+    proxies.clear();
+    grid.query(Rectangle(glm::vec2(50, 50), glm::vec2(60, 60)), proxies);
+    REQUIRE(proxies == std::vector<Collision2DProxy>({ proxy }));
+
+    grid.destroyProxy(proxy);
+    proxies.clear();
+    grid.query(Rectangle(glm::vec2(50, 50), glm::vec2(60, 60)), proxies);
+    REQUIRE(proxies.empty());
+    REQUIRE(grid.getProxyCount() == 0);
+}
+
+TEST_CASE("Grid proxies covering many cells are still found.", "[collision]") {
+    Collision2DGrid grid(1.0f);
+    Collision2DProxy floor = grid.createProxy(Rectangle(glm::vec2(-1000, -1), glm::vec2(1000, 0)), 1);
+    Collision2DProxy tile = grid.createProxy(Rectangle(glm::vec2(0, 0), glm::vec2(1, 1)), 2);
+
+    std::vector<Collision2DProxy> proxies;
+    grid.query(Rectangle(glm::vec2(500, -0.5f), glm::vec2(501, 0.5f)), proxies);
+    REQUIRE(proxies == std::vector<Collision2DProxy>({ floor }));
+
+    // A large query scans the proxies instead of the cells
+    proxies.clear();
+    grid.query(Rectangle(glm::vec2(-100, -100), glm::vec2(100, 100)), proxies);
+    REQUIRE(proxies == std::vector<Collision2DProxy>({ floor, tile }));
+}
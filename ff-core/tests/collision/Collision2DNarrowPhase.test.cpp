@@ -0,0 +1,166 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <ff/collision/Collision2DNarrowPhase.hpp>
+
+#include <cmath>
+
+using namespace ff;
+
+static bool isNear(const float& a, const float& b) {
+    return std::abs(a - b) < 0.0001f;
+}
+
+static PolygonCollision2DShape createBox(const float& halfSize) {
+    return PolygonCollision2DShape({ glm::vec2(-halfSize, -halfSize), glm::vec2(halfSize, -halfSize),
+        glm::vec2(halfSize, halfSize), glm::vec2(-halfSize, halfSize) });
+}
+
+TEST_CASE("World shapes are offset, rotated and scaled.", "[collision]") {
+    CircleCollision2DShape circle(1.0f);
+    circle.setOffset(glm::vec2(1, 0));
+    Collision2DWorldShape worldCircle;
+    // A quarter turn, doubled in size
+    Collision2DNarrowPhase::computeWorldShape(circle, 0.0f, 1.0f, 2.0f, glm::vec2(10, 10), worldCircle);
+    REQUIRE(worldCircle.type == Collision2DShapeType::CIRCLE);
+    REQUIRE(isNear(worldCircle.position.x, 10.0f));
+    REQUIRE(isNear(worldCircle.position.y, 12.0f));
+    REQUIRE(worldCircle.radius == 2.0f);
+    REQUIRE(isNear(worldCircle.min.x, 8.0f));
+    REQUIRE(isNear(worldCircle.max.y, 14.0f));
+
+    PolygonCollision2DShape box = createBox(1.0f);
+    Collision2DWorldShape worldBox;
+    Collision2DNarrowPhase::computeWorldShape(box, 1.0f, 0.0f, 3.0f, glm::vec2(5, 0), worldBox);
+    REQUIRE(worldBox.type == Collision2DShapeType::POLYGON);
+    REQUIRE(worldBox.vertexCount == 4);
+    REQUIRE(worldBox.min == glm::vec2(2, -3));
+    REQUIRE(worldBox.max == glm::vec2(8, 3));
+    // The bottom edge faces down
+    REQUIRE(glm::dot(worldBox.normals[0], glm::vec2(0, -1)) > 0);
+
+    // Clockwise polygons are reversed, so their normals still face outwards
+    PolygonCollision2DShape clockwiseBox({ glm::vec2(-1, 1), glm::vec2(1, 1), glm::vec2(1, -1), glm::vec2(-1, -1) });
+    Collision2DNarrowPhase::computeWorldShape(clockwiseBox, 1.0f, 0.0f, 1.0f, glm::vec2(0, 0), worldBox);
+    REQUIRE(worldBox.vertices[0] == glm::vec2(-1, -1));
+    REQUIRE(worldBox.normals[0] == glm::vec2(0, -1));
+}
+
+TEST_CASE("Shape pairs are tested whichever order they're in.", "[collision]") {
+    CircleCollision2DShape circle(1.0f);
+    PolygonCollision2DShape box = createBox(1.0f);
+    Collision2DWorldShape worldCircle, worldBox, farBox;
+    Collision2DNarrowPhase::computeWorldShape(circle, 1.0f, 0.0f, 1.0f, glm::vec2(1.5f, 0), worldCircle);
+    Collision2DNarrowPhase::computeWorldShape(box, 1.0f, 0.0f, 1.0f, glm::vec2(0, 0), worldBox);
+    Collision2DNarrowPhase::computeWorldShape(box, 1.0f, 0.0f, 1.0f, glm::vec2(10, 0), farBox);
+
+    glm::vec2 normA, normB;
+    float penetration;
+    SECTION("Circle and circle.") {
+        Collision2DWorldShape otherCircle;
+        Collision2DNarrowPhase::computeWorldShape(circle, 1.0f, 0.0f, 1.0f, glm::vec2(0, 0), otherCircle);
+        REQUIRE(Collision2DNarrowPhase::testShapes(otherCircle, normA, worldCircle, normB, penetration));
+        REQUIRE(normA == glm::vec2(1, 0));
+        REQUIRE(normB == glm::vec2(-1, 0));
+        REQUIRE(isNear(penetration, 0.5f));
+    }
+    SECTION("Polygon and circle.") {
+        REQUIRE(Collision2DNarrowPhase::testShapes(worldBox, normA, worldCircle, normB, penetration));
+        REQUIRE(normA.x > 0);
+        REQUIRE(normB == -normA);
+
+        glm::vec2 swappedNormA, swappedNormB;
+        REQUIRE(Collision2DNarrowPhase::testShapes(worldCircle, swappedNormA, worldBox, swappedNormB, penetration));
+        REQUIRE(swappedNormA == normB);
+        REQUIRE(swappedNormB == normA);
+    }
+    SECTION("Polygon and polygon.") {
+        Collision2DWorldShape overlappingBox;
+        Collision2DNarrowPhase::computeWorldShape(box, 1.0f, 0.0f, 1.0f, glm::vec2(1.5f, 0), overlappingBox);
+        REQUIRE(Collision2DNarrowPhase::testShapes(worldBox, normA, overlappingBox, normB, penetration));
+        REQUIRE(normA.x > 0);
+        REQUIRE(normB == -normA);
+        REQUIRE_FALSE(Collision2DNarrowPhase::testShapes(worldBox, normA, farBox, normB, penetration));
+    }
+}
+
+TEST_CASE("Circles near a polygon only collide once they reach it.", "[collision]") {
+    CircleCollision2DShape circle(1.0f);
+    PolygonCollision2DShape box = createBox(1.0f);
+    Collision2DWorldShape worldBox, worldCircle;
+    Collision2DNarrowPhase::computeWorldShape(box, 1.0f, 0.0f, 1.0f, glm::vec2(0, 0), worldBox);
+
+    glm::vec2 normA, normB;
+    float penetration;
+    SECTION("With the circle beside an edge.") {
+        Collision2DNarrowPhase::computeWorldShape(circle, 1.0f, 0.0f, 1.0f, glm::vec2(2.5f, 0.5f), worldCircle);
+        REQUIRE_FALSE(Collision2DNarrowPhase::testShapes(worldBox, normA, worldCircle, normB, penetration));
+
+        Collision2DNarrowPhase::computeWorldShape(circle, 1.0f, 0.0f, 1.0f, glm::vec2(1.9f, 0.5f), worldCircle);
+        REQUIRE(Collision2DNarrowPhase::testShapes(worldBox, normA, worldCircle, normB, penetration));
+        REQUIRE(normA == glm::vec2(1, 0));
+    }
+    SECTION("With the circle beside a corner.") {
+        Collision2DNarrowPhase::computeWorldShape(circle, 1.0f, 0.0f, 1.0f, glm::vec2(1.8f, 1.8f), worldCircle);
+        REQUIRE_FALSE(Collision2DNarrowPhase::testShapes(worldBox, normA, worldCircle, normB, penetration));
+
+        Collision2DNarrowPhase::computeWorldShape(circle, 1.0f, 0.0f, 1.0f, glm::vec2(1.5f, 1.5f), worldCircle);
+        REQUIRE(Collision2DNarrowPhase::testShapes(worldBox, normA, worldCircle, normB, penetration));
+        REQUIRE(normA.x > 0);
+        REQUIRE(normA.y > 0);
+    }
+    SECTION("With the circle inside the polygon.") {
+        Collision2DNarrowPhase::computeWorldShape(circle, 1.0f, 0.0f, 0.25f, glm::vec2(0.5f, 0), worldCircle);
+        REQUIRE(Collision2DNarrowPhase::testShapes(worldBox, normA, worldCircle, normB, penetration));
+        REQUIRE(normA == glm::vec2(1, 0));
+    }
+}
+
+TEST_CASE("Shapes swept through a thin wall hit it on the way.", "[collision]") {
+    // A wall 0.2 wide at x = 5, and shapes starting at x = 0 that end past it
+    PolygonCollision2DShape wall({ glm::vec2(-0.1f, -5), glm::vec2(0.1f, -5), glm::vec2(0.1f, 5), glm::vec2(-0.1f, 5) });
+    CircleCollision2DShape circle(0.5f);
+    PolygonCollision2DShape box = createBox(0.5f);
+    Collision2DWorldShape worldWall, worldCircle, worldBox;
+    Collision2DNarrowPhase::computeWorldShape(wall, 1.0f, 0.0f, 1.0f, glm::vec2(5, 0), worldWall);
+    Collision2DNarrowPhase::computeWorldShape(circle, 1.0f, 0.0f, 1.0f, glm::vec2(0, 0), worldCircle);
+    Collision2DNarrowPhase::computeWorldShape(box, 1.0f, 0.0f, 1.0f, glm::vec2(0, 0), worldBox);
+    glm::vec2 const displacement(10, 0);
+
+    float fraction;
+    glm::vec2 normA;
+    SECTION("Circle and polygon.") {
+        REQUIRE(Collision2DNarrowPhase::sweepShapes(worldCircle, displacement, worldWall, fraction, normA));
+        REQUIRE(isNear(fraction, 0.44f));
+        REQUIRE(normA == glm::vec2(1, 0));
+    }
+    SECTION("Polygon and polygon.") {
+        REQUIRE(Collision2DNarrowPhase::sweepShapes(worldBox, displacement, worldWall, fraction, normA));
+        REQUIRE(isNear(fraction, 0.44f));
+        REQUIRE(normA == glm::vec2(1, 0));
+
+        glm::vec2 normB;
+        REQUIRE(Collision2DNarrowPhase::sweepShapes(worldWall, -displacement, worldBox, fraction, normB));
+        REQUIRE(isNear(fraction, 0.44f));
+        REQUIRE(normB == -normA);
+    }
+    SECTION("Circle and circle.") {
+        Collision2DWorldShape post;
+        Collision2DNarrowPhase::computeWorldShape(circle, 1.0f, 0.0f, 1.0f, glm::vec2(5, 0), post);
+        REQUIRE(Collision2DNarrowPhase::sweepShapes(worldCircle, displacement, post, fraction, normA));
+        REQUIRE(isNear(fraction, 0.4f));
+        REQUIRE(normA == glm::vec2(1, 0));
+    }
+    SECTION("Missing, moving away or overlapping already.") {
+        REQUIRE_FALSE(Collision2DNarrowPhase::sweepShapes(worldCircle, glm::vec2(0, 10), worldWall, fraction, normA));
+        REQUIRE_FALSE(Collision2DNarrowPhase::sweepShapes(worldBox, -displacement, worldWall, fraction, normA));
+        REQUIRE_FALSE(Collision2DNarrowPhase::sweepShapes(worldCircle, glm::vec2(2, 0), worldWall, fraction, normA));
+        Collision2DNarrowPhase::computeWorldShape(circle, 1.0f, 0.0f, 1.0f, glm::vec2(5, 0), worldCircle);
+        REQUIRE_FALSE(Collision2DNarrowPhase::sweepShapes(worldCircle, displacement, worldWall, fraction, normA));
+    }
+}
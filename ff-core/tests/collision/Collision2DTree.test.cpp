@@ -0,0 +1,133 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <ff/collision/Collision2DTree.hpp>
+#include <ff/collision/Collision2DGrid.hpp>
+
+#include <ff/util/Macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace ff;
+
+static Rectangle createRandomAABB(std::mt19937& random) {
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> size(0.5f, 40.0f);
+    glm::vec2 const min(position(random), position(random));
+    return Rectangle(min, min + glm::vec2(size(random), size(random)));
+}
+
+static std::vector<Collision2DProxy> queryBruteForce(const std::vector<Rectangle>& aabbs, const std::vector<bool>& alive,
+    const std::vector<Collision2DProxy>& ids, const Rectangle& aabb) {
+    std::vector<Collision2DProxy> proxies;
+    for(size_t i = 0; i < aabbs.size(); ++i) {
+        if(alive[i] && aabbs[i].intersects(aabb)) {
+            proxies.push_back(ids[i]);
+        }
+    }
+    std::sort(proxies.begin(), proxies.end());
+    return proxies;
+}
+
+TEST_CASE("Tree queries match testing every proxy.", "[collision]") {
+    std::mt19937 random(1234);
+    Collision2DTree tree(2.0f);
+
+    const int proxyCount = 500;
+    std::vector<Rectangle> aabbs;
+    std::vector<bool> alive;
+    std::vector<Collision2DProxy> ids;
+    for(int i = 0; i < proxyCount; ++i) {
+        aabbs.push_back(createRandomAABB(random));
+        alive.push_back(true);
+        ids.push_back(tree.createProxy(aabbs.back(), i + 1));
+    }
+    // Balancing keeps the height logarithmic
+    REQUIRE(tree.getHeight() <= 2 * (int)std::ceil(std::log2(proxyCount)));
+
+    auto const requireMatchingQueries = [&]() {
+        for(int i = 0; i < 50; ++i) {
+            Rectangle const aabb = createRandomAABB(random);
+            std::vector<Collision2DProxy> proxies;
+            tree.query(aabb, proxies);
+            REQUIRE(proxies == queryBruteForce(aabbs, alive, ids, aabb));
+        }
+    };
+    requireMatchingQueries();
+
+    std::uniform_real_distribution<float> offset(-30.0f, 30.0f);
+    for(int i = 0; i < proxyCount; i += 2) {
+        glm::vec2 const delta(offset(random), offset(random));
+        aabbs[i] = Rectangle(aabbs[i].getBottomLeft() + delta, aabbs[i].getTopRight() + delta);
+        tree.moveProxy(ids[i], aabbs[i]);
+    }
+    for(int i = 0; i < proxyCount; i += 3) {
+        tree.destroyProxy(ids[i]);
+        alive[i] = false;
+    }
+    requireMatchingQueries();
+    REQUIRE(tree.getActor(ids[1]) == 2);
+    REQUIRE(tree.getProxyCount() == (size_t)(proxyCount - (proxyCount + 2) / 3));
+}
+
+TEST_CASE("Tree proxies only move in the tree when they leave their fat AABB.", "[collision]") {
+    Collision2DTree tree(1.0f);
+    Collision2DProxy proxy = tree.createProxy(Rectangle(glm::vec2(0, 0), glm::vec2(2, 2)), 1);
+    tree.createProxy(Rectangle(glm::vec2(10, 10), glm::vec2(12, 12)), 2);
+
+    Rectangle const fatAABB = tree.getFatAABB(proxy);
+    REQUIRE(fatAABB.getBottomLeft() == glm::vec2(-1, -1));
+    REQUIRE(fatAABB.getTopRight() == glm::vec2(3, 3));
+
+    tree.moveProxy(proxy, Rectangle(glm::vec2(0.5f, 0.5f), glm::vec2(2.5f, 2.5f)));
+    REQUIRE(tree.getFatAABB(proxy).getBottomLeft() == fatAABB.getBottomLeft());
+    REQUIRE(tree.getAABB(proxy).getBottomLeft() == glm::vec2(0.5f, 0.5f));
+    // Queries use the tight AABB, even though the fat one overlaps
+    std::vector<Collision2DProxy> proxies;
+    tree.query(Rectangle(glm::vec2(-1, -1), glm::vec2(0, 0)), proxies);
+    REQUIRE(proxies.empty());
+
+    tree.moveProxy(proxy, Rectangle(glm::vec2(20, 20), glm::vec2(22, 22)));
+    REQUIRE(tree.getFatAABB(proxy).getBottomLeft() == glm::vec2(19, 19));
+    tree.query(Rectangle(glm::vec2(21, 21), glm::vec2(30, 30)), proxies);
+    REQUIRE(proxies == std::vector<Collision2DProxy>({ proxy }));
+}
+
+TEST_CASE("Ray queries return crossed proxies nearest first.", "[collision]") {
+    auto const testRays = [](Collision2DBroadPhase& broadPhase) {
+        Collision2DProxy farther = broadPhase.createProxy(Rectangle(glm::vec2(20, -1), glm::vec2(22, 1)), 1);
+        Collision2DProxy nearer = broadPhase.createProxy(Rectangle(glm::vec2(10, -1), glm::vec2(12, 1)), 2);
+        Collision2DProxy missed = broadPhase.createProxy(Rectangle(glm::vec2(15, 5), glm::vec2(17, 7)), 3);
+        FF_UNUSED(missed);
+
+        std::vector<Collision2DProxy> proxies;
+        broadPhase.queryRay(glm::vec2(0, 0), glm::vec2(30, 0), proxies);
+        REQUIRE(proxies == std::vector<Collision2DProxy>({ nearer, farther }));
+
+        proxies.clear();
+        broadPhase.queryRay(glm::vec2(30, 0), glm::vec2(0, 0), proxies);
+        REQUIRE(proxies == std::vector<Collision2DProxy>({ farther, nearer }));
+
+        // Stops short of the farther proxy
+        proxies.clear();
+        broadPhase.queryRay(glm::vec2(0, 0), glm::vec2(15, 0), proxies);
+        REQUIRE(proxies == std::vector<Collision2DProxy>({ nearer }));
+    };
+
+    SECTION("With a grid.") {
+        Collision2DGrid grid(4.0f);
+        testRays(grid);
+    }
+    SECTION("With a tree.") {
+        Collision2DTree tree;
+        testRays(tree);
+    }
+}
@@ -0,0 +1,120 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <ff/debug/Profiler.hpp>
+
+#include <cstring>
+#include <thread>
+#include <chrono>
+
+static ff::ProfileZoneStatistic const* findZone(char const* const& name) {
+    for(auto const& zone : ff::Profiler::getLastFrame()) {
+        if(std::strcmp(zone.name, name) == 0) {
+            return &zone;
+        }
+    }
+    return nullptr;
+}
+
+TEST_CASE("Profiler zones are collected into a tree each frame.", "[debug]") {
+    ff::Profiler::endFrame();
+
+    {
+        ff::ProfileZone const outer("test_outer");
+        for(int i = 0; i < 2; i++) {
+            ff::ProfileZone const inner("test_inner");
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    ff::Profiler::endFrame();
+
+    auto const outer = findZone("test_outer");
+    auto const inner = findZone("test_inner");
+    REQUIRE(outer != nullptr);
+    REQUIRE(inner != nullptr);
+    REQUIRE(outer->callCount == 1);
+    REQUIRE(inner->callCount == 2);
+    REQUIRE(inner->depth == outer->depth + 1);
+    REQUIRE(inner == outer + 1);
+    REQUIRE(inner->duration >= 0.002);
+    REQUIRE(outer->duration >= inner->duration);
+
+    SECTION("Only with the zones of the last frame.") {
+        ff::Profiler::endFrame();
+        REQUIRE(findZone("test_outer") == nullptr);
+    }
+    SECTION("Each thread in its own tree.") {
+        std::thread([]() {
+            ff::ProfileZone const zone("test_thread");
+        }).join();
+        {
+            ff::ProfileZone const zone("test_thread");
+        }
+        ff::Profiler::endFrame();
+
+        size_t threadCount = 0;
+        for(auto const& zone : ff::Profiler::getLastFrame()) {
+            if(std::strcmp(zone.name, "test_thread") == 0) {
+                REQUIRE(zone.depth == 0);
+                threadCount++;
+            }
+        }
+        REQUIRE(threadCount == 2);
+    }
+    SECTION("Exited threads make way for new ones.") {
+        size_t threadIndex = 0;
+        for(int i = 0; i < 3; i++) {
+            std::thread([]() {
+                ff::ProfileZone const zone("test_thread");
+            }).join();
+            ff::Profiler::endFrame();
+
+            // Collected once after the thread exits, then its buffer is freed
+            auto const zone = findZone("test_thread");
+            REQUIRE(zone != nullptr);
+            if(i == 0) {
+                threadIndex = zone->thread;
+            }
+            REQUIRE(zone->thread == threadIndex);
+            ff::Profiler::endFrame();
+            REQUIRE(findZone("test_thread") == nullptr);
+        }
+    }
+    SECTION("Zones open at the end of a frame count in the next one.") {
+        ff::Profiler::beginZone("test_open");
+        ff::Profiler::endFrame();
+        REQUIRE(findZone("test_open")->callCount == 0);
+        ff::Profiler::endZone("test_open");
+        ff::Profiler::endFrame();
+        REQUIRE(findZone("test_open")->callCount == 1);
+    }
+    SECTION("Ends without a beginning are ignored.") {
+        ff::Profiler::endZone("test_outer");
+        ff::Profiler::endFrame();
+        REQUIRE(findZone("test_outer") == nullptr);
+    }
+    SECTION("Nothing is recorded while disabled.") {
+        ff::Profiler::setEnabled(false);
+        {
+            ff::ProfileZone const zone("test_outer");
+        }
+        ff::Profiler::setEnabled(true);
+        ff::Profiler::endFrame();
+        REQUIRE(findZone("test_outer") == nullptr);
+    }
+}
+
+namespace {
+    struct ProfiledType {};
+}
+
+TEST_CASE("Profiler type names are readable.", "[debug]") {
+    char const* const name = ff::Profiler::getTypeName(typeid(ProfiledType));
+    REQUIRE(std::strstr(name, "ProfiledType") != nullptr);
+    REQUIRE(ff::Profiler::getTypeName(typeid(ProfiledType)) == name);
+}
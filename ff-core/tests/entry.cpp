@@ -6,5 +6,17 @@
 
 #include <ff/Game.hpp>
 
+#include <timer_lib/timer.h>
+
+namespace {
+    // Tests run without a GameServicer, which would otherwise initialize
+    // `timer_lib` in `preInit`
+    struct TimerLibInitializer {
+        TimerLibInitializer() {
+            timer_lib_initialize();
+        }
+    } const timerLibInitializer;
+}
+
 void ff_entry(ff::Game* game) {
 }
@@ -16,6 +16,10 @@
 
 #include <ff/Locator.hpp>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 class TestEvent: public ff::Event {
 public:
     TestEvent() {
@@ -131,9 +135,9 @@ public:
     bool receivedEvent = false;
     std::string receivedEventName = "";
 
-    inline bool processEvent(const std::shared_ptr<ff::Event>& message) {
+    inline bool processEvent(const ff::Event& message) {
         receivedEvent = true;
-        receivedEventName = message->getName();
+        receivedEventName = message.getName();
 
         return false;
     }
@@ -155,6 +159,15 @@ TEST_CASE("Wildcard listeners listen for all events.", "[messages]") {
     REQUIRE(listener.receivedEventName == "evt_test2");
 }
 
+TEST_CASE("Generic listeners receive queued events.", "[messages]") {
+    AllListener listener("evt_test");
+    ff::Locator::getMessageBus().enqueue<TestEvent>();
+    REQUIRE(!listener.receivedEvent);
+    ff::Locator::getMessageBus().flush();
+    REQUIRE(listener.receivedEvent);
+    REQUIRE(listener.receivedEventName == "evt_test");
+}
+
 FF_CMD_DEFINE_0_R1(TestCmd,
     "cmd_test",
     "Test",
@@ -221,3 +234,99 @@ TEST_CASE("Listeners with higher priority can consume events and stop propogatio
     REQUIRE(!listenerLow.receivedEvent);
     REQUIRE(listenerHigh.receivedEvent);
 }
+
+class NestedDispatchListener: public ff::EventListener<TestEvent> {
+public:
+    NestedDispatchListener() {
+        ff::Locator::getMessageBus().addListener<TestEvent>(this);
+    }
+    ~NestedDispatchListener() = default;
+
+    inline bool processEvent(TestEvent const& testEvent) override {
+        FF_UNUSED(testEvent);
+
+        ff::Locator::getMessageBus().dispatch<TestEvent2>();
+
+        return false;
+    }
+};
+
+TEST_CASE("Events dispatched from within a listener are delivered.", "[messages]") {
+    NestedDispatchListener nestedListener;
+    TestEventListener2 listener;
+    ff::Locator::getMessageBus().dispatch<TestEvent>();
+    REQUIRE(listener.receivedEvent);
+}
+
+class BatchEventListener: public ff::EventListener<TestEvent> {
+public:
+    BatchEventListener() {
+        ff::Locator::getMessageBus().addListener<TestEvent>(this);
+    }
+    ~BatchEventListener() = default;
+
+    size_t batchCount = 0;
+    size_t eventCount = 0;
+
+    inline bool processEvent(TestEvent const& testEvent) override {
+        FF_UNUSED(testEvent);
+
+        eventCount++;
+
+        return false;
+    }
+    inline void processEvents(TestEvent const* const& testEvents, size_t const& count) override {
+        FF_UNUSED(testEvents);
+
+        batchCount++;
+        eventCount += count;
+    }
+};
+
+TEST_CASE("Queued events are delivered as a batch when the bus is flushed.", "[messages]") {
+    BatchEventListener listener;
+    ff::Locator::getMessageBus().enqueue<TestEvent>();
+    ff::Locator::getMessageBus().enqueue<TestEvent>();
+    ff::Locator::getMessageBus().enqueue<TestEvent>();
+    REQUIRE(listener.eventCount == 0);
+    ff::Locator::getMessageBus().flush();
+    REQUIRE(listener.batchCount == 1);
+    REQUIRE(listener.eventCount == 3);
+    ff::Locator::getMessageBus().flush();
+    REQUIRE(listener.batchCount == 1);
+}
+
+TEST_CASE("Queued events are delivered individually to listeners without batch handling.", "[messages]") {
+    TestEventListener listener;
+    AllListener wildcardListener(ff::MESSAGE_WILDCARD);
+    ff::Locator::getMessageBus().enqueue<TestEvent>();
+    REQUIRE(!listener.receivedEvent);
+    ff::Locator::getMessageBus().flush();
+    REQUIRE(listener.receivedEvent);
+    REQUIRE(wildcardListener.receivedEventName == "evt_test");
+}
+
+TEST_CASE("Events posted from other threads are delivered on flush.", "[messages]") {
+    BatchEventListener listener;
+
+    // Catch assertions aren't thread-safe, so count posts instead
+    std::atomic<int> postedCount(0);
+    std::vector<std::thread> threads;
+    for(int i = 0; i < 4; i++) {
+        threads.emplace_back([&postedCount]() {
+            for(int j = 0; j < 100; j++) {
+                if(ff::Locator::getMessageBus().post<TestEvent>()) {
+                    postedCount++;
+                }
+            }
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(postedCount == 400);
+    REQUIRE(listener.eventCount == 0);
+    ff::Locator::getMessageBus().flush();
+    REQUIRE(listener.eventCount == 400);
+}
@@ -11,6 +11,11 @@
 #include <ff/processes/DelegateProcess.hpp>
 #include <ff/processes/WaitProcess.hpp>
 #include <ff/processes/IntervalProcess.hpp>
+#include <ff/processes/CoroutineProcess.hpp>
+
+#include <ff/Locator.hpp>
+#include <ff/messages/MessageBus.hpp>
+#include <ff/events/ResizeEvent.hpp>
 
 #include <ff/util/Macros.hpp>
 
@@ -104,3 +109,60 @@ TEST_CASE("IntervalProcess ticks after a specified interval.", "[processes]") {
     manager.tick(5);
     REQUIRE(intervalProcess->tickCount == 2);
 }
+
+class DummyTestCoroutineProcess : public ff::CoroutineProcess {
+public:
+    int step = 0;
+    int loopCount = 0;
+
+protected:
+    void onResume() override {
+        FF_COROUTINE_BEGIN();
+        step = 1;
+        FF_COROUTINE_AWAIT(wait(10));
+        step = 2;
+        FF_COROUTINE_AWAIT(waitForEvent<ResizeEvent>([](const ResizeEvent& evt) {
+            return evt.width == 100;
+        }));
+        step = 3;
+        for(loopCount = 0; loopCount < 2; loopCount++) {
+            FF_COROUTINE_YIELD();
+        }
+        step = 4;
+        FF_COROUTINE_END();
+    }
+};
+
+TEST_CASE("CoroutineProcess resumes its sequence once each await finishes.", "[processes]") {
+    ff::ProcessManager manager;
+
+    auto process = manager.attachProcess<DummyTestCoroutineProcess>();
+    manager.tick(5);
+    REQUIRE(process->step == 1);
+    REQUIRE(process->getWaiting());
+
+    manager.tick(6);
+    REQUIRE(process->step == 1);
+    manager.tick(4);
+    REQUIRE(process->step == 2);
+
+    // Only the event the filter accepts resumes it, on the next update
+    ff::Locator::getMessageBus().enqueue<ResizeEvent>(50, 50);
+    ff::Locator::getMessageBus().flush();
+    manager.tick(1);
+    REQUIRE(process->step == 2);
+    ff::Locator::getMessageBus().enqueue<ResizeEvent>(100, 50);
+    ff::Locator::getMessageBus().flush();
+    REQUIRE(!process->getWaiting());
+    REQUIRE(process->step == 2);
+    manager.tick(1);
+    REQUIRE(process->step == 3);
+
+    // Awaits may be inside loops
+    manager.tick(1);
+    REQUIRE(process->loopCount == 1);
+    manager.tick(1);
+    REQUIRE(process->step == 4);
+    REQUIRE(!process->getAlive());
+    REQUIRE(manager.getProcesses().empty());
+}
@@ -0,0 +1,58 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <ff/processes/JobSystem.hpp>
+
+#include <atomic>
+#include <vector>
+
+static void testParallelFor(size_t const& workerCount) {
+    ff::JobSystem jobSystem(workerCount);
+    std::vector<std::atomic<int>> visits(10000);
+    for(auto& visit : visits) {
+        visit = 0;
+    }
+
+    // Catch assertions aren't thread-safe, so failures are only recorded here
+    std::atomic<bool> rangesWithinGrain(true);
+    jobSystem.parallelFor(visits.size(), 64, [&visits, &rangesWithinGrain](size_t begin, size_t end) {
+        if(end - begin > 64) {
+            rangesWithinGrain = false;
+        }
+        for(size_t i = begin; i < end; i++) {
+            visits[i]++;
+        }
+    });
+
+    REQUIRE(rangesWithinGrain);
+    for(auto& visit : visits) {
+        REQUIRE(visit == 1);
+    }
+}
+
+TEST_CASE("JobSystem parallelFor visits every index once.", "[processes]") {
+    SECTION("Without workers.") {
+        testParallelFor(0);
+    }
+    SECTION("With workers.") {
+        testParallelFor(3);
+    }
+}
+
+TEST_CASE("JobSystem parallelFor can be nested.", "[processes]") {
+    ff::JobSystem jobSystem(3);
+    std::atomic<int> count(0);
+    jobSystem.parallelFor(8, 1, [&jobSystem, &count](size_t begin, size_t end) {
+        for(size_t i = begin; i < end; i++) {
+            jobSystem.parallelFor(100, 10, [&count](size_t innerBegin, size_t innerEnd) {
+                count += (int)(innerEnd - innerBegin);
+            });
+        }
+    });
+    REQUIRE(count == 800);
+}
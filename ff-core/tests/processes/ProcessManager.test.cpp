@@ -7,9 +7,13 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <memory>
+#include <vector>
 
 #include <ff/processes/ProcessManager.hpp>
 #include <ff/processes/Process.hpp>
+#include <ff/processes/DelegateProcess.hpp>
+
+#include <ff/actors/Component.hpp>
 
 #include <ff/util/Macros.hpp>
 
@@ -126,3 +130,152 @@ TEST_CASE("Default Process behavior is to kill on soft kill.", "[processes]") {
     processManager.killAll();
     REQUIRE(process->didKill);
 }
+
+struct ProcessReadTestComponent : ff::Component<ProcessReadTestComponent> {};
+struct ProcessWriteTestComponent : ff::Component<ProcessWriteTestComponent> {};
+
+class DummyAccessTestProcess : public ff::Process {
+public:
+    DummyAccessTestProcess(const bool& writes) {
+        if(writes) {
+            declareWrites<ProcessWriteTestComponent>();
+        } else {
+            declareReads<ProcessReadTestComponent, ProcessWriteTestComponent>();
+        }
+    }
+
+    int updateCallCount = 0;
+
+protected:
+    inline void onUpdate(const float& dt) override {
+        FF_UNUSED(dt);
+
+        updateCallCount++;
+    }
+};
+
+TEST_CASE("Processes with declared component access conflict only when one writes what the other uses.", "[processes]") {
+    DummyAccessTestProcess reader(false);
+    DummyAccessTestProcess otherReader(false);
+    DummyAccessTestProcess writer(true);
+    DummyTestProcess undeclared;
+
+    REQUIRE(reader.getDeclaresComponentAccess());
+    REQUIRE(!undeclared.getDeclaresComponentAccess());
+    REQUIRE(!reader.conflictsWith(otherReader.getReadComponents(), otherReader.getWriteComponents()));
+    REQUIRE(reader.conflictsWith(writer.getReadComponents(), writer.getWriteComponents()));
+    REQUIRE(writer.conflictsWith(reader.getReadComponents(), reader.getWriteComponents()));
+}
+
+TEST_CASE("Processes with declared component access are all updated.", "[processes]") {
+    ff::ProcessManager processManager;
+    std::vector<std::shared_ptr<DummyAccessTestProcess>> processes;
+    for(int i = 0; i < 4; i++) {
+        processes.push_back(std::make_shared<DummyAccessTestProcess>(i == 2));
+        processManager.attachProcess(processes.back());
+    }
+
+    processManager.tick(0);
+    processManager.tick(0);
+    for(auto const& process : processes) {
+        REQUIRE(process->updateCallCount == 2);
+    }
+}
+
+class DummyOrderTestProcess : public ff::Process {
+public:
+    DummyOrderTestProcess(std::vector<int>* const& order, const int& id, const ff::ProcessPriority_t& priority)
+        :Process(priority),_order(order),_id(id) {
+    }
+
+protected:
+    inline void onUpdate(const float& dt) override {
+        FF_UNUSED(dt);
+        _order->push_back(_id);
+    }
+
+private:
+    std::vector<int>* _order;
+    int _id;
+};
+
+TEST_CASE("Processes update by priority, then in the order they were attached.", "[processes]") {
+    ff::ProcessManager processManager;
+    std::vector<int> order;
+    processManager.attachProcess<DummyOrderTestProcess>(&order, 0, ff::ProcessPriority::LOW);
+    processManager.attachProcess<DummyOrderTestProcess>(&order, 1, ff::ProcessPriority::HIGH);
+    processManager.attachProcess<DummyOrderTestProcess>(&order, 2, ff::ProcessPriority::LOW);
+    processManager.attachProcess<DummyOrderTestProcess>(&order, 3, ff::ProcessPriority::HIGH);
+    processManager.tick(0);
+    REQUIRE(order == std::vector<int>({ 1, 3, 0, 2 }));
+
+    SECTION("Including processes attached during a tick.") {
+        processManager.attachProcess(ff::makeProcess<ff::DelegateProcess>([&]() {
+            processManager.attachProcess<DummyOrderTestProcess>(&order, 4, ff::ProcessPriority::LOW);
+            processManager.attachProcess<DummyOrderTestProcess>(&order, 5, ff::ProcessPriority::EXTREMELY_HIGH);
+            processManager.attachProcess<DummyOrderTestProcess>(&order, 6, ff::ProcessPriority::HIGH);
+        }));
+        processManager.tick(0);
+        order.clear();
+        processManager.tick(0);
+        REQUIRE(order == std::vector<int>({ 5, 1, 3, 6, 0, 2, 4 }));
+    }
+    SECTION("Attaching a process twice doesn't update it twice.") {
+        auto process = processManager.attachProcess<DummyOrderTestProcess>(&order, 4, ff::ProcessPriority::LOW);
+        processManager.attachProcess(process);
+        order.clear();
+        processManager.tick(0);
+        REQUIRE(order == std::vector<int>({ 1, 3, 0, 2, 4 }));
+    }
+}
+
+TEST_CASE("Pooled processes reuse freed blocks.", "[processes]") {
+    void* const block = ff::ProcessPool::allocate(100);
+    size_t const freeBlockCount = ff::ProcessPool::getFreeBlockCount(100);
+    ff::ProcessPool::deallocate(block, 100);
+    REQUIRE(ff::ProcessPool::getFreeBlockCount(100) == freeBlockCount + 1);
+    REQUIRE(ff::ProcessPool::allocate(100) == block);
+    ff::ProcessPool::deallocate(block, 100);
+
+    // Once a process dies, the next one of its type takes its place
+    ff::ProcessManager processManager;
+    DummyTestProcess* const first = processManager.attachProcess<DummyTestProcess>().get();
+    first->kill();
+    processManager.tick(0);
+    REQUIRE(processManager.getProcesses().empty());
+    REQUIRE(processManager.attachProcess<DummyTestProcess>().get() == first);
+}
+
+TEST_CASE("Budgeted processes take turns once the budget runs out.", "[processes]") {
+    ff::ProcessManager processManager;
+    // With no budget only one process is updated each tick
+    processManager.setBudget(0);
+    std::vector<int> order;
+    std::vector<std::shared_ptr<ff::Process>> processes;
+    for(int i = 0; i < 3; i++) {
+        processes.push_back(processManager.attachProcess(
+            ff::makeProcess<DummyOrderTestProcess>(&order, i, ff::ProcessPriority::DEFAULT), ff::ProcessFlags::BUDGETED));
+    }
+    REQUIRE(processManager.getProcesses().empty());
+    REQUIRE(processManager.getBudgetedProcesses().size() == 3);
+
+    processManager.tick(1);
+    REQUIRE(order == std::vector<int>({ 0 }));
+    REQUIRE(processManager.getBudgetedBehindCount() == 2);
+    REQUIRE(processManager.getBudgetedLag() == 1);
+
+    SECTION("Carrying on where the last tick stopped.") {
+        processManager.tick(1);
+        processManager.tick(1);
+        REQUIRE(order == std::vector<int>({ 0, 1, 2 }));
+        REQUIRE(processManager.getBudgetedBehindCount() == 2);
+        REQUIRE(processManager.getBudgetedLag() == 2);
+    }
+    SECTION("Skipping dead processes.") {
+        processes[1]->kill();
+        processManager.tick(1);
+        processManager.tick(1);
+        REQUIRE(order == std::vector<int>({ 0, 2, 0 }));
+        REQUIRE(processManager.getBudgetedProcesses().size() == 2);
+    }
+}
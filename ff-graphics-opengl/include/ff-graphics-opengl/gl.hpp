@@ -9,13 +9,17 @@
 
 #include <epoxy/gl.h>
 
+#include <ff/CVars.hpp>
+
 namespace ff {
     bool checkOpenGLErrors(char const* const funcName, char const* const fileName, int lineNumber);
+
+    extern CVarHandle<bool> glPrintAPICallsCVar;
+    extern CVarHandle<bool> glCheckCallErrorsCVar;
 }
 
 #if defined(FF_DEV_FEATURES)
 #include <ff/Console.hpp>
-#include <ff/CVars.hpp>
 #include <string>
 
 template<typename... Args>
@@ -33,12 +37,12 @@ std::string gl_printFuncArgs(Args... args) {
 
 #define FF_GL_CALL(func, ...) \
     [&]() { \
-        if(ff::CVars::get<bool>("graphics_gl_print_api_calls")) { \
+        if(ff::glPrintAPICallsCVar.get()) { \
             FF_CONSOLE_LOG(#func"("#__VA_ARGS__") => "#func"(%s)", gl_printFuncArgs(__VA_ARGS__)); \
         } \
         return func(__VA_ARGS__);\
     }(); \
-    if(ff::CVars::get<bool>("graphics_gl_check_call_errors")) { \
+    if(ff::glCheckCallErrorsCVar.get()) { \
         ff::checkOpenGLErrors(#func, (__FILE__), (__LINE__)); \
     }
 #else
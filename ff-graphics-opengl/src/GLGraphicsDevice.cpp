@@ -173,7 +173,7 @@ namespace ff {
     }
 
     void GLGraphicsDevice::preRenderImpl() {
-        if(CVars::get<bool>("graphics_gl_print_api_calls")) {
+        if(glPrintAPICallsCVar.get()) {
             FF_CONSOLE_LOG("Begin frame render.");
         }
 
@@ -181,7 +181,7 @@ namespace ff {
         _hasRenderedToPresentationTarget = false;
     }
     void GLGraphicsDevice::postRenderImpl() {
-        if(CVars::get<bool>("graphics_gl_print_api_calls")) {
+        if(glPrintAPICallsCVar.get()) {
             FF_CONSOLE_LOG("End frame render.");
         }
 
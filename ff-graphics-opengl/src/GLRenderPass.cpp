@@ -293,7 +293,7 @@ namespace ff {
         _graphicsDevice->getFramebufferManager()->attemptInvalidation(getColorRenderTargets(),
             getDepthRenderTarget());
         
-        if(CVars::get<bool>("graphics_gl_print_api_calls")) {
+        if(glPrintAPICallsCVar.get()) {
             FF_CONSOLE_LOG("End render pass.");
         }
     }
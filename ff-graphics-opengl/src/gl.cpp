@@ -16,6 +16,9 @@
 #endif
 
 namespace ff {
+    CVarHandle<bool> glPrintAPICallsCVar("graphics_gl_print_api_calls");
+    CVarHandle<bool> glCheckCallErrorsCVar("graphics_gl_check_call_errors");
+
     bool checkOpenGLErrors(char const* const funcName, char const* const fileName, int lineNumber) {
         bool hasError = false;
         while(GLenum error = glGetError()) {
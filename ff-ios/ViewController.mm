@@ -110,8 +110,8 @@
     CGFloat bottomInset = self.view.safeAreaInsets.bottom;
     
     // Compute safe area padding
-    ff::CVars::get<float>("view_safe_area_padding_top") = (float)(topInset / drawableSize.height);
-    ff::CVars::get<float>("view_safe_area_padding_bottom") = (float)(bottomInset / drawableSize.height);
+    ff::CVars::set<float>("view_safe_area_padding_top", (float)(topInset / drawableSize.height));
+    ff::CVars::set<float>("view_safe_area_padding_bottom", (float)(bottomInset / drawableSize.height));
     
     FF_CONSOLE_LOG("Starting game loop...");
     _acculmulator = 0;